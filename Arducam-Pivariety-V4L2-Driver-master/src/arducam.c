@@ -20,17 +20,22 @@
 #include <linux/clk.h>
 #include <linux/clk-provider.h>
 #include <linux/clkdev.h>
+#include <linux/debugfs.h>
 #include <linux/delay.h>
 #include <linux/gpio/consumer.h>
 #include <linux/i2c.h>
 #include <linux/module.h>
 #include <linux/pm_runtime.h>
 #include <linux/regulator/consumer.h>
+#include <linux/seq_file.h>
 #include <media/v4l2-ctrls.h>
 #include <media/v4l2-device.h>
 #include <media/v4l2-fwnode.h>
 #include <media/v4l2-mediabus.h>
+#include <media/v4l2-rect.h>
 #include <asm/unaligned.h>
+#include "arducam_regcache.h"
+#include "arducam_wait.h"
 
 #define arducam_REG_VALUE_08BIT		1
 #define arducam_REG_VALUE_16BIT		2
@@ -85,6 +90,10 @@
 #define arducam_TEST_PATTERN_GREY_COLOR	3
 #define arducam_TEST_PATTERN_PN9		4
 
+/* Sensor-side crop (IPC_SEL_* registers): even offsets and sizes */
+#define ARDUCAM_SEL_ALIGN		2
+#define ARDUCAM_SEL_MIN_SIZE		64
+
 /* Embedded metadata stream structure */
 #define ARDUCAM_EMBEDDED_LINE_WIDTH 16384
 #define ARDUCAM_NUM_EMBEDDED_LINES 1
@@ -99,6 +108,10 @@ enum pad_types {
 static int debug = 0;
 module_param(debug, int, 0644);
 
+/* Shadow register cache (arducam_regcache.h), 0 sends every read to the bus */
+static int regcache = 1;
+module_param(regcache, int, 0444);
+
 struct arducam_reg {
 	u16 address;
 	u8 val;
@@ -278,6 +291,11 @@ struct arducam {
 	const struct arducam_mode *mode;
 	int bayer_order_volatile;
 	struct v4l2_rect crop;
+	/* crop is smaller than the pixel array: the image pad is crop sized */
+	bool crop_active;
+	/* Crop bounds (pixel array), cached from the last read: TRY uses them */
+	struct v4l2_rect crop_bounds;
+	bool crop_bounds_valid;
 	/*
 	 * Mutex for serialized access:
 	 * Protect sensor module set pad format and start/stop streaming safely.
@@ -289,10 +307,17 @@ struct arducam {
 	bool streaming;
 	bool wait_until_free;
 	struct v4l2_ctrl *ctrls[32];
+
+	/* Register shadow + I2C transaction counters */
+	struct arducam_regcache regs;
+	/* wait_for_free() times */
+	struct arducam_wait_stats waits;
+	struct dentry *debugfs;
 };
 
 static int is_raw(int pixformat);
 static u32 data_type_to_mbus_code(int data_type, int bayer_order);
+static void arducam_reset_sel(struct arducam *arducam);
 
 
 static inline struct arducam *to_arducam(struct v4l2_subdev *_sd)
@@ -300,6 +325,13 @@ static inline struct arducam *to_arducam(struct v4l2_subdev *_sd)
 	return container_of(_sd, struct arducam, sd);
 }
 
+static inline struct arducam_regcache *to_regcache(struct i2c_client *client)
+{
+	struct v4l2_subdev *sd = i2c_get_clientdata(client);
+
+	return sd ? &to_arducam(sd)->regs : NULL;
+}
+
 /* Write registers up to 2 at a time */
 static int arducam_write_reg(struct arducam *arducam, u16 reg, u32 len, u32 val)
 {
@@ -314,8 +346,11 @@ static int arducam_write_reg(struct arducam *arducam, u16 reg, u32 len, u32 val)
 
 	put_unaligned_be16(reg, buf);
 	put_unaligned_be32(val << (8 * (4 - len)), buf + 2);
-	if (i2c_master_send(client, buf, len + 2) != len + 2)
+	arducam->regs.stats.writes++;
+	if (i2c_master_send(client, buf, len + 2) != len + 2) {
+		arducam->regs.stats.failures++;
 		return -EIO;
+	}
 
 	return 0;
 }
@@ -376,13 +411,27 @@ int arducam_read(struct i2c_client *client, u16 addr, u32 *value)
 {
 	int ret;
 	int count = 0;
+	struct arducam_regcache *regs = to_regcache(client);
+
+	if (regs && arducam_regcache_lookup(regs, addr, value)) {
+		v4l2_dbg(2, debug, client, "%s: 0x%02x 0x%04x (cached)\n",
+			__func__, addr, *value);
+		return 0;
+	}
+
 	while (count++ < I2C_READ_RETRY_COUNT) {
 		ret = arducam_readl_reg(client, addr, value);
+		if (regs)
+			regs->stats.reads++;
 		if(!ret) {
 			v4l2_dbg(1, debug, client, "%s: 0x%02x 0x%04x\n",
 				__func__, addr, *value);
+			if (regs)
+				arducam_regcache_store(regs, addr, *value);
 			return ret;
 		}
+		if (regs)
+			regs->stats.failures++;
 	}
 	
 	v4l2_err(client, "%s: Reading register 0x%02x failed\n",
@@ -390,16 +439,46 @@ int arducam_read(struct i2c_client *client, u16 addr, u32 *value)
 	return ret;
 }
 
-static int wait_for_free(struct i2c_client *client, int interval) {
-	u32 value;
+/*
+ * Poll SYSTEM_IDLE_REG until the firmware is idle: tight polling first, then
+ * backing off up to "interval" ms between polls (arducam_wait.h).
+ * The statistics book the wait to "site", the calling function: passed
+ * explicitly by wait_for_free(), a return address would be meaningless
+ * once the compiler inlines this function.
+ */
+#define wait_for_free(client, interval) \
+	__wait_for_free(client, interval, __func__)
+
+static int __wait_for_free(struct i2c_client *client, int interval,
+			   const char *site) {
+	struct v4l2_subdev *sd = i2c_get_clientdata(client);
+	struct arducam *arducam = sd ? to_arducam(sd) : NULL;
+	ktime_t start = ktime_get();
+	u32 elapsed = 0, sleep_us = 0;
 	u32 count = 0;
-	while(count++ < (1000 / interval)) {
+	bool idle = false;
+	u32 value;
+
+	while (elapsed < ARDUCAM_WAIT_TIMEOUT_US) {
 		int ret = arducam_read(client, SYSTEM_IDLE_REG, &value);
-		if (!ret && !value) break;
-		msleep(interval);
+		count++;
+		if (!ret && !value) {
+			idle = true;
+			break;
+		}
+		sleep_us = arducam_wait_next_us(elapsed, sleep_us, interval * 1000);
+		usleep_range(sleep_us, sleep_us + sleep_us / 4);
+		elapsed = ktime_us_delta(ktime_get(), start);
 	}
-	v4l2_dbg(1, debug, client, "%s: End wait, Count: %d.\n",
-			 __func__, count);
+	elapsed = ktime_us_delta(ktime_get(), start);
+
+	if (arducam) {
+		arducam_wait_account(&arducam->waits, site, elapsed, count,
+				     !idle);
+		arducam->regs.stats.wait_us += elapsed;
+	}
+	v4l2_dbg(1, debug, client, "%s: End wait, Count: %d, %u us%s.\n",
+			 __func__, count, elapsed, idle ? "" : " (timeout)");
 
 	return 0;
 }
@@ -408,11 +487,22 @@ int arducam_write(struct i2c_client *client, u16 addr, u32 value)
 {
 	int ret;
 	int count = 0;
+	struct arducam_regcache *regs = to_regcache(client);
+
 	while (count++ < I2C_WRITE_RETRY_COUNT) {
 		ret = arducam_writel_reg(client, addr, value);
-		if(!ret)
+		if (regs)
+			regs->stats.writes++;
+		if(!ret) {
+			if (regs)
+				arducam_regcache_write(regs, addr, value, true);
 			return ret;
+		}
+		if (regs)
+			regs->stats.failures++;
 	}
+	if (regs)
+		arducam_regcache_write(regs, addr, value, false);
 	v4l2_err(client, "%s: Write 0x%04x to register 0x%02x failed\n",
 			 __func__, value, addr);
 	return ret;
@@ -468,6 +558,9 @@ static int arducam_power_on(struct device *dev)
 	usleep_range(arducam_XCLR_MIN_DELAY_US,
 		     arducam_XCLR_MIN_DELAY_US + arducam_XCLR_DELAY_RANGE_US);
 
+	/* The firmware restarts: nothing read before is known to hold */
+	arducam_regcache_invalidate(&arducam->regs);
+
 	return 0;
 
 reg_off:
@@ -516,6 +609,7 @@ static int arducam_open(struct v4l2_subdev *sd, struct v4l2_subdev_fh *fh)
 static int arducam_s_ctrl(struct v4l2_ctrl *ctrl)
 {
 	int ret, i;
+	struct arducam_i2c_stats snap;
 	struct arducam *priv = 
 		container_of(ctrl->handler, struct arducam, ctrl_handler);
 	struct arducam_format *supported_formats = priv->supported_formats;
@@ -533,8 +627,11 @@ static int arducam_s_ctrl(struct v4l2_ctrl *ctrl)
 			 __func__, ctrl->id, ctrl->val);
 	
 
+	arducam_op_begin(&priv->regs, &snap);
 	ret = arducam_write(priv->client, CTRL_ID_REG, ctrl->id);
 	ret += arducam_write(priv->client, CTRL_VALUE_REG, ctrl->val);
+	arducam_regcache_ctrl_set(&priv->regs, ctrl->id, ctrl->val, !ret);
+	arducam_op_end(&priv->regs, ARDUCAM_OP_S_CTRL, &snap);
 	if (ret < 0)
 		return -EINVAL;
 
@@ -648,6 +745,10 @@ static int arducam_csi2_get_fmt(struct v4l2_subdev *sd,
 			current_format->resolution_set[priv->current_resolution_idx].width;
 		format->format.height =
 			current_format->resolution_set[priv->current_resolution_idx].height;
+		if (priv->crop_active) {
+			format->format.width = priv->crop.width;
+			format->format.height = priv->crop.height;
+		}
 		format->format.code = current_format->mbus_code;
 		format->format.field = V4L2_FIELD_NONE;
 		format->format.colorspace = V4L2_COLORSPACE_SRGB;
@@ -715,8 +816,15 @@ static int update_control(struct arducam *priv, u32 id)
 	arducam_read(client, CTRL_ID_REG, &id2);
 	v4l2_dbg(1, debug, priv->client, "%s: Write ID: 0x%08X Read ID: 0x%08X\n",
 		__func__, id, id2);
-	arducam_write(client, CTRL_VALUE_REG, 0);
-	wait_for_free(client, 1);
+
+	/* Ranges for this mode already in the shadow: no firmware lookup */
+	if (!arducam_regcache_peek(&priv->regs, CTRL_MAX_REG, &max) ||
+		!arducam_regcache_peek(&priv->regs, CTRL_MIN_REG, &min) ||
+		!arducam_regcache_peek(&priv->regs, CTRL_DEF_REG, &def) ||
+		!arducam_regcache_peek(&priv->regs, CTRL_STEP_REG, &step)) {
+		arducam_write(client, CTRL_VALUE_REG, 0);
+		wait_for_free(client, 1);
+	}
 	ret += arducam_read(client, CTRL_MAX_REG, &max);
 	ret += arducam_read(client, CTRL_MIN_REG, &min);
 	ret += arducam_read(client, CTRL_DEF_REG, &def);
@@ -751,7 +859,7 @@ static int update_controls(struct arducam *priv) {
 }
 
 
-static int arducam_csi2_set_fmt(struct v4l2_subdev *sd,
+static int __arducam_csi2_set_fmt(struct v4l2_subdev *sd,
 								struct v4l2_subdev_pad_config *cfg,
 								struct v4l2_subdev_format *format)
 {
@@ -777,6 +885,24 @@ static int arducam_csi2_set_fmt(struct v4l2_subdev *sd,
 		format->format.code = supported_formats[i].mbus_code;
 		// format->format.code = arducam_get_format_code(priv, format->format.code);
 
+		/* Crop sized request for the current format: keep the crop */
+		if (priv->crop_active && i == priv->current_format_idx &&
+			format->format.width == priv->crop.width &&
+			format->format.height == priv->crop.height) {
+			v4l2_dbg(1, debug, sd, "%s: keep crop %dx%d@(%d,%d).\n",
+				__func__, priv->crop.width, priv->crop.height,
+				priv->crop.left, priv->crop.top);
+			return 0;
+		}
+
+		/* A new mode starts from the full pixel array again */
+		if (format->which == V4L2_SUBDEV_FORMAT_ACTIVE) {
+			mutex_lock(&priv->mutex);
+			if (priv->crop_active)
+				arducam_reset_sel(priv);
+			mutex_unlock(&priv->mutex);
+		}
+
 		for (j = 0; j < supported_formats[i].num_resolution_set; j++) {
 			if (supported_formats[i].resolution_set[j].width 
 					== format->format.width && 
@@ -816,18 +942,40 @@ static int arducam_csi2_set_fmt(struct v4l2_subdev *sd,
 	return 0;
 }
 
+static int arducam_csi2_set_fmt(struct v4l2_subdev *sd,
+								struct v4l2_subdev_pad_config *cfg,
+								struct v4l2_subdev_format *format)
+{
+	struct arducam *priv = to_arducam(sd);
+	struct arducam_i2c_stats snap;
+	int ret;
+
+	arducam_op_begin(&priv->regs, &snap);
+	ret = __arducam_csi2_set_fmt(sd, cfg, format);
+	arducam_op_end(&priv->regs, ARDUCAM_OP_SET_FMT, &snap);
+
+	v4l2_dbg(1, debug, sd, "%s: %llu reads (%llu cached), %llu writes.\n",
+		 __func__, priv->regs.ops[ARDUCAM_OP_SET_FMT].last.reads,
+		 priv->regs.ops[ARDUCAM_OP_SET_FMT].last.hits,
+		 priv->regs.ops[ARDUCAM_OP_SET_FMT].last.writes);
+	return ret;
+}
+
 /* Start streaming */
 static int arducam_start_streaming(struct arducam *arducam)
 {
 	struct i2c_client *client = v4l2_get_subdevdata(&arducam->sd);
+	struct arducam_i2c_stats snap;
 	int ret;
 
+	arducam_op_begin(&arducam->regs, &snap);
+
 	/* set stream on register */
 	ret =  arducam_write_reg(arducam, arducam_REG_MODE_SELECT,
 				arducam_REG_VALUE_32BIT, arducam_MODE_STREAMING);
 
 	if (ret)
-		return ret;
+		goto out;
 
 	wait_for_free(client, 2);
 
@@ -837,10 +985,12 @@ static int arducam_start_streaming(struct arducam *arducam)
 
 	arducam->wait_until_free = false;
 	if (ret)
-		return ret;
+		goto out;
 
 	wait_for_free(client, 2);
 
+out:
+	arducam_op_end(&arducam->regs, ARDUCAM_OP_STREAM_ON, &snap);
 	return ret;
 }
 
@@ -863,6 +1013,85 @@ static int arducam_read_sel(struct arducam *arducam, struct v4l2_rect *rect) {
 	return 0;
 }
 
+static int arducam_write_sel(struct arducam *arducam,
+			     const struct v4l2_rect *rect) {
+	struct i2c_client *client = arducam->client;
+	int ret = 0;
+	ret += arducam_write(client, IPC_SEL_TOP_REG, rect->top);
+	ret += arducam_write(client, IPC_SEL_LEFT_REG, rect->left);
+	ret += arducam_write(client, IPC_SEL_WIDTH_REG, rect->width);
+	ret += arducam_write(client, IPC_SEL_HEIGHT_REG, rect->height);
+
+	if (ret) {
+		v4l2_err(client, "%s: Failed to write selection.\n",
+			 __func__);
+		return -EIO;
+	}
+	return 0;
+}
+
+/* Crop bounds from the firmware, kept for TRY requests */
+static int arducam_read_bounds(struct arducam *arducam, struct v4l2_rect *bounds)
+{
+	struct i2c_client *client = arducam->client;
+	int ret;
+
+	ret = arducam_write(client, IPC_SEL_TARGET_REG, V4L2_SEL_TGT_CROP_BOUNDS);
+	if (ret) {
+		v4l2_err(client, "%s: Write register 0x%02x failed\n",
+			 	 __func__, IPC_SEL_TARGET_REG);
+		return -EINVAL;
+	}
+	wait_for_free(client, 2);
+
+	ret = arducam_read_sel(arducam, bounds);
+	if (ret)
+		return ret;
+	arducam->crop_bounds = *bounds;
+	arducam->crop_bounds_valid = true;
+	return 0;
+}
+
+/*
+ * Crop bounds for TRY requests, without touching the sensor: the cached
+ * bounds, or before the first read the largest mode the firmware listed.
+ */
+static void arducam_try_bounds(struct arducam *arducam, struct v4l2_rect *bounds)
+{
+	int i, j;
+
+	if (arducam->crop_bounds_valid) {
+		*bounds = arducam->crop_bounds;
+		return;
+	}
+	memset(bounds, 0, sizeof(*bounds));
+	for (i = 0; i < arducam->num_supported_formats; i++) {
+		struct arducam_format *f = &arducam->supported_formats[i];
+
+		for (j = 0; j < f->num_resolution_set; j++) {
+			bounds->width = max_t(u32, bounds->width, f->resolution_set[j].width);
+			bounds->height = max_t(u32, bounds->height, f->resolution_set[j].height);
+		}
+	}
+}
+
+/* Crop window back to the whole pixel array of the current mode */
+static void arducam_reset_sel(struct arducam *arducam) {
+	struct i2c_client *client = arducam->client;
+	struct v4l2_rect bounds;
+
+	lockdep_assert_held(&arducam->mutex);
+
+	arducam->crop_active = false;
+	if (arducam_read_bounds(arducam, &bounds))
+		return;
+	if (arducam_write(client, IPC_SEL_TARGET_REG, V4L2_SEL_TGT_CROP))
+		return;
+	arducam_write_sel(arducam, &bounds);
+	wait_for_free(client, 2);
+	arducam->crop = bounds;
+}
+
 static const struct v4l2_rect *
 __arducam_get_pad_crop(struct arducam *arducam, struct v4l2_subdev_pad_config *cfg,
 		      unsigned int pad, enum v4l2_subdev_format_whence which)
@@ -924,6 +1153,94 @@ static int arducam_get_selection(struct v4l2_subdev *sd,
 	return -EINVAL;
 }
 
+/*
+ * Crop on the sensor: only the selected window is sent over CSI-2, so the
+ * rows the application would throw away (sky above the path) cost nothing.
+ * The image pad takes the crop size; set_fmt with that size keeps the crop,
+ * any other size selects a new mode and resets it.
+ */
+static int arducam_set_selection(struct v4l2_subdev *sd,
+				struct v4l2_subdev_pad_config *cfg,
+				struct v4l2_subdev_selection *sel)
+{
+	int ret = 0;
+	struct v4l2_rect bounds, rect;
+	struct arducam *arducam = to_arducam(sd);
+	struct i2c_client *client = arducam->client;
+	struct arducam_i2c_stats snap;
+
+	if (sel->target != V4L2_SEL_TGT_CROP || sel->pad != IMAGE_PAD)
+		return -EINVAL;
+
+	mutex_lock(&arducam->mutex);
+	arducam_op_begin(&arducam->regs, &snap);
+
+	/* TRY only fits the request: no register access, also while streaming */
+	if (sel->which == V4L2_SUBDEV_FORMAT_TRY) {
+		arducam_try_bounds(arducam, &bounds);
+	} else {
+		/* The window cannot move while frames are on the wire */
+		if (arducam->streaming) {
+			ret = -EBUSY;
+			goto unlock;
+		}
+
+		ret = arducam_read_bounds(arducam, &bounds);
+		if (ret)
+			goto unlock;
+	}
+
+	/*
+	 * Fit the request into the pixel array, on even pixels. Minimum first,
+	 * then the bound: an array under ARDUCAM_SEL_MIN_SIZE keeps its size.
+	 */
+	rect.width = min_t(u32, max_t(u32, round_down(sel->r.width, ARDUCAM_SEL_ALIGN),
+				      ARDUCAM_SEL_MIN_SIZE), bounds.width);
+	rect.height = min_t(u32, max_t(u32, round_down(sel->r.height, ARDUCAM_SEL_ALIGN),
+				       ARDUCAM_SEL_MIN_SIZE), bounds.height);
+	rect.left = clamp_t(s32, sel->r.left, bounds.left,
+			    bounds.left + bounds.width - rect.width);
+	rect.top = clamp_t(s32, sel->r.top, bounds.top,
+			   bounds.top + bounds.height - rect.height);
+	rect.left = round_down(rect.left, ARDUCAM_SEL_ALIGN);
+	rect.top = round_down(rect.top, ARDUCAM_SEL_ALIGN);
+
+	v4l2_dbg(1, debug, client, "%s: %dx%d@(%d,%d) -> %dx%d@(%d,%d)\n",
+		 __func__, sel->r.width, sel->r.height, sel->r.left, sel->r.top,
+		 rect.width, rect.height, rect.left, rect.top);
+
+	if (sel->which == V4L2_SUBDEV_FORMAT_TRY) {
+		*v4l2_subdev_get_try_crop(sd, cfg, sel->pad) = rect;
+		sel->r = rect;
+		goto unlock;
+	}
+
+	ret = arducam_write(client, IPC_SEL_TARGET_REG, V4L2_SEL_TGT_CROP);
+	if (ret) {
+		ret = -EIO;
+		goto unlock;
+	}
+
+	ret = arducam_write_sel(arducam, &rect);
+	if (ret)
+		goto unlock;
+
+	wait_for_free(client, 2);
+
+	/* Report the window the firmware applied */
+	ret = arducam_read_sel(arducam, &arducam->crop);
+	if (ret)
+		goto unlock;
+
+	arducam->crop_active = !v4l2_rect_equal(&arducam->crop, &bounds);
+	sel->r = arducam->crop;
+
+unlock:
+	arducam_op_end(&arducam->regs, ARDUCAM_OP_SELECTION, &snap);
+	mutex_unlock(&arducam->mutex);
+	return ret;
+}
+
 /* Stop streaming */
 static int arducam_stop_streaming(struct arducam *arducam)
 {
@@ -1052,6 +1369,7 @@ static const struct v4l2_subdev_pad_ops arducam_pad_ops = {
 	.set_fmt = arducam_csi2_set_fmt,
 	.enum_frame_size = arducam_csi2_enum_framesizes,
 	.get_selection = arducam_get_selection,
+	.set_selection = arducam_set_selection,
 };
 
 static const struct v4l2_subdev_ops arducam_subdev_ops = {
@@ -1515,6 +1833,121 @@ err:
 	return -ENODEV;
 }
 
+static const char * const arducam_op_names[ARDUCAM_NUM_OPS] = {
+	[ARDUCAM_OP_PROBE] = "probe",
+	[ARDUCAM_OP_SET_FMT] = "set_fmt",
+	[ARDUCAM_OP_STREAM_ON] = "stream_on",
+	[ARDUCAM_OP_S_CTRL] = "s_ctrl",
+	[ARDUCAM_OP_SELECTION] = "selection",
+};
+
+static int arducam_i2c_stats_show(struct seq_file *m, void *unused)
+{
+	struct arducam *arducam = m->private;
+	struct arducam_regcache *regs = &arducam->regs;
+	int i;
+
+	seq_printf(m, "cache %s: %llu reads, %llu writes, %llu failures, %llu cached\n",
+		   regs->enabled ? "on" : "off", regs->stats.reads,
+		   regs->stats.writes, regs->stats.failures, regs->stats.hits);
+	seq_puts(m, "op         calls  reads/last writes/last cached/last  wait us/last\n");
+	for (i = 0; i < ARDUCAM_NUM_OPS; i++) {
+		const struct arducam_op_stats *op = &regs->ops[i];
+
+		seq_printf(m, "%-10s %5u %6llu/%-4llu %6llu/%-4llu %6llu/%-4llu %8llu/%llu\n",
+			   arducam_op_names[i], op->calls,
+			   op->total.reads, op->last.reads,
+			   op->total.writes, op->last.writes,
+			   op->total.hits, op->last.hits,
+			   op->total.wait_us, op->last.wait_us);
+	}
+	return 0;
+}
+
+static int arducam_wait_stats_show(struct seq_file *m, void *unused)
+{
+	struct arducam_wait_stats *s = &((struct arducam *)m->private)->waits;
+	int i;
+
+	seq_printf(m, "calls %u, timeouts %u, polls %llu, total %llu us, mean %llu us, max %u us\n",
+		   s->calls, s->timeouts, s->polls, s->total_us,
+		   s->calls ? div_u64(s->total_us, s->calls) : 0, s->max_us);
+	for (i = 0; i < ARDUCAM_WAIT_HIST; i++)
+		seq_printf(m, "%s%5u us: %u\n",
+			   i < ARDUCAM_WAIT_HIST - 1 ? "< " : ">=",
+			   i < ARDUCAM_WAIT_HIST - 1 ? 125 << i : 125 << (i - 1),
+			   s->hist[i]);
+
+	seq_puts(m, "latest calls:\n");
+	for (i = 0; i < ARDUCAM_WAIT_LOG; i++) {
+		const struct arducam_wait_call *call =
+			&s->log[(s->log_next + i) % ARDUCAM_WAIT_LOG];
+
+		if (call->caller)
+			seq_printf(m, "  %s: %u us, %u polls%s\n", call->caller,
+				   call->us, call->polls,
+				   call->timeout ? " (timeout)" : "");
+	}
+	return 0;
+}
+
+/*
+ * Any write clears the per operation and wait statistics, e.g. before timing
+ * a stream on. The bus totals keep counting (operations in flight use them).
+ */
+static ssize_t arducam_stats_reset(struct file *file, const char __user *buf,
+				   size_t count, loff_t *ppos)
+{
+	struct arducam *arducam = ((struct seq_file *)file->private_data)->private;
+
+	mutex_lock(&arducam->mutex);
+	memset(&arducam->waits, 0, sizeof(arducam->waits));
+	memset(arducam->regs.ops, 0, sizeof(arducam->regs.ops));
+	mutex_unlock(&arducam->mutex);
+	return count;
+}
+
+static int arducam_i2c_stats_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, arducam_i2c_stats_show, inode->i_private);
+}
+
+static int arducam_wait_stats_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, arducam_wait_stats_show, inode->i_private);
+}
+
+static const struct file_operations arducam_i2c_stats_fops = {
+	.owner = THIS_MODULE,
+	.open = arducam_i2c_stats_open,
+	.read = seq_read,
+	.write = arducam_stats_reset,
+	.llseek = seq_lseek,
+	.release = single_release,
+};
+
+static const struct file_operations arducam_wait_stats_fops = {
+	.owner = THIS_MODULE,
+	.open = arducam_wait_stats_open,
+	.read = seq_read,
+	.write = arducam_stats_reset,
+	.llseek = seq_lseek,
+	.release = single_release,
+};
+
+/* /sys/kernel/debug/arducam-<bus>-<addr>/{i2c_stats,wait_stats} */
+static void arducam_debugfs_init(struct arducam *arducam)
+{
+	char name[32];
+
+	snprintf(name, sizeof(name), "arducam-%s", dev_name(&arducam->client->dev));
+	arducam->debugfs = debugfs_create_dir(name, NULL);
+	debugfs_create_file("i2c_stats", 0644, arducam->debugfs, arducam,
+			    &arducam_i2c_stats_fops);
+	debugfs_create_file("wait_stats", 0644, arducam->debugfs, arducam,
+			    &arducam_wait_stats_fops);
+}
+
 static int arducam_probe(struct i2c_client *client,
 			const struct i2c_device_id *id)
 {
@@ -1523,6 +1956,7 @@ static int arducam_probe(struct i2c_client *client,
 	struct arducam *arducam;
     u32 device_id;
 	u32 firmware_version;
+	struct arducam_i2c_stats snap;
 	int ret;
 	arducam = devm_kzalloc(&client->dev, sizeof(*arducam), GFP_KERNEL);
 	if (!arducam)
@@ -1530,6 +1964,8 @@ static int arducam_probe(struct i2c_client *client,
 	/* Initialize subdev */
 	v4l2_i2c_subdev_init(&arducam->sd, client, &arducam_subdev_ops);
 	arducam->client = client;
+	arducam_regcache_init(&arducam->regs, regcache);
+	arducam_op_begin(&arducam->regs, &snap);
 
 	/* Get CSI2 bus config */
 	endpoint = fwnode_graph_get_next_endpoint(dev_fwnode(&client->dev),
@@ -1627,6 +2063,13 @@ static int arducam_probe(struct i2c_client *client,
 	pm_runtime_enable(dev);
 	pm_runtime_idle(dev);
 
+	arducam_op_end(&arducam->regs, ARDUCAM_OP_PROBE, &snap);
+	dev_info(dev, "probe: %llu I2C reads (%llu more from cache), %llu writes\n",
+		 arducam->regs.ops[ARDUCAM_OP_PROBE].last.reads,
+		 arducam->regs.ops[ARDUCAM_OP_PROBE].last.hits,
+		 arducam->regs.ops[ARDUCAM_OP_PROBE].last.writes);
+	arducam_debugfs_init(arducam);
+
 	return 0;
 
 error_media_entity:
@@ -1646,6 +2089,7 @@ static int arducam_remove(struct i2c_client *client)
 	struct v4l2_subdev *sd = i2c_get_clientdata(client);
 	struct arducam *arducam = to_arducam(sd);
 
+	debugfs_remove_recursive(arducam->debugfs);
 	v4l2_async_unregister_subdev(sd);
 	media_entity_cleanup(&sd->entity);
 	arducam_free_controls(arducam);
@@ -0,0 +1,286 @@
+#ifndef _ARDUCAM_REGCACHE_H_
+#define _ARDUCAM_REGCACHE_H_
+/*
+ * Shadow cache of the Pivariety registers.
+ *
+ * Table reads (index register, then entry register) are cached, keyed by
+ * what selected them:
+ *
+ *   - device identification registers: static
+ *   - pixel format / resolution tables: keyed by the indexes written
+ *   - control id / ranges: keyed by mode + selected control, dropped
+ *     (generation bump) whenever a control value changes
+ *   - index registers: the value last written
+ *
+ * SYSTEM_IDLE_REG, IPC_SEL_* and control values are never cached.
+ * Writes always go to the bus.
+ * arducam_regcache_invalidate() drops everything; call it after power on.
+ *
+ * Also counts bus transactions (retries included) per driver operation.
+ * Plain C, no kernel calls: CPP/igv/ArducamRegisterModel.hpp builds it in
+ * user space.
+ */
+
+#define ARDUCAM_REGCACHE_SIZE	256	/* entries, power of 2 */
+#define ARDUCAM_REGCACHE_CTRLS	32	/* as struct arducam.ctrls */
+#define ARDUCAM_SEL_UNKNOWN	0xFFFFFFFF
+#define ARDUCAM_SEL_BY_INDEX	0x80000000	/* ctrl_sel holds an index */
+
+struct arducam_regcache_entry {
+	u16 reg;
+	u16 valid;
+	u32 mode;	/* pixformat << 16 | resolution (control ranges) */
+	u32 sel;	/* table index / control the value belongs to */
+	u32 gen;	/* control generation (control ranges) */
+	u32 val;
+};
+
+struct arducam_ctrl_value {
+	u32 id;
+	u32 val;
+	bool valid;
+};
+
+struct arducam_i2c_stats {
+	u64 reads;	/* bus read transactions */
+	u64 writes;	/* bus write transactions */
+	u64 failures;	/* transactions that failed (then retried) */
+	u64 hits;	/* reads answered by the shadow cache */
+	u64 wait_us;	/* time spent in wait_for_free() */
+};
+
+enum arducam_op {
+	ARDUCAM_OP_PROBE,
+	ARDUCAM_OP_SET_FMT,
+	ARDUCAM_OP_STREAM_ON,
+	ARDUCAM_OP_S_CTRL,
+	ARDUCAM_OP_SELECTION,
+	ARDUCAM_NUM_OPS,
+};
+
+struct arducam_op_stats {
+	u32 calls;
+	struct arducam_i2c_stats last;	/* transactions of the latest call */
+	struct arducam_i2c_stats total;
+};
+
+struct arducam_regcache {
+	bool enabled;
+	u32 pixfmt_idx;		/* last PIXFORMAT_INDEX_REG write */
+	u32 res_idx;		/* last RESOLUTION_INDEX_REG write */
+	u32 ctrl_sel;		/* last CTRL_ID_REG write, or CTRL_INDEX_REG | BY_INDEX */
+	u32 ctrl_gen;
+	struct arducam_regcache_entry entries[ARDUCAM_REGCACHE_SIZE];
+	struct arducam_ctrl_value ctrls[ARDUCAM_REGCACHE_CTRLS];	/* last set */
+	struct arducam_i2c_stats stats;
+	struct arducam_op_stats ops[ARDUCAM_NUM_OPS];
+};
+
+static inline void arducam_regcache_invalidate(struct arducam_regcache *c)
+{
+	int i;
+
+	for (i = 0; i < ARDUCAM_REGCACHE_SIZE; i++)
+		c->entries[i].valid = 0;
+	for (i = 0; i < ARDUCAM_REGCACHE_CTRLS; i++)
+		c->ctrls[i].valid = false;
+	c->pixfmt_idx = ARDUCAM_SEL_UNKNOWN;
+	c->res_idx = ARDUCAM_SEL_UNKNOWN;
+	c->ctrl_sel = ARDUCAM_SEL_UNKNOWN;
+}
+
+static inline void arducam_regcache_init(struct arducam_regcache *c,
+					 bool enabled)
+{
+	c->enabled = enabled;
+	c->ctrl_gen = 0;
+	arducam_regcache_invalidate(c);
+}
+
+
+/* What a read of "reg" depends on. false: never cached */
+static inline bool arducam_regcache_key(const struct arducam_regcache *c,
+					u16 reg, u32 *mode, u32 *sel, u32 *gen)
+{
+	*mode = 0;
+	*sel = 0;
+	*gen = 0;
+
+	switch (reg) {
+	case DEVICE_VERSION_REG:
+	case SENSOR_ID_REG:
+	case DEVICE_ID_REG:
+	case FLIPS_DONT_CHANGE_ORDER_REG:
+		return true;
+
+	case PIXFORMAT_INDEX_REG:
+	case RESOLUTION_INDEX_REG:
+	case CTRL_INDEX_REG:
+		return true;
+
+	case PIXFORMAT_TYPE_REG:
+	case PIXFORMAT_ORDER_REG:
+	case MIPI_LANES_REG:
+		*sel = c->pixfmt_idx;
+		return c->pixfmt_idx != ARDUCAM_SEL_UNKNOWN;
+
+	case FORMAT_WIDTH_REG:
+	case FORMAT_HEIGHT_REG:
+		*sel = (c->pixfmt_idx << 16) | (c->res_idx & 0xFFFF);
+		return c->pixfmt_idx != ARDUCAM_SEL_UNKNOWN &&
+			c->res_idx != ARDUCAM_SEL_UNKNOWN;
+
+	case CTRL_ID_REG:
+	case CTRL_MIN_REG:
+	case CTRL_MAX_REG:
+	case CTRL_STEP_REG:
+	case CTRL_DEF_REG:
+		*mode = (c->pixfmt_idx << 16) | (c->res_idx & 0xFFFF);
+		*sel = c->ctrl_sel;
+		*gen = c->ctrl_gen;
+		return c->ctrl_sel != ARDUCAM_SEL_UNKNOWN &&
+			c->pixfmt_idx != ARDUCAM_SEL_UNKNOWN &&
+			c->res_idx != ARDUCAM_SEL_UNKNOWN;
+	}
+	return false;
+}
+
+static inline struct arducam_regcache_entry *
+arducam_regcache_slot(struct arducam_regcache *c, u16 reg, u32 mode, u32 sel)
+{
+	u32 h = reg * 2654435761u ^ mode * 40503u ^ sel * 2246822519u;
+
+	return &c->entries[(h ^ (h >> 16)) & (ARDUCAM_REGCACHE_SIZE - 1)];
+}
+
+/* Looks "reg" up without counting a hit */
+static inline bool arducam_regcache_peek(struct arducam_regcache *c,
+					 u16 reg, u32 *val)
+{
+	struct arducam_regcache_entry *e;
+	u32 mode, sel, gen;
+
+	if (!c->enabled || !arducam_regcache_key(c, reg, &mode, &sel, &gen))
+		return false;
+
+	e = arducam_regcache_slot(c, reg, mode, sel);
+	if (!e->valid || e->reg != reg || e->mode != mode ||
+		e->sel != sel || e->gen != gen)
+		return false;
+
+	*val = e->val;
+	return true;
+}
+
+static inline bool arducam_regcache_lookup(struct arducam_regcache *c,
+					   u16 reg, u32 *val)
+{
+	if (!arducam_regcache_peek(c, reg, val))
+		return false;
+	c->stats.hits++;
+	return true;
+}
+
+/* Value read from the device (NO_DATA_AVAILABLE is never kept) */
+static inline void arducam_regcache_store(struct arducam_regcache *c,
+					  u16 reg, u32 val)
+{
+	struct arducam_regcache_entry *e;
+	u32 mode, sel, gen;
+
+	if (!c->enabled || val == NO_DATA_AVAILABLE ||
+		!arducam_regcache_key(c, reg, &mode, &sel, &gen))
+		return;
+
+	e = arducam_regcache_slot(c, reg, mode, sel);
+	e->reg = reg;
+	e->mode = mode;
+	e->sel = sel;
+	e->gen = gen;
+	e->val = val;
+	e->valid = 1;
+}
+
+/* Value written to the device. ok = false: the device state is unknown */
+static inline void arducam_regcache_write(struct arducam_regcache *c,
+					  u16 reg, u32 val, bool ok)
+{
+	switch (reg) {
+	case PIXFORMAT_INDEX_REG:
+		c->pixfmt_idx = ok ? val : ARDUCAM_SEL_UNKNOWN;
+		break;
+	case RESOLUTION_INDEX_REG:
+		c->res_idx = ok ? val : ARDUCAM_SEL_UNKNOWN;
+		break;
+	case CTRL_INDEX_REG:
+		c->ctrl_sel = ok ? (val | ARDUCAM_SEL_BY_INDEX) : ARDUCAM_SEL_UNKNOWN;
+		break;
+	case CTRL_ID_REG:
+		c->ctrl_sel = ok ? val : ARDUCAM_SEL_UNKNOWN;
+		break;
+	default:
+		return;
+	}
+	if (ok)
+		arducam_regcache_store(c, reg, val);
+}
+
+/*
+ * Control "id" set to "val" (s_ctrl). Ranges read before may depend on it
+ * (vblank on frame rate...), so they are dropped, unless the value is the one
+ * already set: v4l2_ctrl_handler_setup() rewrites every control on stream on.
+ * ok = false: the write failed, the value on the device is unknown.
+ */
+static inline void arducam_regcache_ctrl_set(struct arducam_regcache *c,
+					     u32 id, u32 val, bool ok)
+{
+	struct arducam_ctrl_value *v = NULL;
+	int i;
+
+	for (i = 0; i < ARDUCAM_REGCACHE_CTRLS; i++) {
+		if (c->ctrls[i].valid && c->ctrls[i].id == id) {
+			v = &c->ctrls[i];
+			break;
+		}
+		if (!v && !c->ctrls[i].valid)
+			v = &c->ctrls[i];
+	}
+
+	if (ok && v && v->valid && v->val == val)
+		return;
+
+	if (v) {
+		v->id = id;
+		v->val = val;
+		v->valid = ok;
+	}
+	c->ctrl_gen++;
+}
+
+/* Per operation transaction counts: begin() snapshot, end() accounts it */
+static inline void arducam_op_begin(const struct arducam_regcache *c,
+				    struct arducam_i2c_stats *snap)
+{
+	*snap = c->stats;
+}
+
+static inline void arducam_op_end(struct arducam_regcache *c,
+				  enum arducam_op op,
+				  const struct arducam_i2c_stats *snap)
+{
+	struct arducam_op_stats *s = &c->ops[op];
+
+	s->calls++;
+	s->last.reads = c->stats.reads - snap->reads;
+	s->last.writes = c->stats.writes - snap->writes;
+	s->last.failures = c->stats.failures - snap->failures;
+	s->last.hits = c->stats.hits - snap->hits;
+	s->last.wait_us = c->stats.wait_us - snap->wait_us;
+	s->total.reads += s->last.reads;
+	s->total.writes += s->last.writes;
+	s->total.failures += s->last.failures;
+	s->total.hits += s->last.hits;
+	s->total.wait_us += s->last.wait_us;
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef _ARDUCAM_WAIT_H_
+#define _ARDUCAM_WAIT_H_
+/*
+ * Polling schedule and statistics of wait_for_free().
+ *
+ * Most firmware commands (control writes, window changes) finish in well
+ * under a millisecond, stream on takes a few. Sleeping a whole "interval"
+ * between SYSTEM_IDLE_REG polls rounded every wait up to that interval, so
+ * the schedule is:
+ *
+ *   - tight polling, ARDUCAM_WAIT_TIGHT_SLEEP_US between polls, for the first
+ *     ARDUCAM_WAIT_TIGHT_US
+ *   - then exponential backoff, doubling up to the caller's interval, so a
+ *     long command does not keep the bus busy with polls
+ *   - ARDUCAM_WAIT_TIMEOUT_US in total, as the 1000 / interval polls before
+ *
+ * Plain C without kernel calls: the user-space harness (CPP/igv/
+ * ArducamRegisterModel.hpp) runs this schedule against a simulated clock.
+ */
+
+#define ARDUCAM_WAIT_TIMEOUT_US		1000000
+#define ARDUCAM_WAIT_TIGHT_US		1000
+#define ARDUCAM_WAIT_TIGHT_SLEEP_US	50
+#define ARDUCAM_WAIT_HIST		8	/* < 125 us, < 250 us ... >= 8 ms */
+#define ARDUCAM_WAIT_LOG		16	/* latest calls kept */
+
+struct arducam_wait_call {
+	const char *caller;		/* call site (function name) */
+	u32 us;
+	u16 polls;
+	u16 timeout;
+};
+
+struct arducam_wait_stats {
+	u32 calls;
+	u32 timeouts;
+	u64 polls;
+	u64 total_us;
+	u32 max_us;
+	u32 hist[ARDUCAM_WAIT_HIST];
+	struct arducam_wait_call log[ARDUCAM_WAIT_LOG];
+	u32 log_next;
+};
+
+/* Sleep before the next poll, "prev_us" the previous sleep (0 at first) */
+static inline u32 arducam_wait_next_us(u32 elapsed_us, u32 prev_us,
+				       u32 interval_us)
+{
+	u32 next;
+
+	if (elapsed_us < ARDUCAM_WAIT_TIGHT_US)
+		return ARDUCAM_WAIT_TIGHT_SLEEP_US;
+
+	next = prev_us * 2;
+	if (next < ARDUCAM_WAIT_TIGHT_SLEEP_US * 2)
+		next = ARDUCAM_WAIT_TIGHT_SLEEP_US * 2;
+	if (next > interval_us)
+		next = interval_us;
+	return next;
+}
+
+static inline int arducam_wait_bucket(u32 us)
+{
+	int i = 0;
+
+	us /= 125;
+	while (us && i < ARDUCAM_WAIT_HIST - 1) {
+		us >>= 1;
+		i++;
+	}
+	return i;
+}
+
+static inline void arducam_wait_account(struct arducam_wait_stats *s,
+					const char *caller, u32 us,
+					u32 polls, bool timeout)
+{
+	struct arducam_wait_call *call = &s->log[s->log_next];
+
+	s->calls++;
+	s->timeouts += timeout;
+	s->polls += polls;
+	s->total_us += us;
+	if (us > s->max_us)
+		s->max_us = us;
+	s->hist[arducam_wait_bucket(us)]++;
+
+	call->caller = caller;
+	call->us = us;
+	call->polls = polls > 0xFFFF ? 0xFFFF : polls;
+	call->timeout = timeout;
+	s->log_next = (s->log_next + 1) % ARDUCAM_WAIT_LOG;
+}
+
+#endif
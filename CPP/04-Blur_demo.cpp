@@ -1,5 +1,8 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
+#include "igv/BoxBlur.hpp"
+#include "igv/MedianBlur.hpp"
+#include "igv/FixedKernels.hpp"
 
 int main()
 {
@@ -43,17 +46,25 @@ int main()
 
         if (mode == 'b')
         {
-            cv::blur(frame, blurImg, cv::Size(50, 50));
+            // Same as cv::blur(frame, blurImg, cv::Size(50, 50)) (within 1):
+            // running sums, cost independent of the kernel size, one row
+            // band per core (igv/BoxBlur.hpp)
+            igv::boxBlur(frame, blurImg, cv::Size(50, 50), igv::hardwareThreads());
             cv::imshow("Camera", blurImg);
         }
         else if (mode == 'g')
         {
-            cv::GaussianBlur(frame, gussImg, cv::Size(5, 5), 0);
+            // Same pixels as cv::GaussianBlur(frame, gussImg, cv::Size(5, 5), 0):
+            // 5x5 BGR kernel compiled with its loops unrolled, one row band
+            // per core (igv/FixedKernels.hpp)
+            igv::gaussianBlur(frame, gussImg, cv::Size(5, 5), igv::hardwareThreads());
             cv::imshow("Camera", gussImg);
         }
         else if (mode == 'm')
         {
-            cv::medianBlur(frame, medianImg, 5);
+            // Same pixels as cv::medianBlur(frame, medianImg, 5): SIMD
+            // sorting network, one row band per core (igv/MedianBlur.hpp)
+            igv::medianBlur(frame, medianImg, 5, igv::hardwareThreads());
             cv::imshow("Camera", medianImg);
         }
         else
@@ -1,5 +1,6 @@
 #include<opencv2/opencv.hpp>
 #include<iostream>
+#include "igv/Morphology.hpp"
 
 int main()
 {
@@ -20,23 +21,27 @@ int main()
 
     cv::Mat frame, gray, binary, morphopen, morphclose, erode, dilated;
 
+    // 5x5 rectangle, set once (was rebuilt every frame)
+    const cv::Size kernal(5, 5);
+
+    // All four results from one call: open reuses the erosion and close the
+    // dilation, strip by strip, with no full intermediate image (igv/Morphology.hpp)
+    igv::MorphOutputs<cv::Mat> morph;
+    morph.erode = &erode;
+    morph.dilate = &dilated;
+    morph.open = &morphopen;
+    morph.close = &morphclose;
+
     while(true)
     {
         cap >> frame;
         if(frame.empty()) break;
 
-        cv:: Mat kernal = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(5, 5));
-
         cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
 
         cv::threshold(gray, binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
 
-        cv::morphologyEx(binary, morphclose, cv::MORPH_CLOSE, kernal);
-        cv::morphologyEx(binary, morphopen, cv::MORPH_OPEN, kernal);
-
-        cv::erode(binary, erode, kernal);
-
-        cv::dilate(binary, dilated, kernal);
+        igv::morphology(binary, kernal, morph, igv::hardwareThreads());
 
         cv::imshow("Grayscale", gray);
         cv::imshow("Binary", binary);
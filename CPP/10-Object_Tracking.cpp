@@ -33,6 +33,10 @@
 // Used here for debugging or printing messages if nedded.
 #include<iostream>
 
+// Rectangular erode / dilate / open / close, same pixels as OpenCV, cost
+// independent of the kernel size (van Herk / Gil-Werman)
+#include "igv/Morphology.hpp"
+
 //======================= MAIN FUNCTION =========================================
 
 int main()
@@ -247,17 +251,18 @@ int main()
 
         // Perform a morphological opertaion on a binary image
         //
-        // cv::morphologyEx(
-        //      InputArray  src,        -> source image (binary image)
-        //      OutputArray dst,        -> output image after morphology
-        //      int         op,         -> type of morphological operations
-        //      InputArray  kernel      -> structuring element (kernel)
+        // igv::morphClose(
+        //      const cv::Mat& src,     -> source image (binary image)
+        //      cv::Mat&       dst,     -> output image after morphology
+        //      cv::Size       ksize    -> size of the rectangular kernel
         // )
-        cv::morphologyEx(
+        // Same result as cv::morphologyEx(binary, morph, cv::MORPH_CLOSE, kernel)
+        // for a MORPH_RECT kernel, with the dilation and erosion run strip by
+        // strip (no full intermediate image)
+        igv::morphClose(
             binary,                     // Input: binary image (0 to 255)
             morph,                      // Output: morphologically processed image
-            cv::MORPH_CLOSE,            // Operation: Closing (Dilation -> Erosion)
-            kernel                      // Structuring element (defines nighbothood)
+            kernel.size()               // Closing (Dilation -> Erosion) over the kernel's rectangle
         );
 
         // ================= CONTOUR STORAGE =================================
@@ -17,12 +17,18 @@
 // ======================== Header Files ==============================
 #include <opencv2/opencv.hpp> // Realted to OpenCV 
 #include <iostream> // Standered I/O stream Library
+#include "igv/GrayBlurOtsu.hpp" // Fused grayscale + blur + OTSU
+
+// Path ROI: rows above this fraction of the image height are ignored
+// (0.5 = bottom half, 0.3 = bottom 70 %)
+const double ROI_TOP_FRACTION = 0.5;
 
 int main()
 {
     // Local Variable declartions
     // OpenCV realted Variables
-    cv::Mat frame, gray, binary, roi;
+    cv::Mat frame, roi;
+    igv::GrayBlurOtsu pathThreshold(igv::OtsuReuse::video()); // Keeps its row buffers between frames
 
     // Code
 
@@ -92,55 +98,38 @@ int main()
             return(EXIT_FAILURE); 
         }
 
-        // Step 1.Convert color image (BGR Format) into a grayscale
-        // frame -> grayscale
-        cv::cvtColor(
-            frame,                  // Input: Original BGR image from camera
-            gray,                   // Output: Single-cahnnel (Grayscale image)
-            cv::COLOR_BGR2GRAY      // Conversion type: BGR -> Grayscale
-        );
-
-        // Step 2.Apply Gaussian Blur to the Grayscale image
-        // Grayscale -> Gaussian Blur
-        cv::GaussianBlur(
-            gray,                   // Input: grayscale image
-            gray,                   // Output: Same image overwritten (in-place)
-            cv::Size(5, 5),         // 5x5 Gaussian kernal 
-            0                       // Auto calculate Sigma
-        );
-
-        // Step 3.Apply thershold to convert a grayscale image a binary image
-        // Gaussian blur -> Thersholding
-        // This converts | 0(Black) | 255(White)
-        cv::threshold(
-            gray,                   // Input Grayscale Image 
-            binary,                 // Output Binary Image
-            0,                      // Thershold value (not used by OTSU)
-            255,                    // Maximum Value for THRESH_BINARY
-            cv::THRESH_BINARY |     // Binary thersholding 
-            cv::THRESH_OTSU         // Automatically calculates best thershold
-        );
-
-        // Step 4.Define ROI
+        // Step 1.Define ROI (before any processing)
         // ROI = Region of Interest 
         // Insted of processing thr entire image, we process only a spacific region
-        // Here: The bottom half of the image (where the robot path is expected)
-
-        int h = binary.rows; // Total height of the binary image (In pixels)
-        int w = binary.cols; // Total width of the binary image (In Pixels)
+        // Here: The bottom part of the image (where the robot path is expected)
+        int h = frame.rows; // Total height of the frame (In pixels)
+        int w = frame.cols; // Total width of the frame (In Pixels)
+        int top = (int)(h * ROI_TOP_FRACTION); // First ROI row
 
-        // Create ROI using cv::react
         // cv::Rect(x, y, width, height)
-        roi = binary(cv::Rect(
+        cv::Rect pathRect(
             0,                      // Start from left edge
-            h/2,                    // Start from middle vertically
+            top,                    // Start below the ignored top part
             w,                      // full width
-            h/2                     // bottom half of the image
-        )); 
+            h - top                 // down to the bottom of the image
+        );
+
+        // Step 2-4.Grayscale -> Gaussian Blur (5x5) -> OTSU thershold, fused
+        // frame ROI -> binary | 0(Black) | 255(White)
+        // Only the ROI rows are processed (the rows just above it are read as
+        // blur neighbours) and the OTSU threshold comes from the path area,
+        // not from the sky / background. The histogram samples every 4th
+        // row / column and the threshold is reused while it does not drift
+        // (igv::OtsuReuse::video), so it can differ slightly from
+        // cvtColor + GaussianBlur + threshold(OTSU) on the full frame
+        pathThreshold.apply(
+            frame,                  // Input: Original BGR image from camera
+            roi,                    // Output: Binary image of the ROI
+            pathRect                // Region processed
+        );
 
         // Show results
         // cv::imshow("Origianl", frame);
-        // cv::imshow("Binary", binary);
         cv::imshow("ROI (Path Area)", roi);
 
         if(cv::waitKey(1) == 27) // Waits 1 millisecond | Allows window refresh | Return ASCII value of pressed key
@@ -149,6 +138,8 @@ int main()
 
     std::cout << "----- IGV::Exiting While Loop -----" << std::endl;
 
+    pathThreshold.counters().print(std::cout); // Temporal OTSU counters
+
     std::cout << "----- Exiting Sucessfully -----" << std::endl;
     return(EXIT_SUCCESS);
 }
\ No newline at end of file
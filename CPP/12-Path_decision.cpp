@@ -31,12 +31,19 @@
 #include <opencv2/opencv.hpp> 
 #include <iostream>
 #include <cstdlib> // For EXIT_SUCCESS, EXIT_FAILURE
+#include "igv/GrayBlurOtsu.hpp" // Fused grayscale + blur + OTSU
+
+// Path ROI: rows above this fraction of the image height are ignored
+// (0.5 = bottom half, 0.3 = bottom 70 %)
+const double ROI_TOP_FRACTION = 0.5;
 
 int main()
 {
     // Local Variable decalarations
     // OpenCV Related variable 
-    cv::Mat frame, gray, binary, roi;
+    cv::Mat frame, roi;
+    igv::BitMask pathMask;              // Binary ROI, 1 bit per pixel
+    igv::GrayBlurOtsu pathThreshold(igv::OtsuReuse::video()); // Grayscale + blur + OTSU (row buffers kept)
 
     // ========== CSI Camera Pipeline ==========
     // CSI Camera pipeline required for jetson nano
@@ -90,45 +97,28 @@ int main()
             return(EXIT_FAILURE);
         }
 
-        // Step 1.Garyscale
-        // frame -> Grayscale
-        cv::cvtColor(
-            frame,              // Input: Original BGR image from camera
-            gray,               // Output: Signal-cahnnel (Grayscale image)
-            cv::COLOR_BGR2GRAY  // Convertion type: BGR -> Grayscale
-        );
+        // Step 1.ROI (Botton Half), chosen before processing
+        int h = frame.rows;     // Total Height of the frame (In Pixels)
+        int w = frame.cols;     // Total Width of the frame (In Pixels)
+        int top = (int)(h * ROI_TOP_FRACTION);
 
-        // Step 2.Blur
-        // Grayscale -> blur
-        cv::GaussianBlur(
-            gray,               // Input: grascale image 
-            gray,               // Output: Same image overwritten (in-place)
-            cv::Size(5, 5),     // 5x5 Gaussion kernal
-            0                   // Auto calculate Sigma
+        // ROI Using cv::Rect()
+        cv::Rect pathRect(
+            0,                  // Start from left edge
+            top,                // Start below the ignored top part
+            w,                  // Fill width
+            h - top             // Down to the bottom of the image
         );
 
-        // Step 3.Thershold
-        // Gaussian blur -> Thersholding
-        cv::threshold(
-            gray,               // Input Grayscale Image (Blur)
-            binary,             // Output Binary Image
-            0,                  // Thershold value (not used by OTSU)
-            255,                // Maximum Value for THRESH_BINARY
-            cv::THRESH_BINARY | // Binary therhsolding
-            cv::THRESH_OTSU     // Automatically calculates best thershold
+        // Step 2-4.Grayscale -> Blur -> Thershold (OTSU), ROI only
+        // One pass: rows converted and blurred in cache, histogram on the fly
+        // The OTSU threshold only sees the path area (no sky / background)
+        // The binary ROI is bit-packed (1 bit per pixel): it is only counted
+        pathThreshold.blur(
+            frame,              // Input: Original BGR image from camera
+            pathRect            // Region processed
         );
-
-        // Step 4.ROI (Botton Half)
-        int h = binary.rows;    // Total Height of the binary image (In Pixels)
-        int w = binary.cols;    // Total Width of the binayr image (In Pixels)
-
-        // Create a ROI Using cv::Rect()
-        roi = binary(cv::Rect(
-            0,                  // Start from left edge
-            h/2,                // Start from middle vertically
-            w,                  // Fill width
-            h/2                 // Bottom half of the image  
-        ));
+        pathThreshold.binarize(pathMask);
 
         // Step 5. Divide ROI into 3 Zones
         // LEFT | CENTER | RIGHT
@@ -137,57 +127,27 @@ int main()
         int zoneWidth = w / 3;
 
         /*
-        *   Create sub-ROIs (zones) from the main ROI
-        *   Note:   
-        *       - These are NOT copies
-        *       - They are views into the original ROI memory
-        *       - Extermely fast and memory-effiecent
-        * 
-        *   cv::Rect(x, y, width, height)
+        *   Zones of the ROI, cv::Rect(x, y, width, height)
+        *       Left   : from x = 0 to x = zoneWidth
+        *       Center : from x = zoneWidth to x = 2 * zoneWidth
+        *       Right  : from x = 2 * zoneWidth to x = 3 * zoneWitdh
         */
-
-        // Left Zone: from x = 0 to x = zoneWidth
-        cv::Mat leftzone = roi(
-            cv::Rect(
-                0,              // x Start
-                0,              // y start
-                zoneWidth,      // width
-                roi.rows        // Full height of ROI
-            )
-        );
-
-        // Center zone: from x = zoneWidth to x = 2 * zoneWidth
-        cv::Mat centerZone = roi(
-            cv::Rect(
-                zoneWidth,      // x Start
-                0,              // y Start
-                zoneWidth,      // Width
-                roi.rows        // Full height of ROI
-            )
-        );
-
-        // Right Zone: from x = 2 * zoneWidth to x = 3 * zoneWitdh
-        cv::Mat rightZone = roi(
-            cv::Rect(
-                2 * zoneWidth,  // x Start
-                0,              // y Start
-                zoneWidth,      // Width
-                roi.rows        // Full height of ROI
-            )
-        );
+        cv::Rect leftZone(0, 0, zoneWidth, pathMask.rows());
+        cv::Rect centerZone(zoneWidth, 0, zoneWidth, pathMask.rows());
+        cv::Rect rightZone(2 * zoneWidth, 0, zoneWidth, pathMask.rows());
 
         // Step 6. Count White Pixel in each zone
         /*
-        *   coutNonZero():
-        *       - Counts pixel with value != 0
+        *   BitMask::count():
+        *       - Counts set bits (popcount, 64 pixels at a time)
         *       - In binary image:
         *           0   -> Background
-        *           255 -> path / line / object 
+        *           1   -> path / line / object 
         */
 
-        int leftCount = cv::countNonZero(leftzone);
-        int centerCount = cv::countNonZero(centerZone);
-        int rightCount = cv::countNonZero(rightZone);
+        int leftCount = pathMask.count(leftZone);
+        int centerCount = pathMask.count(centerZone);
+        int rightCount = pathMask.count(rightZone);
 
         // Step 7. Decide movement direction
         /*
@@ -228,6 +188,7 @@ int main()
 
         // Visulations Windows 
         cv::imshow("Camera", frame);    // Full annotated frame
+        pathMask.toMat(roi);            // 0 / 255 image, display only
         cv::imshow("ROI", roi);         // Region used for decision
 
         // Exit Condition
@@ -241,4 +202,5 @@ int main()
         
     }
 
-}
\ No newline at end of file
+    pathThreshold.counters().print(std::cout); // Temporal OTSU counters
+}
@@ -7,7 +7,8 @@
  *                  Technique Used:
  *                      - Grayscale conversion
  *                      - Gaussion blur (noise reduction)    
- *                      - Frame differencing
+ *                      - Frame differencing (or background model)
+ *                      - Ego-motion compensation (sparse optical flow)
  *                      - Binary thresholding   
  *                      - Motion pixel counting
  *  Author      : Omkar Ankush Kashid
@@ -20,44 +21,74 @@
 
 #include <opencv2/opencv.hpp>
 #include <iostream>
+#include <cstdio>
 #include <cstdlib>
-
-int main()
+#include "igv/FrameSource.hpp"
+#include "igv/CaptureRing.hpp"
+#include "igv/FixedKernels.hpp"
+#include "igv/BackgroundModel.hpp"
+#include "igv/FrameHistory.hpp"
+#include "igv/EgoMotion.hpp"
+
+// Motion test (igv/BackgroundModel.hpp)
+//      FRAME_DIFF      : |gray - earlier frame| > 30 (MOTION_GAPS below)
+//      RUNNING_AVERAGE : |gray - background| > threshold
+//      GAUSSIAN        : |gray - background| > 3 sigma of the pixel
+// The background is learnt over the last frames: noise and vibration do
+// not add up to a stop, a slow approaching obstacle still does. It needs a
+// still camera (robot parked, watching its path); while the robot drives
+// the whole background moves, so the frame difference with EGO_MOTION is
+// the default
+const igv::MotionModel MOTION_MODEL = igv::MotionModel::FRAME_DIFF;
+
+// Frame difference: current frame against the frames 1, 2 and 4 back.
+// A slow obstacle (a few pixels per frame) stays under the threshold
+// between two frames and shows up over 2 or 4
+const int MOTION_GAPS[] = { 1, 2, 4 };
+const int HISTORY_DEPTH = 4;
+
+// Frame difference while driving / turning: the earlier frame is warped
+// by the global image motion (corners tracked on a 1/4 size frame, see
+// igv/EgoMotion.hpp) before the difference, so only what moves in the
+// scene is left. Estimate + warps stay within EGO_BUDGET_MS per frame:
+// the longer gaps are skipped when the time is out
+const bool EGO_MOTION = true;
+const double EGO_BUDGET_MS = 6.0;
+
+int main(int argc, char** argv)
 {
     // ==================== IMAGE CONTAINERS ====================
-    cv::Mat frame;      // Orignal color image from camera (BGR)
-    cv::Mat gray;       // current grayscale frame
-    cv::Mat prevGray;   // previous grayscale frame (used for comparision)
+    cv::Mat frame;      // Orignal image from camera (BGR, or NV12 in luma-only mode)
+    cv::Mat display;    // BGR copy of frame, only built for the display window
+    cv::Mat lumaScratch;// BGR -> gray buffer (unused when the source gives NV12)
+    cv::Mat gray;       // current grayscale frame (view of history[0])
     cv::Mat diff;       // absolute difference between current and prevoiuos frames
+    cv::Mat gapMask;    // thersholded difference for one frame gap
+    cv::Mat warped;     // earlier frame warped onto the current one (ego-motion)
     cv::Mat binary;     // thersholded motion mask (white = motion)
-    
-    // Flag to handle the very first frame
-    // firstFrame = true means:
-    //      - No prevoius frame exists yet
-    //      - Motion detection cannot be done
-    bool firstFrame = true;
+
+    // Last HISTORY_DEPTH + 1 grayscale frames in preallocated slots
+    // (no clone per frame, see igv/FrameHistory.hpp)
+    igv::FrameHistory history(HISTORY_DEPTH);
+
+    igv::BackgroundParams motionParams;
+    motionParams.model = MOTION_MODEL;
+    igv::BackgroundModel background(motionParams); // mean (+ variance) per pixel
+
+    igv::EgoMotionParams egoParams;
+    egoParams.budgetMs = EGO_BUDGET_MS;
+    egoParams.depth = HISTORY_DEPTH;
+    igv::EgoMotion ego(egoParams);      // global motion of the last frames
 
     // ==================== CODE ====================
-    // ========== CSI CAMERA PIPELINE ==========
-    // CSI camera pipeline required for the jetson nano
+    // ========== FRAME SOURCE ==========
+    // Default: CSI camera pipeline for the jetson nano (1280x720@60)
+    // Any other source can be given as first argument (see igv/FrameSource.hpp)
+    //      ./13-Motion_Stop synthetic:1280x720@60
     std::cout << std::endl;
     std::cout << "----- IGV::Pipline intialization Start -----" << std::endl;
-    
-    // Video Capture class
-    cv::VideoCapture cap(
-        "nvarguscamerasrc !" // Direct interface to the nvidia hardware (mostly auto setting)
-        "video/x-raw(memory:NVMM), " // NVIDIA multimedia memory
-        // "width=1920, height=1080, frame=60/1 !"
-        "width=1280, height=720, frame=60/1 !"
-        "nvvidconv !" // Uses jetson hardware | much faster for the video converter 
-        "video/x-raw, format=BGRx !" // BGR + unused alpha channel required videoconverter work effiecntly with BGRx
-        "videoconvert !" // CPU-based color fomat converter | Convert BGRx -> BGR | OpenCV expect BGR format
-        "video/x-raw, format=BGR !" // Final format passed to the OpenCV | 3-channel BGR image (CV_8UC3)
-        "appsink ", // Sink element that allows application (OpenCV) to read frames | without appsink, OpenCV cannot access the video stream
-
-        // BACKEND SELECTION
-        cv::CAP_GSTREAMER // Force OpenCV to use the GSTREAMER backend | Mandatory When passing a GSTREAMER pipeline string
-    );
+
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSourceArg(argc, argv);
 
     std::cout << "----- IGV::Camera piline intialize succefully -----" << std::endl;
 
@@ -65,7 +96,7 @@ int main()
     // - GStreamer pipline creation | camera avilability
     // - succefull negotitation of caps (resolution, FPS, Format)
 
-    if(!cap.isOpened()) // If any element in the pipeline fails, this return false 
+    if(!source) // If any element in the pipeline fails, there is no source
     {
         std::cout << "----- IGV::Camera Not Support -----" << std::endl;
         return (EXIT_FAILURE); // Exit program safely
@@ -73,16 +104,20 @@ int main()
 
     std::cout << "----- IGV::Camera Working -----" << std::endl;
 
+    // ========== THREADED CAPTURE ==========
+    // Grabber thread fills a ring of preallocated frames while we process
+    // Camera: motion check always runs on the newest frame (LATEST)
+    igv::CaptureRing ring(*source);
+    ring.start();
+
     // While Loop for video Each Frame Scanning
     std::cout << "----- IGV::Entering while loop -----" << std::endl;
 
     while(true)
     {
-        // Take single frame | camera -> frame
-        cap >> frame;
-
-        // Check if the frame is empty
-        if(frame.empty())
+        // Take single frame | capture ring -> frame (no wait if a frame is ready)
+        // Check if the stream ended
+        if(!ring.read(frame))
         {
             std::cerr << "IGV::ERROR:Empty Frame received!" << std::endl;
             return(EXIT_FAILURE);
@@ -95,13 +130,10 @@ int main()
         *       - Color information is unnecessary
         *       - Faster and more stable
         *   frame -> grayscale
+        *   NV12 / I420 source: gray is the Y plane, no conversion at all
         ***************************************************************/
 
-       cv::cvtColor(
-        frame,              // Input: Origianl BGR image from camera
-        gray,               // Output: Single-cahnnel (Grayscale image)
-        cv::COLOR_BGR2GRAY  // Conversion type: BGR -> Grayscale
-       );
+       cv::Mat luma = igv::lumaView(frame, source->format(), lumaScratch);
 
         /***************************************************************
         *   STEP 2: Gaussian blur (VERY IMPROTANT)   
@@ -112,81 +144,129 @@ int main()
         *   Grayscale -> Guassian Blur
         ***************************************************************/
 
-       cv::GaussianBlur(
-        gray,               // Input: grayscale image
-        gray,               // Output: Same image overwritten (in-place)
-        cv::Size(5, 5),     // 5x5 Guassian kernal
-        0                   // Auto Calulate Sigma
+       // Same pixels as cv::GaussianBlur(luma, gray, cv::Size(5, 5), 0):
+       // 5x5 / gray / 8-bit kernel compiled with its loops unrolled,
+       // picked at run time from the image type (igv/FixedKernels.hpp)
+       // Written straight into the free slot of the frame history
+       igv::gaussianBlur(
+        luma,               // Input: grayscale image (may be the camera buffer)
+        history.next(luma.size(), CV_8UC1), // Output: history slot (never the Y plane)
+        cv::Size(5, 5)      // 5x5 Guassian kernal (sigma from the size)
        );
+       history.push();      // Slot becomes frame t, the oldest frame is dropped
+       gray = history[0];   // Header only, no copy
 
         /***************************************************************
-        *   HANDLE FISRT FRAME 
-        *   We need two frames to detect motion.
-        *   For the first frame:
-        *       - Store it as prevGray
-        *       - Skip motion detction   
+        *   BACKGROUND MODEL
+        *   One pass per pixel:
+        *       - Compare with the learnt background -> binary (0 / 255)
+        *       - Update the background with the frame
+        *   The first frames only build the background (no decision)
         ***************************************************************/
 
-        if(firstFrame)
+        int motionPixels = 0;
+
+        if(MOTION_MODEL != igv::MotionModel::FRAME_DIFF)
         {
-            prevGray = gray.clone(); // Deep copy 
-            firstFrame = false;
-            continue; // go to next frame
+            motionPixels = background.apply(gray, binary);
+            if(!background.ready()) continue;
+        }
+        else
+        {
+            /***************************************************************
+            *   EGO-MOTION
+            *   Global motion frame t-1 -> t from tracked corners
+            *   (the first frame only picks the corners)
+            ***************************************************************/
+
+            if(EGO_MOTION) ego.update(gray);
+
+            /***************************************************************
+            *   HANDLE FISRT FRAME 
+            *   We need two frames to detect motion.
+            *   For the first frame:
+            *       - It is in the history (frame t)
+            *       - Skip motion detction   
+            ***************************************************************/
+
+            if(!history.has(1))
+            {
+                continue; // go to next frame
+            }
+
+            for(int gap : MOTION_GAPS)
+            {
+                // Gaps the history does not hold yet (first frames)
+                if(!history.has(gap)) continue;
+
+                // Earlier frame moved to where the scene is now; out of
+                // time for this frame: the longer gaps are skipped
+                const cv::Mat* reference = &history[gap];
+                if(EGO_MOTION)
+                {
+                    if(!ego.compensate(history[gap], gap, gray, warped)) break;
+                    reference = &warped;
+                }
+
+                /***********************************************************
+                * STEP 3: Absolute Difference (Frame Differenceing)    
+                * absdiff():
+                *   - Computes | Current - frame "gap" back |
+                *   - Highlights regions where motion occurred
+                * 
+                * Result:
+                *   - Black pixels -> No motion
+                *   - Bright Pixels -> Motion
+                * 
+                * Compute absolute differnce between teo images
+                * cv::absdiff(
+                *   InputArray src1, -> first image
+                *   InputArray src2, -> second image
+                *   OutputArray dst  -> output diffenerence image
+                * )
+                ***********************************************************/
+
+                cv::absdiff(
+                    gray,           // Current grayscale frame
+                    *reference,     // Frame "gap" frames back (const view, or warped)
+                    diff            // Output image showing motion areas
+                );
+
+                /***********************************************************
+                * STEP 4: Thershold the difference image
+                * Threshold value: 30
+                * 
+                * Meaning:
+                *   - Pixel difference > 30 -> Motion
+                *   - Pixel difference <= 30 -> Noise
+                * 
+                * Output:
+                *   - binary image (0 or 255)
+                ***********************************************************/
+
+                cv::threshold(
+                    diff,               // Input: Absolute differnence image
+                    gapMask,            // Output: Binary motion mask of this gap
+                    30,                 // Threshold value (Motion sensitivity)
+                    255,                // Value for detected motion pixels
+                    cv::THRESH_BINARY   // Binary thresholding
+                );
+
+                /***********************************************************
+                *   STEP 5: Count motion pixels
+                * 
+                * countNonZero():
+                *   - Count pixels with value != 0
+                *   - In binary image, this equals number of motion pixels 
+                * The largest count of all gaps decides
+                * Display: union of the gap masks
+                ***********************************************************/
+
+                motionPixels = std::max(motionPixels, cv::countNonZero(gapMask));
+                if(gap == MOTION_GAPS[0]) gapMask.copyTo(binary);
+                else cv::bitwise_or(binary, gapMask, binary);
+            }
         }
-
-        /***************************************************************
-        * STEP 3: Absolute Difference (Frame Differenceing)    
-        * absdiff():
-        *   - Computes | Current - previous |
-        *   - Highlights regions where motion occurred
-        * 
-        * Result:
-        *   - Black pixels -> No motion
-        *   - Bright Pixels -> Motion
-        * 
-        * Compute absolute differnce between teo images
-        * cv::absdiff(
-        *   InputArray src1, -> first image
-        *   InputArray src2, -> second image
-        *   OutputArray dst  -> output diffenerence image
-        * )
-        ***************************************************************/
-
-        cv::absdiff(
-            gray,           // Current grayscale frame
-            prevGray,       // Pervious garyscale frame
-            diff            // Output image showing motion areas
-        );
-
-        /***************************************************************
-        * STEP 4: Thershold the difference image
-        * Threshold value: 25
-        * 
-        * Meaning:
-        *   - Pixel difference > 25 -> Motion
-        *   - Pixel difference <= 25 -> Noise
-        * 
-        * Output:
-        *   - binary image (0 or 255)
-        ***************************************************************/
-
-        cv::threshold(
-            diff,               // Input: Absolute differnence image
-            binary,             // Output: Binary motion mask 
-            30,                 // Threshold value (Motion sensitivity)
-            255,                // Value for detected motion pixels
-            cv::THRESH_BINARY   // Binary thresholding
-        );
-
-        /***************************************************************
-        *   STEP 5: Count motion pixels
-        * 
-        * countNonZero():
-        *   - Count pixels with value != 0
-        *   - In binary image, this equals number of motion pixels 
-        ***************************************************************/
-
-        int motionPixels = cv::countNonZero(binary);
 
         /***************************************************************
         * STEP 6: Decide safety status
@@ -209,10 +289,13 @@ int main()
 
         /***************************************************************
         * STEP 7: Display status on video frame
+        * Color conversion happens only here, for the displayed frame
         ***************************************************************/
 
+        igv::toBgr(frame, source->format(), display);
+
         cv::putText(
-            frame,                      // Image to draw on
+            display,                    // Image to draw on
             status,                     // Text
             cv::Point(50, 50),          // Position
             cv::FONT_HERSHEY_SIMPLEX,   // Font
@@ -221,22 +304,25 @@ int main()
             2                           // Thickness
         );
 
+        if(EGO_MOTION && MOTION_MODEL == igv::MotionModel::FRAME_DIFF)
+        {
+            // Stage cost of the compensation, and whether the motion was fitted
+            const igv::EgoTiming& t = ego.timing();
+            const igv::EgoEstimate& e = ego.estimate();
+            char text[96];
+            std::snprintf(text, sizeof(text), "EGO %s %d/%d  %.1f + %.1f ms",
+                          e.valid ? "fit" : (e.held ? "held" : "none"), e.inliers, e.tracked,
+                          t.estimateMs(), t.warpMs);
+            cv::putText(display, text, cv::Point(50, 100), cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 255, 255), 2);
+        }
+
         /***************************************************************
         * DISPLAY WINDOWS
         ***************************************************************/
 
-        cv::imshow("Camera", frame);    // Original view with status
+        cv::imshow("Camera", display);  // Original view with status
         cv::imshow("Motion Mask", binary);  // White = motion
 
-        
-        /***************************************************************
-        * UPDATE PREVIOUS FRAME
-        * Must clone:
-        *   - because gray will be overwritten in next loop
-        ***************************************************************/
-
-        prevGray = gray.clone();
-
         /***************************************************************
         * EXIT CONDITION
         ***************************************************************/
@@ -7,7 +7,8 @@
  *  Description :
  *      - Capture live camera feed
  *      - Performs preprocessing (Grayscale + blur)
- *      - Detects sudden motion for EMERGENCY STOP
+ *      - Detects sudden motion for EMERGENCY STOP (background model),
+ *        on its own thread with a deadline and a watchdog
  *      - Detects path direction using ROI zoning
  *      - Displays decision on live video
  * 
@@ -32,55 +33,129 @@
 #include<opencv2/opencv.hpp>
 #include<iostream>
 #include<cstdlib>
+#include "igv/FrameSource.hpp"
+#include "igv/CaptureRing.hpp"
+#include "igv/FrameLog.hpp"
+#include "igv/SensorRoi.hpp"
+#include "igv/GrayBlurOtsu.hpp"
+#include "igv/BitMask.hpp"
+#include "igv/SafetyStage.hpp"
+
+// Path ROI: rows above this fraction of the sensor height are ignored by the
+// path decision (motion detection still watches the whole frame)
+const double PATH_ROI_TOP = 0.3;
+
+// Emergency stop motion test (igv/BackgroundModel.hpp):
+//      FRAME_DIFF      : |gray - earlier frame| > 25 (MOTION_GAPS below)
+//      RUNNING_AVERAGE : |gray - background| > 25
+//      GAUSSIAN        : |gray - background| > 3 sigma of the pixel
+// A background model absorbs sensor noise / vibration and keeps the whole
+// body of an approaching obstacle, but it needs a still camera: this
+// program has no ego-motion compensation (13-Motion_Stop has), so while
+// the robot drives the whole background would read as motion. Select a
+// background model only for a parked robot watching its path
+const igv::MotionModel MOTION_MODEL = igv::MotionModel::FRAME_DIFF;
+const int MOTION_STOP_PIXELS = 5000;
+
+// Frame difference: current frame against the frames 1, 2 and 4 back, a
+// slow obstacle that stays under 25 between two frames is seen over 2 or 4
+const int MOTION_GAPS[] = { 1, 2, 4 };
+
+// Safety thread (igv/SafetyStage.hpp): the stop decision runs ahead of the
+// path decision and the display, a slow frame or a blocked window cannot
+// hold it back
+//      SAFETY_DEADLINE_MS : capture -> verdict, a later verdict is STOP
+//      SAFETY_WATCHDOG_MS : no verdict for this long (capture stall) -> STOP
+//      SAFETY_RT_PRIORITY : SCHED_FIFO priority, 0 = off (needs root / CAP_SYS_NICE)
+//      SAFETY_CPU         : core the safety thread is pinned to, -1 = off
+const double SAFETY_DEADLINE_MS = 12.0;
+const double SAFETY_WATCHDOG_MS = 50.0;
+const int SAFETY_RT_PRIORITY = 0;
+const int SAFETY_CPU = -1;
 
 // ========================== ENTRY POINT FUNCTION ==========================
-int main()
+int main(int argc, char** argv)
 {
     // ===================== CAMERA INTIALIZATION ====================
-    
+    // Frame source from the command line (see igv/FrameSource.hpp)
+    //      ./14-IGV_Preception                                  -> CSI camera 1280x720@60
+    //      ./14-IGV_Preception synthetic:1280x720@60,fast       -> no camera needed
+    //      ./14-IGV_Preception file:drive.mp4
+    //      ./14-IGV_Preception csi:1280x720@60,nv12             -> luma-only, no CPU videoconvert
+    //      ./14-IGV_Preception csi:1280x720@60 run1.igvlog      -> also record every frame
+    //      ./14-IGV_Preception log:run1.igvlog,fast             -> replay a recording
     std::cout << std::endl << "========== Camera Intitializations ==========" << std::endl;
-    cv::VideoCapture cap(
-        "nvarguscamerasrc !"                // Direct interface to nividia hardware (Mostly auto setting)
-        "video/x-raw(memory:NVMM), "        // NVIDIA Multimedia memory
-        "width=1280, height=720, frame=60/1 !"
-        "nvvidconv !"                        // Uses Jetson hardware | Much faster for video converter
-        "video/x-raw, format=BGRx !"        //  BGR + usused alpha channel required | Video Converter work efficently with BGRx
-        "videoconvert !"                    // CPU-Based color format converter | Convert BGRx -> BGR | OpenCV expects BGR format
-        "video/x-raw, format=BGR !"         // Final format passed to OpenCV | 3-channel BGR image (CV_8UC3)
-        "appsink ",                         // sink element that allows application (OpenCV) to read frames | withour appsink, OpenCV cannot access the videostream
-
-        // BACKEND SELECTION
-        cv::CAP_GSTREAMER // Force OpenCV to Use the GStreamer backend | mandatory when passing a GStreamer pipline string
-    );
-
-    if(!cap.isOpened()) // if any element in the pipeline fails, this return false
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSourceArg(argc, argv);
+
+    if(!source) // if any element in the pipeline fails, there is no source
     {
         std::cout << "========== Camera Not Suported ==========" << std::endl;
         return(EXIT_FAILURE); // Exit program safely
     }
 
+    // ========== THREADED CAPTURE ==========
+    // Capture runs on its own thread, so camera wait and processing overlap
+    // Camera : LATEST mode, the stop decision is always made on the newest frame
+    // Replay : BLOCKING mode, every recorded frame is processed
+    igv::CaptureRing ring(*source);
+
+    // ========== SAFETY THREAD ==========
+    // Only reader of the capture ring: decides every frame first, then its
+    // hand-off thread gives a copy to this loop (skipped when the loop is
+    // still busy). Deadline from the capture time, from the ring read when
+    // replaying a log (recorded times)
+    igv::SafetyParams safetyParams;
+    safetyParams.motion.model = MOTION_MODEL;
+    safetyParams.gaps.assign(std::begin(MOTION_GAPS), std::end(MOTION_GAPS));
+    safetyParams.diffThreshold = 25;
+    safetyParams.stopPixels = MOTION_STOP_PIXELS;
+    safetyParams.deadlineMs = SAFETY_DEADLINE_MS;
+    safetyParams.deadlineFromCapture = !source->recordedTimestamps();
+    safetyParams.watchdogMs = SAFETY_WATCHDOG_MS;
+    safetyParams.realtimePriority = SAFETY_RT_PRIORITY;
+    safetyParams.cpu = SAFETY_CPU;
+    igv::SafetyStage safety(ring, source->format(), safetyParams);
+
+    // ========== OPTIONAL RAW FRAME RECORDING ==========
+    // Second argument: log file. Frames are written by a background thread,
+    // the hand-off thread of the safety stage pays one copy per frame (see
+    // igv/FrameLog.hpp), neither this loop nor the safety thread
+    std::unique_ptr<igv::FrameLogWriter> recorder;
+    if(argc > 2)
+    {
+        recorder.reset(new igv::FrameLogWriter(argv[2]));
+        if(!recorder->isOpened()) return(EXIT_FAILURE);
+        std::cout << "Recording frames to " << argv[2] << std::endl;
+
+        // Every frame passed on after its verdict (hand-off thread)
+        safety.setTap([&](const cv::Mat& f, int64_t stampNs, const igv::SafetyVerdict&) {
+            recorder->write(f, source->format(), stampNs);
+        });
+    }
+
+    ring.start();
+    safety.start();
+
     // ========== IMAGE MATRICES (PIPLINE STAGES) ==========
-    cv::Mat frame;          // Original BGR frame from camera
-    cv::Mat gray;           // Graysacle version of frame 
-    cv::Mat prevGray;       // Privous grayscale frame (for motion detection)
-
-    cv::Mat binary;         // Binary image for path detction
-    cv::Mat roi;            // Region of interest for path detection
-    cv::Mat diff;           // Absolute difference between frames
-    cv::Mat motionMask;     // Binary mask highlighting motion areas
-    
-    // Flag to handle the first frame safely
-    bool firstFrame = true;
+    cv::Mat frame;          // Original frame from camera (BGR, or NV12 in luma-only mode)
+    cv::Mat display;        // BGR image for the display window only
+    cv::Mat lumaScratch;    // YUYV / 16-bit -> gray buffer (unused for BGR / NV12 sources)
+    igv::GrayBlurOtsu pathThreshold(igv::OtsuReuse::video()); // Grayscale + blur + OTSU in one pass
+
+    cv::Mat roi;            // Binary region of interest for path detection
+    bool roiReported = false; // Path ROI printed once
+    igv::BitMask pathMask;  // Binary ROI for path detection, 1 bit per pixel
+    cv::Mat motionView;     // Motion mask of the safety thread, display only
 
     // ========== MAIN PROCESSING LOOP ==========
     while(true)
     {
-        // Capture New Frame
-        // Check if the frame is empty
-        if(!cap.read(frame) || frame.empty())
+        // New frame from the safety thread (its own copy, already decided)
+        // Check if the stream ended
+        if(!safety.waitFrame(frame, motionView))
         {
             std::cerr << "ERROR:Empty Frame recived!" << std::endl;
-            continue;
+            break;
         }
 
         /******************************************************
@@ -89,73 +164,29 @@ int main()
          *      - Apply Gaussian blur to reduce noise
         *******************************************************/
 
-        // Convert BGR image to single-channel grayscale
-        cv::cvtColor(
-            frame,              // Input: Original BGR image from camera
-            gray,               // Output: Single-channel (Grayscale image)
-            cv::COLOR_BGR2GRAY  // Conversion type: BGR -> Grayscale
-        );
-
-        // Apply Guassian Blur (5x5 kernal)
+        // Grayscale + Guassian Blur (5x5 kernal), one pass (GrayBlurOtsu.hpp)
+        //      - BGR source  : rows converted BGR -> Gray inside the blur
+        //      - NV12 source : view of the Y plane (no copy, no conversion)
         // Purpose: 
         //      - Reduce camera noise
         //      - Improve threshold stability
-        //      - Prevent flase motion dection
-        cv::GaussianBlur(
-            gray,               // Input: grayscale image
-            gray,               // Output: Same image overwritten (in-place)
-            cv::Size(5, 5),     // 5x5 Guassian kernal
-            0                   // Auto calculate sigma
-        );
-
-        if (firstFrame)
-        {
-            prevGray = gray.clone();
-            firstFrame = false;
-            continue;
-        }
+        // The OTSU threshold of the blurred image comes with it (histogram
+        // built while blurring), the binary image is only made if needed
+        // Only the path ROI is blurred: the motion check has its own
+        // blurred frame on the safety thread
+        cv::Mat input = (frame.channels() == 3) ? frame : igv::lumaView(frame, source->format(), lumaScratch);
+        igv::SensorRoi pathRoi = igv::pathRoi(*source, input.size(), PATH_ROI_TOP);
+        if(!pathRoi.inFrame.empty()) pathThreshold.blur(input, pathRoi.inFrame);
 
         /******************************************************
-         * STEP 2. EMERGENCY STOP (MOTION DETECTION)
-         *      - Detect sudden scene changes
-         *      - Trigger emergency stop if motion is large
+         * STEP 2. EMERGENCY STOP (SAFETY THREAD VERDICT)
+         *      - Newest verdict, lock-free read
+         *      - STOP on motion, during warm-up, on a missed
+         *        deadline, or when the verdicts stop coming
         ******************************************************/
 
-        bool emergencyStop = false;
-
-        if(!firstFrame)
-        {
-            // Compute absolute pixel-wise difference
-            // Highlight moving regions between frames
-            cv::absdiff(
-                gray,           // Current grayscale frame
-                prevGray,       // Previous grayscale frame 
-                diff            // Output image showing motion areas
-            );
-
-            // Threshold differnce image to create motion mask
-            // diff > 25 -> motion pixel (255)
-            cv::threshold(
-                diff,           // Input: Absolute differnence image
-                motionMask,         // Output: motion mask
-                25,             // Threshold value (motion sesitivity)
-                255,            // Value for detected motion pixels
-                cv::THRESH_BINARY // Binary thresholding
-            );
-
-            // Count motion pixels 
-            int motionPixels = cv::countNonZero(motionMask);
-
-            // If motion exceeds safe threshold -> EMERGENCY STOP
-            if(motionPixels > 5000)
-            {
-                emergencyStop = true;
-            }
-        }
-
-        // Store current frame as previous for next iteration
-        // clone() is mandatory to avoid memory overwrite
-        prevGray = gray.clone();
+        igv::SafetyVerdict verdict = safety.verdict();
+        bool emergencyStop = verdict.stop;
 
         /******************************************************
          * STEP 3. PATH DETECTION (ONLY IF SAFE)
@@ -167,107 +198,76 @@ int main()
 
         std::string direction = "STOP";
 
-        if(!emergencyStop)
+        // No ROI in this frame (shorter than PATH_ROI_TOP): STOP, the frame
+        // is still shown below
+        if(!emergencyStop && !pathRoi.inFrame.empty())
         {
-            // Apply OTSU thresholding for automatic segmentation
-            cv::threshold(
-                gray,           // Input: Grayscale Image
-                binary,         // Output: binary image (0 to 255)
-                0,              // Dummy thershold (OTSU calculates it)
-                255,            // Foregriund pixel value (white)
-                cv::THRESH_BINARY | // Binary therhsolding
-                cv::THRESH_OTSU // Automatic threshold selection
-            );
-
-            // IMAGE DIMENTIONS
-            int h = binary.rows;
-            int w = binary.cols;
-
-            if (binary.empty()) continue;
-
-            // Define ROI as botton half of the image
+            // Define ROI as botton part of the image
             // Reason:
             //      - Path exists near robot, not in sky/background
-            // Take bottom 70% of the frame as ROI
-            int roiStartY = h * 0.3;      // Start at 30% height
-            int roiHeight = h * 0.7;      // Cover 70% of image
-
-            roi = binary(
-                cv::Rect(
-                    0,          // Start from left edge
-                    roiStartY,  // Start from middle of the image vertically
-                    w,          // Use full image width
-                    roiHeight   // Bottom half of the image
-                )
-            );
-
-            if (roi.empty()) continue;
-            
-            // Divide ROI into three equal vertical zones
-            int zoneWidth = w / 3;
-
-            // These zones represents possible navigation directions:
-            // [ LEFT ZONE ] [ CENTER ZONE ] [ RIGHT ZONE ]
-            // The Robot decides direction based on where the path
-            // (White pixels) is strongest.
-            cv::Mat left = roi(
-                cv::Rect(
-                    0,          // x start
-                    0,          // y start
-                    zoneWidth,  // Zone width
-                    roi.rows    // fill ROI height
-                )
+            // Bottom 70% (PATH_ROI_TOP) of the sensor image. With a sensor-side
+            // crop (v4l2mmap:...,crop=bottom70) the frame already is the ROI.
+            //
+            // Apply OTSU thresholding for automatic segmentation, ROI only
+            // (threshold already computed by blur(), only the compare pass left)
+            pathThreshold.binarize(
+                pathMask        // Output: ROI bits (1 = path), the whole blurred ROI
             );
 
-            cv::Mat center = roi(
-                cv::Rect(
-                    zoneWidth,  // x start
-                    0,          // y start
-                    zoneWidth,  // Zone Width
-                    roi.rows    // full ROI height
-                )
-            );
-
-            cv::Mat right = roi(
-                cv::Rect(
-                    2 * zoneWidth, // x start
-                    0,          // y start
-                    zoneWidth,  // Zone Width
-                    roi.rows    // full ROI height
-                )
-            );
-
-            // Count path pixels in each zones
-            int leftCount = cv::countNonZero(left);
-            int centerCount = cv::countNonZero(center);
-            int rightCount = cv::countNonZero(right);
-
-            // Direction decision logic
-            // Priority given to forward movement for stability
-            if(centerCount >= leftCount && centerCount >= rightCount)
+            if(!roiReported)
             {
-                direction = "FORWORD";
+                // Full sensor coordinates: the same with or without sensor crop
+                cv::Rect r = pathRoi.sensorRect();
+                std::cout << "Path ROI (sensor pixels): " << r.width << "x" << r.height
+                          << " at (" << r.x << ", " << r.y << ")" << std::endl;
+                roiReported = true;
             }
-            else if(leftCount > rightCount)
-            {
-                direction = "LEFT";
-            }
-            else
+
+            // Empty mask (zero-width ROI): direction stays STOP
+            if(!pathMask.empty())
             {
-                direction = "RIGHT";
+                // Divide ROI into three equal vertical zones
+                int zoneWidth = pathMask.cols() / 3;
+
+                // These zones represents possible navigation directions:
+                // [ LEFT ZONE ] [ CENTER ZONE ] [ RIGHT ZONE ]
+                // The Robot decides direction based on where the path
+                // (White pixels) is strongest.
+                // Count path pixels in each zones (popcount on the packed ROI)
+                int leftCount = pathMask.count(cv::Rect(0, 0, zoneWidth, pathMask.rows()));
+                int centerCount = pathMask.count(cv::Rect(zoneWidth, 0, zoneWidth, pathMask.rows()));
+                int rightCount = pathMask.count(cv::Rect(2 * zoneWidth, 0, zoneWidth, pathMask.rows()));
+
+                // Direction decision logic
+                // Priority given to forward movement for stability
+                if(centerCount >= leftCount && centerCount >= rightCount)
+                {
+                    direction = "FORWORD";
+                }
+                else if(leftCount > rightCount)
+                {
+                    direction = "LEFT";
+                }
+                else
+                {
+                    direction = "RIGHT";
+                }
             }
 
         }
 
         /******************************************************
          * STEP 4. DISPLAY & VISUALIZATION
+         *      - Color is only needed here (overlay)
         ******************************************************/
 
+        igv::toBgr(frame, source->format(), display);
+
         if(emergencyStop)
         {
             // Display emergency warning in RED
             cv::putText(
-                frame,                      // Image to draw on
+                display,                    // Image to draw on
                 "EMERGENCY STOP",           // Text
                 cv::Point(50, 100),          // Positions
                 cv::FONT_HERSHEY_SIMPLEX,   // Font
@@ -275,12 +275,16 @@ int main()
                 cv::Scalar(0, 0, 255),      // RED Color (BGR)
                 2                           // Thickness
             );
+
+            // Why: motion / warm-up / deadline / watchdog
+            cv::putText(display, igv::verdictReasonName(verdict.reason), cv::Point(50, 150),
+                        cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 0, 255), 2);
         }
         else
         {
             // Dispay navigation decision in GREEN
             cv::putText(
-                frame,                      // Image to draw on
+                display,                    // Image to draw on
                 direction,                  // Text
                 cv::Point(50, 100),          // Position
                 cv::FONT_HERSHEY_SIMPLEX,   // FONT
@@ -291,13 +295,17 @@ int main()
         }
 
         // Shoe Live Camera feed
-        cv::imshow("IGV Camera", frame);
+        cv::imshow("IGV Camera", display);
 
         // show region used for path decision
-        cv::imshow("ROI", roi);
+        // Black until a path was detected (STOP during the safety warm-up)
+        if(!pathMask.empty()) pathMask.toMat(roi);   // 0 / 255, display only
+        else roi = cv::Mat::zeros(pathRoi.inFrame.size(), CV_8UC1);
+        if(!roi.empty()) cv::imshow("ROI", roi);
 
         // Show motion detection mask
-        cv::imshow("Morion Mask", motionMask);
+        // Background mask, or (frame difference) motion share per block
+        if(!motionView.empty()) cv::imshow("Morion Mask", motionView);
 
         // EXIT CONDITION
 
@@ -307,5 +315,23 @@ int main()
         }
     }
 
+    // Safety stage first: its hand-off thread feeds the recorder
+    safety.stop();
+    igv::SafetyStage::Stats ss = safety.stats();
+    std::cout << "Safety: " << ss.frames << " frames decided, " << ss.stops << " STOP, "
+              << ss.deadlineMisses << " deadline misses, " << ss.watchdogTrips << " watchdog trips, "
+              << ss.skipped << " frames not shown, " << ss.notPassedOn << " not passed on" << std::endl;
+
+    if(recorder)
+    {
+        recorder->close();
+        igv::FrameLogWriter::Stats rs = recorder->stats();
+        std::cout << "Recorded " << rs.written << " frames (" << rs.dropped
+                  << " dropped, " << rs.bytes / (1024 * 1024) << " MB)" << std::endl;
+        if(rs.failed) std::cerr << "IGV::ERROR::Recording incomplete (write failed)" << std::endl;
+    }
+
+    pathThreshold.counters().print(std::cout); // Temporal OTSU counters
+
     return(EXIT_SUCCESS);
 }
\ No newline at end of file
@@ -8,7 +8,7 @@
  *  - Capture Live Camera feed
  *  - Converts image into a binary representation
  *  - Extaracts bottom-half Region of Interest (ROI)
- *  - Divides ROI into a grid (occupancy map) 
+ *  - Divides ROI into a grid (occupancy map, ROWSxCOLS argument)
  *  - Classifies each grid cell as:
  *          0 = Unknown
  *          1 = Free
@@ -32,183 +32,177 @@
 #include<opencv2/opencv.hpp>
 #include<iostream>
 #include<cstdlib>
+#include "igv/FrameSource.hpp"
+#include "igv/CaptureRing.hpp"
+#include "igv/SensorRoi.hpp"
+#include "igv/GrayBlurOtsu.hpp"
+#include "igv/BitMask.hpp"
+#include "igv/IntegralCount.hpp"
 
 // ========== OCCUPANCY MAP CONFIGRATION ==========
-// Number of rows and columns in the occupancy grid
-// This defines the resolution of the map
+// Default number of rows and columns in the occupancy grid
+// This defines the resolution of the map (2nd argument: ROWSxCOLS)
 const int MAP_ROWS = 9*3;
 const int MAP_COLS = 16*3;
 
-// Occupancy map storage
-// 0 = unkown
-// 1 = free space
-// 2 = obstacle
-int occupancyMap[MAP_ROWS][MAP_COLS] = {0};
+// Path ROI: rows above this fraction of the sensor height are not processed
+const double PATH_ROI_TOP = 0.3;
 
 // =========================== ENTRY POINT FUNTION ==========================
-int main()
+int main(int argc, char** argv)
 {
     // ==================== CAMERA INTIALIZATION ====================
     std::cout << std::endl << "========== CAMERA INTIALIZATIONS ==========" << std::endl;
     
-    cv::VideoCapture cap(
-        "nvarguscamerasrc !"
-        "video/x-raw(memory:NVMM), "
-        "width=1280, height=720, frame=60/1 !"
-        "nvvidconv !"
-        "video/x-raw, format=BGRx !"
-        "videoconvert !"
-        "video/x-raw, format=BGR !"
-        "appsink",
-        cv::CAP_GSTREAMER
-    );
-
-    if(!cap.isOpened())
+    // Arguments: frame source (igv/FrameSource.hpp), grid ROWSxCOLS
+    //      ./15-ROI_to_map csi:1280x720@60 90x160
+    igv::Grid grid{ MAP_ROWS, MAP_COLS };
+    if(argc > 2 && !igv::parseGrid(argv[2], grid))
+    {
+        std::cerr << "IGV::ERROR::Grid must be ROWSxCOLS, e.g. 27x48" << std::endl;
+        return(EXIT_FAILURE);
+    }
+
+    // Occupancy map storage, row-major (occupancyMap[r * grid.cols + c])
+    // 0 = unkown
+    // 1 = free space
+    // 2 = obstacle
+    std::vector<int> occupancyMap(grid.cells(), 0);
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSourceArg(argc, argv);
+
+    if(!source)
     {
         std::cout << "========== CAMERA NOT SUPPORTED ==========" << std::endl;
         return(EXIT_FAILURE);
     }
 
+    // ==================== THREADED CAPTURE ====================
+    // Grabber thread + frame ring (igv/CaptureRing.hpp)
+    igv::CaptureRing ring(*source);
+    ring.start();
+
     // ==================== IMAGE MATRICES (PROCESSING STAGES) ====================
-    cv::Mat frame;  // Original camera frame (BGR)
-    cv::Mat gray;   // Grayscale image
-    cv::Mat binary; // Binary image
-    cv::Mat roi;    // Region of Interest (bottom half)
+    cv::Mat frame;  // Original camera frame (BGR, or NV12 in luma-only mode)
+    cv::Mat display;// BGR image for the display window only
+    cv::Mat lumaScratch; // YUYV / 16-bit -> gray buffer (unused for BGR / NV12 sources)
+    igv::GrayBlurOtsu pathThreshold(igv::OtsuReuse::video()); // Grayscale + blur + OTSU
+    cv::Mat roi;    // Binary Region of Interest (bottom of the frame), display only
+    igv::BitMask pathMask; // Binary ROI, 1 bit per pixel
+    igv::IntegralCount pathCount; // Summed-area table of pathMask (what the cells count)
+    bool roiReported = false;
 
     // ==================== MAIN LOOP ====================
     while(true)
     {
-        if(!cap.read(frame) || frame.empty())
+        if(!ring.read(frame))
         {
             std::cerr << "ERROR:Empty Frame recived!" << std::endl;
-            continue;
+            break;
         }
 
-        /* ========== PREPROCESSING ==========
-            Convert BGR image to grayscale
-            Purpose: 
-                - Reduce data from 3 channels to 1
-                - Simplify further processing
+        /* ========== ROI SECTION (BEFORE PREPROCESSING) ==========
+            Define ROI as the bottom Image
+            Resson:
+                - Obstacles and free path are close to the robot
+                - Upper half usually contains irrelevent information
+            Chosen first so that the top of the frame is never processed
         */
 
-        cv::cvtColor(
-            frame, 
-            gray,
-            cv::COLOR_BGR2GRAY
-        );
+        // Start at PATH_ROI_TOP of the sensor image, cover the rest.
+        // With a sensor-side crop (v4l2mmap:...,crop=bottom70) the frame
+        // already is this region and the ROI is the whole frame.
+        cv::Mat input = (frame.channels() == 3) ? frame : igv::lumaView(frame, source->format(), lumaScratch);
+        igv::SensorRoi pathRoi = igv::pathRoi(*source, input.size(), PATH_ROI_TOP);
 
-        /*
-            Apply guassian blur
-            Purpose:
+        /* ========== PREPROCESSING ==========
+            Grayscale -> Guassian blur (5x5) -> OTSU, fused (GrayBlurOtsu.hpp)
+            Purpose: 
+                - Reduce data from 3 channels to 1
                 - Reduce camera noise
                 - Improve thresholding stability
-        */
-       
-        cv::GaussianBlur(
-            gray,
-            gray, 
-            cv::Size(5, 5), 
-            0
-        );
-
-        /*
-            Convert grayscale image to binary using OTSU
-            Purpose:    
                 - Automatically separate forground and background
+            Only the ROI is processed (the 2 rows above it are read as blur
+            neighbours), and the OTSU threshold comes from the ROI pixels
+            BGR source: rows converted to gray inside the blur (no gray image)
+            NV12 / I420 source: blurs a view of the Y plane (no conversion)
         */
 
-        cv::threshold(
-            gray, 
-            binary, 
-            0, 
-            255, 
-            cv::THRESH_BINARY | cv::THRESH_OTSU
-        );
-
-        // ========== ROI SECTION ==========
-        // Image dimentions
-        int h = binary.rows;
-        int w = binary.cols;
-
-        if(binary.empty()) continue;
-
-        /* 
-            Define ROI as the bottom Image
-            Resson:
-                - Obstacles and free path are close to the robot
-                - Upper half usually contains irrelevent information
-        */
-
-        int roiStartY = h * 0.3; // Start at 30% image
-        int roiHeight = h * 0.7; // Cover 70% of image
-
-        roi = binary(
-            cv::Rect(
-                0,          
-                roiStartY,
-                w, 
-                roiHeight  
-            )
-        );
+        // No ROI in this frame (shorter than PATH_ROI_TOP): no bits, the map
+        // keeps its cells and everything is still shown
+        if(!pathRoi.inFrame.empty())
+        {
+            pathThreshold.blur(input, pathRoi.inFrame);
+            pathThreshold.binarize(pathMask);   // ROI bits
+        }
+        else pathMask.create(0, 0);
+        pathCount.build(pathMask);          // One table, then every cell is O(1)
 
-        if(roi.empty()) continue; 
+        if(!roiReported && !pathMask.empty())
+        {
+            // Full sensor coordinates: the same with or without sensor crop
+            cv::Rect r = pathRoi.sensorRect();
+            std::cout << "Path ROI (sensor pixels): " << r.width << "x" << r.height
+                      << " at (" << r.x << ", " << r.y << ")" << std::endl;
+            roiReported = true;
+        }
 
         // ========== GRID CELL SIZE CALCULATION ==========
-        // Convert ROI into MAP_ROWS x MAP_COLS grid
-        int cellwidth = roi.cols / MAP_COLS;
-        int cellHeight = roi.rows / MAP_ROWS;
+        // Convert ROI into grid.rows x grid.cols cells
+        // (ROI size / grid, rounded down: igv::Grid::cell)
         
         // ========== OCCUPANCY MAP UPDATE ==========
         // Loop over each cell in the occupancy grid
-        for(int r = 0; r < MAP_ROWS; r++)
+        // Empty mask (no ROI this frame): the cells keep their state
+        if(!pathMask.empty())
         {
-            for (int c = 0; c < MAP_COLS; c++)
+            for(int r = 0; r < grid.rows; r++)
             {
-                // Compute pixel coordinates of the cell
-                int x = c * cellwidth;
-                int y = r * cellHeight;
-
-                // Extract cell ROI
-                cv::Rect cellRect(x, y, cellwidth, cellHeight);
-                cv::Mat cell = roi(cellRect);
-
-                // Count number of white pixels int he cell
-                int whitePixels = cv::countNonZero(cell);
-
-                // Total number of pixels in the cell
-                int totalPixels = cell.rows * cell.cols;
-
-                // Classification logic:
-                // If majority of pixels are white -> free space
-                // otherwise -> obstacle
-                if(whitePixels > totalPixels / 2)
+                for (int c = 0; c < grid.cols; c++)
                 {
-                    occupancyMap[r][c] = 1; // free
-                }
-                else
-                {
-                    occupancyMap[r][c] = 2; // obstacle
+                    // Cell ROI
+                    cv::Rect cellRect = grid.cell(pathCount.size(), r, c);
+
+                    // Count number of white pixels int he cell (4 table reads)
+                    int whitePixels = pathCount.count(cellRect);
+
+                    // Total number of pixels in the cell
+                    int totalPixels = cellRect.area();
+
+                    // Classification logic:
+                    // If majority of pixels are white -> free space
+                    // otherwise -> obstacle
+                    if(whitePixels > totalPixels / 2)
+                    {
+                        occupancyMap[r * grid.cols + c] = 1; // free
+                    }
+                    else
+                    {
+                        occupancyMap[r * grid.cols + c] = 2; // obstacle
+                    }
                 }
             }
         }
 
         // ========== OCCUPANCY MAP VISUALIZATION ==========
         // Create visualization image
-        // Each grid cell is drawn as a 30x30 square
-        cv::Mat mapVis(MAP_ROWS * 30, MAP_COLS * 30, CV_8UC3);
+        // Each grid cell is drawn as a square of up to 30x30
+        // (smaller squares for fine grids, the window stays on screen)
+        const int cellSize = std::max(4, std::min(30, 1440 / grid.cols));
+        cv::Mat mapVis(grid.rows * cellSize, grid.cols * cellSize, CV_8UC3);
 
-        for(int r = 0; r < MAP_ROWS; r++)
+        for(int r = 0; r < grid.rows; r++)
         {
-            for(int c = 0; c < MAP_COLS; c++)
+            for(int c = 0; c < grid.cols; c++)
             {
                 cv::Scalar color;
+                int state = occupancyMap[r * grid.cols + c];
 
                 // Assign color based on occupancy state
-                if(occupancyMap[r][c] == 0)
+                if(state == 0)
                 {
                     color = cv::Scalar(128, 128, 128); // unkonn (gray)
                 }
-                else if(occupancyMap[r][c] == 1)
+                else if(state == 1)
                 {
                     color = cv::Scalar(255, 255, 255); // Free (White)
                 }
@@ -220,7 +214,7 @@ int main()
                 // Draw filled rectangle for each grid cell
                 cv::rectangle(
                     mapVis, 
-                    cv::Rect(c * 30, r * 30, 30, 30), 
+                    cv::Rect(c * cellSize, r * cellSize, cellSize, cellSize), 
                     color, 
                     cv::FILLED
                 );
@@ -228,8 +222,10 @@ int main()
         }
 
         // ========== DISPLAY OUTPUTS ==========
-        cv::imshow("camera", frame);    // Origianl camera feed
-        cv::imshow("ROI", roi);         // Bottom-half region
+        igv::toBgr(frame, source->format(), display); // Color only for display
+        cv::imshow("camera", display);  // Origianl camera feed
+        if(!pathMask.empty()) pathMask.toMat(roi); // 0 / 255 image, display only
+        if(!roi.empty()) cv::imshow("ROI", roi); // Bottom-half region
         cv::imshow("occupancy Map", mapVis); // Grid-based map
 
         // ========== EXIT CONDITION ==========
@@ -239,5 +235,8 @@ int main()
         }
         //// END OF WHILE LOOP ////
     }
+
+    pathThreshold.counters().print(std::cout); // Temporal OTSU counters
+
     return(EXIT_SUCCESS);
 } 
\ No newline at end of file
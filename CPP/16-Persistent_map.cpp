@@ -15,7 +15,7 @@
  *      - Capture live camera feed
  *      - Convertes image to binary using OTSU thresholding
  *      - Extracts bottom-half Region of Interest (ROI)
- *      - Divides ROI into a fixed grid (MAP_ROWS x MAP_COLS)
+ *      - Divides ROI into a grid (MAP_ROWS x MAP_COLS, or ROWSxCOLS argument)
  *      - Classifies each grid cell as FREE or OBSTACLE
  *      - Maintains a PERSISTENT occupancy map across frames
  * 
@@ -39,198 +39,193 @@
 #include<opencv2/opencv.hpp>
 #include<iostream>
 #include<cstdlib>
+#include "igv/FrameSource.hpp"
+#include "igv/CaptureRing.hpp"
+#include "igv/SensorRoi.hpp"
+#include "igv/GrayBlurOtsu.hpp"
+#include "igv/BitMask.hpp"
+#include "igv/IntegralCount.hpp"
 
 // ========== OCCUPANCY GRID CONFIGRATION ==========
-// Grid resolution (map size)
+// Default grid resolution (map size), 2nd argument overrides it
 const int MAP_ROWS = 10;
 const int MAP_COLS = 20; 
 
-// Presistent occupancy grid
-// Initialized to unkonwn (0)
-int occupancyMap[MAP_ROWS][MAP_COLS] = {0};
+// Path ROI: rows above this fraction of the sensor height are not processed
+const double PATH_ROI_TOP = 0.3;
 
-int main()
+int main(int argc, char** argv)
 {
     // ==================== CAMERA INITIALIZATIONS ====================
     // Open default camera (index 0)
     std::cout << std::endl << "========== CAMERA INTIALIZATIONS ==========" << std::endl;
     
-    cv::VideoCapture cap(
-        "nvarguscamerasrc !"
-        "video/x-raw(memory:NVMM), "
-        "width=1280, height=720, frame=60/1 !"
-        "nvvidconv !"
-        "video/x-raw, format=BGRx !"
-        "videoconvert !"
-        "video/x-raw, format=BGR !"
-        "appsink",
-        cv::CAP_GSTREAMER
-    );
-
-    if(!cap.isOpened())
+    // Arguments: frame source (igv/FrameSource.hpp), grid ROWSxCOLS
+    //      ./16-Persistent_map csi:1280x720@60 45x80
+    igv::Grid grid{ MAP_ROWS, MAP_COLS };
+    if(argc > 2 && !igv::parseGrid(argv[2], grid))
+    {
+        std::cerr << "IGV::ERROR::Grid must be ROWSxCOLS, e.g. 10x20" << std::endl;
+        return(EXIT_FAILURE);
+    }
+
+    // Presistent occupancy grid, row-major (occupancyMap[r * grid.cols + c])
+    // Initialized to unkonwn (0)
+    std::vector<int> occupancyMap(grid.cells(), 0);
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSourceArg(argc, argv);
+
+    if(!source)
     {
         std::cout << "========== CAMERA NOT SOPPORTED ==========" << std::endl;
         return(EXIT_FAILURE);
     }
 
+    // ==================== THREADED CAPTURE ====================
+    // Grabber thread + frame ring (igv/CaptureRing.hpp)
+    igv::CaptureRing ring(*source);
+    ring.start();
+
     // ==================== IMAGE CONTAINERS ====================
-    cv::Mat frame;  // Original BGR camera frame 
-    cv::Mat gray;   // Grayscale image
-    cv::Mat binary; // Binary image after thresholding 
-    cv::Mat roi;    // Bottom-hlaf Region of Interest
+    cv::Mat frame;  // Original camera frame (BGR, or NV12 in luma-only mode)
+    cv::Mat display;// BGR image for the display window only
+    cv::Mat lumaScratch; // YUYV / 16-bit -> gray buffer (unused for BGR / NV12 sources)
+    igv::GrayBlurOtsu pathThreshold(igv::OtsuReuse::video()); // Grayscale + blur + OTSU
+    cv::Mat roi;    // Binary Region of Interest (bottom of the frame), display only
+    igv::BitMask pathMask; // Binary ROI, 1 bit per pixel
+    igv::IntegralCount pathCount; // Summed-area table of pathMask (what the cells count)
+    bool roiReported = false;
 
     // ==================== MAIN PROCESSING LOOP ====================
     while(true)
     {
-        // Capture frame | Stope execution from the camera
-        if(!cap.read(frame) || frame.empty())
+        // Capture frame | Newest frame from the capture ring
+        if(!ring.read(frame))
         {
             std::cerr << "ERROR:Empty Frame Recived!" <<std::endl;
+            break;
         }
 
-        // ========== PREPROCESSING ==========
-        // Convert BGR image to grayscale
-        // Reduce data size and simplifies processing
-        cv::cvtColor(
-            frame, 
-            gray, 
-            cv::COLOR_BGR2GRAY
-        );
-
-        // Apply Gussian blur
-        // Purpuise:
-        //      - Reduce sensor noise
-        //      - Stablize thresholding
-        cv::GaussianBlur(
-            gray, 
-            gray, 
-            cv::Size(5, 5), 
-            0
-        );
-
-        // Apply OTSU thresholding
-        // Automatically seperated foreground and bakground
-        cv::threshold(
-            gray,
-            binary, 
-            50,
-            255, 
-            cv::THRESH_BINARY | cv::THRESH_OTSU
-        );
-
-        // ========== ROI SELECTION (BOTTOM HALF) ==========
-        // Image dimentions 
-        int h = binary.rows;
-        int w = binary.cols;
-
-        if(binary.empty()) continue;
-
-        // Use only the bottom hlaf of the image 
+        // ========== ROI SELECTION (BEFORE PREPROCESSING) ==========
+        // Use only the bottom of the image 
         // Reson:
         //  - Obstacle re;vent to navigation are near the rorbot
-        //  - Upper half contains irrelevant beackground
-        int roiStartY = h * 0.3; // Start at 30% image
-        int roiHeight = h * 0.7; // Cover 70% of image
-
-        roi = binary(
-            cv::Rect(
-                0, 
-                roiStartY, 
-                w, 
-                roiHeight
-            )
-        );
+        //  - Upper part contains irrelevant beackground
+        //  - Start at PATH_ROI_TOP of the sensor image, cover the rest
+        //    (the whole frame when the sensor crops: crop=bottom70)
+        cv::Mat input = (frame.channels() == 3) ? frame : igv::lumaView(frame, source->format(), lumaScratch);
+        igv::SensorRoi pathRoi = igv::pathRoi(*source, input.size(), PATH_ROI_TOP);
+
+        // ========== PREPROCESSING ==========
+        // Grayscale -> Gussian blur (5x5) -> OTSU thresholding, one pass,
+        // on the ROI only (threshold from the ROI pixels)
+        // Purpuise:
+        //      - Reduce data size and simplifies processing
+        //      - Reduce sensor noise, stablize thresholding
+        //      - Automatically seperated foreground and bakground
+        // BGR source: converted row by row inside the blur (GrayBlurOtsu.hpp)
+        // NV12 / I420 source: blurs a view of the Y plane (no conversion)
+        // No ROI in this frame (shorter than PATH_ROI_TOP): no bits, the map
+        // keeps its cells and everything is still shown
+        if(!pathRoi.inFrame.empty())
+        {
+            pathThreshold.blur(input, pathRoi.inFrame);
+            pathThreshold.binarize(pathMask);   // ROI bits
+        }
+        else pathMask.create(0, 0);
+        pathCount.build(pathMask);          // One table, then every cell is O(1)
 
-        if(roi.empty()) continue;
+        if(!roiReported && !pathMask.empty())
+        {
+            // Full sensor coordinates: the same with or without sensor crop
+            cv::Rect r = pathRoi.sensorRect();
+            std::cout << "Path ROI (sensor pixels): " << r.width << "x" << r.height
+                      << " at (" << r.x << ", " << r.y << ")" << std::endl;
+            roiReported = true;
+        }
 
         // ========== GRID CELL SIZE COMPUTATION ==========
-        // Each ROI is divided into MAP_ROWS / MAP_COLS cells
-        int cellWidth = roi.cols / MAP_COLS;
-        int cellHeight = roi.rows / MAP_ROWS;
+        // Each ROI is divided into grid.rows / grid.cols cells
+        // (ROI size / grid, rounded down: igv::Grid::cell)
 
         // ========== UPDATE OCCUPANCY MAP (PERSISTENT LOGIC) ==========
 
-        for(int r = 0; r < MAP_ROWS; r++)
+        // Empty mask (no ROI this frame): the cells keep their state
+        if(!pathMask.empty())
         {
-            for(int c = 0; c < MAP_COLS; c++)
+            for(int r = 0; r < grid.rows; r++)
             {
-                // Compute top-left pixel of the current cell
-                int x = c * cellWidth;
-                int y = r * cellHeight;
-
-                // Extract the cell as a sub_ROI (Zero-copy)
-                cv::Mat cell = roi(
-                    cv::Rect(
-                        x, 
-                        y, 
-                        cellWidth, 
-                        cellHeight
-                    )
-                );
-
-                // Count number of whte pixels (forground)
-                int whitePixels = cv::countNonZero(cell);
-
-                // Total number of pixels in this cell
-                int totalPixels = cell.rows * cell.cols;
-
-                // observation from current frame:
-                //      - Majority white -> FREE
-                //      - Otherwise -> OBSTACLE
-                int observedState = (whitePixels > totalPixels / 2) ? 1 : 2;
-
-                /************************************************
-                 * PERSISTENT UPDATE RULES
-                 * 
-                 * 1. If cell is UNKONWN -> accept observation
-                 * 2. If cell was FREE but now OBSTACLE -> Update
-                 * 3. If cell already OBSTACLE -> keep it
-                 * 
-                 * This ensures obstacles persist across frames
-                *************************************************/
-               
-                if(occupancyMap[r][c] == 0)
+                for(int c = 0; c < grid.cols; c++)
                 {
-                    occupancyMap[r][c] = observedState;
-                }
-                else if(occupancyMap[r][c] == 1 && observedState == 2)
-                {
-                    occupancyMap[r][c] = 2;
+                    // The cell as a rectangle of the ROI
+                    cv::Rect cell = grid.cell(pathCount.size(), r, c);
+
+                    // Count number of whte pixels (forground), 4 table reads
+                    int whitePixels = pathCount.count(cell);
+
+                    // Total number of pixels in this cell
+                    int totalPixels = cell.area();
+
+                    // observation from current frame:
+                    //      - Majority white -> FREE
+                    //      - Otherwise -> OBSTACLE
+                    int observedState = (whitePixels > totalPixels / 2) ? 1 : 2;
+
+                    /************************************************
+                     * PERSISTENT UPDATE RULES
+                     * 
+                     * 1. If cell is UNKONWN -> accept observation
+                     * 2. If cell was FREE but now OBSTACLE -> Update
+                     * 3. If cell already OBSTACLE -> keep it
+                     * 
+                     * This ensures obstacles persist across frames
+                    *************************************************/
+               
+                    int& state = occupancyMap[r * grid.cols + c];
+                    if(state == 0)
+                    {
+                        state = observedState;
+                    }
+                    else if(state == 1 && observedState == 2)
+                    {
+                        state = 2;
+                    }
+                    // If already obstacle, do nothing
                 }
-                // If already obstacle, do nothing
             }
         }
 
         // ========== VISIALIZATION OF OCCUPANCY MAP ==========
         // Create visualization image 
-        // Each grid cell is drawn as 30x30 square
+        // Each grid cell is drawn as square of up to 40x40
+        // (smaller for fine grids, the window stays on screen)
 
-        int CELL_SIZE = 40;
+        int CELL_SIZE = std::max(4, std::min(40, 1440 / grid.cols));
 
         cv::Mat mapVis(
-            MAP_ROWS * CELL_SIZE,
-            MAP_COLS * CELL_SIZE,
+            grid.rows * CELL_SIZE,
+            grid.cols * CELL_SIZE,
             CV_8UC3
         );
 
         mapVis.setTo(cv::Scalar(50, 50, 50));
         // cv::Mat mapVis(MAP_ROWS * 30, MAP_COLS * 30, CV_8UC3);
 
-        for (int r = 0; r < MAP_ROWS; r++)
+        for (int r = 0; r < grid.rows; r++)
         {
-            for (int c = 0; c < MAP_COLS; c++)
+            for (int c = 0; c < grid.cols; c++)
             {
                 cv::Scalar color;
+                int state = occupancyMap[r * grid.cols + c];
 
                 // Color Coding
                 // - Gray -> unkonwn
                 // - White -> Free space
                 // - Black -> Obstacle
-                if(occupancyMap[r][c] == 0)
+                if(state == 0)
                 {
                     color = cv::Scalar(128, 128, 128);
                 }
-                else if(occupancyMap[r][c] == 1)
+                else if(state == 1)
                 {
                     color = cv::Scalar(255, 255, 255);
                 }
@@ -260,13 +255,17 @@ int main()
         }
 
         // DISPLAY WINDOWS
-        cv::imshow("Camera", frame);    // Original camera feed
-        cv::imshow("ROI", roi);         // Processed region
+        igv::toBgr(frame, source->format(), display); // Color only for display
+        cv::imshow("Camera", display);  // Original camera feed
+        if(!pathMask.empty()) pathMask.toMat(roi); // 0 / 255 image, display only
+        if(!roi.empty()) cv::imshow("ROI", roi); // Processed region
         cv::imshow("Persistent Map", mapVis); // Occupancy grid
 
         // EXIT CONDITION
         if(cv::waitKey(1) == 27) break;// ESC key
     }
 
+    pathThreshold.counters().print(std::cout); // Temporal OTSU counters
+
     return(EXIT_SUCCESS);
 }
\ No newline at end of file
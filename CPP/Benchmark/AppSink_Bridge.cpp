@@ -0,0 +1,151 @@
+/*****************************************************************************************
+ *  File Name   : AppSink_Bridge.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV, GStreamer
+ *
+ *  Description :
+ *      Checks and times the zero-copy appsink reader (igv/GstAppSink.hpp)
+ *      against cv::VideoCapture(CAP_GSTREAMER), no camera needed.
+ *
+ *      1. Same pipeline read by both: frames must be identical
+ *      2. Time per read() (the copy cv::VideoCapture does is the difference)
+ *      3. Buffer lifetime: frames held across later reads must not change,
+ *         and every mapping must be released once the Mats are gone
+ *
+ *      Default pipeline: videotestsrc 1920x1080 BGR (the 10-Object_Tracking
+ *      resolution). Any pipeline ending in an appsink can be passed, e.g.
+ *          "filesrc location=drive.mp4 ! decodebin ! videoconvert ! video/x-raw,format=BGR ! appsink"
+ *
+ *  Usage       : ./build.sh Benchmark/AppSink_Bridge ["<pipeline>"] [frames]
+ *                (needs the gstreamer-app-1.0 / gstreamer-video-1.0 dev packages)
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+#ifndef IGV_WITH_GSTREAMER
+#error "Build with -DIGV_WITH_GSTREAMER (build.sh adds it when gstreamer-app-1.0 is installed)"
+#endif
+#include "../igv/GstAppSink.hpp"
+
+// Cheap content fingerprint (sum of every 7th byte of every row)
+static uint64_t fingerprint(const cv::Mat& m)
+{
+    uint64_t sum = 0;
+    const size_t rowBytes = m.cols * m.elemSize();
+    for(int y = 0; y < m.rows; y++)
+    {
+        const uchar* row = m.ptr<uchar>(y);
+        for(size_t x = 0; x < rowBytes; x += 7) sum = sum * 31 + row[x];
+    }
+    return sum;
+}
+
+int main(int argc, char** argv)
+{
+    int frames = (argc > 2) ? std::atoi(argv[2]) : 600;
+    std::string pipeline = (argc > 1) ? argv[1] :
+        "videotestsrc pattern=ball num-buffers=" + std::to_string(frames) + " ! "
+        "video/x-raw, format=BGR, width=1920, height=1080, framerate=60/1 ! "
+        "appsink sync=false";
+
+    std::cout << "========== APPSINK BRIDGE BENCHMARK ==========" << std::endl;
+    std::cout << "Pipeline: " << pipeline << std::endl;
+
+    // ==================== 1 + 2: cv::VideoCapture ====================
+    std::vector<uint64_t> reference;
+    double capMs = 0;
+    {
+        cv::VideoCapture cap(pipeline, cv::CAP_GSTREAMER);
+        if(!cap.isOpened())
+        {
+            std::cerr << "IGV::ERROR::cv::VideoCapture cannot open the pipeline" << std::endl;
+            return(EXIT_FAILURE);
+        }
+
+        cv::Mat frame;
+        cv::TickMeter tm;
+        while((int)reference.size() < frames)
+        {
+            tm.start();
+            bool ok = cap.read(frame);
+            tm.stop();
+            if(!ok || frame.empty()) break;
+            reference.push_back(fingerprint(frame));
+        }
+        capMs = tm.getTimeMilli() / std::max<size_t>(reference.size(), 1);
+    }
+
+    // ==================== 1 + 2: native appsink ====================
+    size_t mismatches = 0;
+    size_t count = 0;
+    double nativeMs = 0;
+    uint64_t copied = 0;
+    {
+        igv::GstAppSinkReader reader(pipeline);
+        if(!reader.isOpened())
+        {
+            std::cerr << "IGV::ERROR::Native appsink reader cannot open the pipeline" << std::endl;
+            return(EXIT_FAILURE);
+        }
+
+        cv::Mat frame;
+        cv::TickMeter tm;
+        while((int)count < frames)
+        {
+            tm.start();
+            bool ok = reader.read(frame);
+            tm.stop();
+            if(!ok) break;
+            if(count < reference.size() && fingerprint(frame) != reference[count]) mismatches++;
+            count++;
+        }
+        nativeMs = tm.getTimeMilli() / std::max<size_t>(count, 1);
+        copied = reader.framesCopied();
+    }
+
+    // ==================== 3: BUFFER LIFETIME ====================
+    // Hold the last few frames (like the capture ring does) while reading on
+    size_t corrupted = 0;
+    int liveWhileHolding = 0;
+    {
+        igv::GstAppSinkReader reader(pipeline);
+        std::deque<std::pair<cv::Mat, uint64_t>> held;
+        cv::Mat frame;
+        for(int i = 0; i < frames && reader.read(frame); i++)
+        {
+            held.emplace_back(frame, fingerprint(frame));
+            frame.release();
+            if(held.size() > 3)
+            {
+                if(fingerprint(held.front().first) != held.front().second) corrupted++;
+                held.pop_front();
+            }
+        }
+        liveWhileHolding = igv::borrowedMatCount();
+    }
+    int liveAfter = igv::borrowedMatCount();
+
+    // ==================== REPORT ====================
+    std::cout << "Frames compared            : " << std::min(count, reference.size()) << std::endl;
+    std::cout << "Content mismatches         : " << mismatches << std::endl;
+    std::cout << "Frames copied (padded)     : " << copied << std::endl;
+    std::cout << "cv::VideoCapture read()    : " << capMs << " ms/frame" << std::endl;
+    std::cout << "Native appsink read()      : " << nativeMs << " ms/frame" << std::endl;
+    std::cout << "Held frames changed        : " << corrupted << std::endl;
+    std::cout << "Mappings while holding 3   : " << liveWhileHolding << std::endl;
+    std::cout << "Mappings after release     : " << liveAfter << std::endl;
+
+    bool ok = (mismatches == 0 && corrupted == 0 && liveAfter == 0);
+    std::cout << (ok ? "IGV::APPSINK BRIDGE OK" : "IGV::ERROR::APPSINK BRIDGE FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
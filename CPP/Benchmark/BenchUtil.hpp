@@ -0,0 +1,51 @@
+/*****************************************************************************************
+ *  File Name   : BenchUtil.hpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Helpers shared by the benchmarks:
+ *
+ *          timeIt(n, fn)    average time of fn in ms (one warm-up call first)
+ *          maxDiff(a, b)    largest per-channel |a - b| (huge for size / type mismatch)
+ *          sameImage(a, b)  a and b identical
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+#ifndef IGV_BENCH_UTIL_HPP
+#define IGV_BENCH_UTIL_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <functional>
+
+// Average time of "fn" in ms
+inline double timeIt(int iterations, const std::function<void()>& fn)
+{
+    fn();                                           // Warm up (allocations)
+    cv::TickMeter tm;
+    tm.start();
+    for(int i = 0; i < iterations; i++) fn();
+    tm.stop();
+    return tm.getTimeMilli() / iterations;
+}
+
+inline double maxDiff(const cv::Mat& a, const cv::Mat& b)
+{
+    if(a.size() != b.size() || a.type() != b.type()) return 1e9;
+    cv::Mat d;
+    cv::absdiff(a, b, d);
+    double mx = 0;
+    cv::minMaxLoc(d.reshape(1), nullptr, &mx);
+    return mx;
+}
+
+inline bool sameImage(const cv::Mat& a, const cv::Mat& b)
+{
+    return maxDiff(a, b) == 0;
+}
+
+#endif // IGV_BENCH_UTIL_HPP
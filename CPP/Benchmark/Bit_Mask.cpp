@@ -0,0 +1,189 @@
+/*****************************************************************************************
+ *  File Name   : Bit_Mask.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Bit-packed masks (igv/BitMask.hpp) against 0 / 255 cv::Mat masks for
+ *      what the programs do with them, on the bottom 70 % ROI of 1280x720 and
+ *      1920x1080 frames:
+ *
+ *          path      : threshold, then the 3 zones of 14-IGV_Preception and
+ *                      the 27 x 48 cells of 15-ROI_to_map counted
+ *          motion    : |gray - prev| > 25, counted (14-IGV_Preception)
+ *          logic     : AND / OR / XOR of two masks, counted
+ *
+ *      Checks: SIMD packing == scalar packing (same words), every count ==
+ *      cv::countNonZero, toMat() == cv::threshold, logic == cv::bitwise_*.
+ *      Reports time per frame and the bytes each mask occupies (what every
+ *      consumer has to read).
+ *
+ *  Usage       : ./build.sh Benchmark/Bit_Mask [iterations]
+ *                default: 200
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include "../igv/BitMask.hpp"
+#include "BenchUtil.hpp"
+
+static void report(const std::string& name, double ms)
+{
+    std::cout << std::left << std::setw(30) << name << ": "
+              << std::right << std::setw(7) << std::fixed << std::setprecision(3) << ms << " ms" << std::endl;
+}
+
+static bool sameWords(const igv::BitMask& a, const igv::BitMask& b)
+{
+    if(a.size() != b.size()) return false;
+    for(int y = 0; y < a.rows(); y++)
+        for(int i = 0; i < a.wordsPerRow(); i++)
+            if(a.row(y)[i] != b.row(y)[i]) return false;
+    return true;
+}
+
+// Blurred-looking gray image: smooth gradient + noise + a bright lane
+static cv::Mat grayScene(cv::Size size, uint64_t seed)
+{
+    cv::Mat g(size, CV_8UC1);
+    cv::RNG rng(seed);
+    for(int y = 0; y < size.height; y++)
+    {
+        uint8_t* row = g.ptr<uint8_t>(y);
+        for(int x = 0; x < size.width; x++)
+        {
+            bool lane = std::abs(x - size.width / 2) < size.width / 6 + y / 4;
+            row[x] = (uint8_t)std::max(0, std::min(255, (lane ? 160 : 70) + rng.uniform(-30, 30)));
+        }
+    }
+    return g;
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 200;
+    const int thresh = 115;
+
+    std::cout << "========== BIT MASK BENCHMARK ==========" << std::endl;
+    std::cout << iterations << " iterations, " << igv::simdName() << std::endl;
+    bool ok = true;
+
+    for(cv::Size frame : { cv::Size(1280, 720), cv::Size(1920, 1080) })
+    {
+        const int top = frame.height * 30 / 100;
+        const cv::Size size(frame.width, frame.height - top);
+        cv::Mat gray = grayScene(size, 3), prev = grayScene(size, 4);
+        std::cout << "---------- " << frame.width << "x" << frame.height << ", ROI "
+                  << size.width << "x" << size.height << " ----------" << std::endl;
+
+        // Zones and cells of the programs
+        const int zoneWidth = size.width / 3;
+        std::vector<cv::Rect> rects;
+        for(int z = 0; z < 3; z++) rects.push_back(cv::Rect(z * zoneWidth, 0, zoneWidth, size.height));
+        const int cw = size.width / 48, ch = size.height / 27;
+        for(int r = 0; r < 27; r++)
+            for(int c = 0; c < 48; c++)
+                rects.push_back(cv::Rect(c * cw, r * ch, cw, ch));
+
+        // ==================== CORRECTNESS ====================
+        cv::Mat binary, motion, diff, view;
+        cv::threshold(gray, binary, thresh, 255, cv::THRESH_BINARY);
+        igv::BitMask mask, maskScalar, moving, movingScalar, packed, packedScalar;
+        mask.packThreshold(gray, thresh);
+        maskScalar.packThreshold(gray, thresh, false);
+        cv::absdiff(gray, prev, diff);
+        cv::threshold(diff, motion, 25, 255, cv::THRESH_BINARY);
+        moving.packAbsDiff(gray, prev, 25);
+        movingScalar.packAbsDiff(gray, prev, 25, false);
+        packed.packNonZero(binary);
+        packedScalar.packNonZero(binary, false);
+
+        bool pack = sameWords(mask, maskScalar) && sameWords(moving, movingScalar) &&
+                    sameWords(packed, packedScalar) && sameWords(mask, packed);
+        bool counts = (int)mask.countAll() == cv::countNonZero(binary) &&
+                      (int)moving.countAll() == cv::countNonZero(motion);
+        for(const cv::Rect& r : rects) counts &= mask.count(r) == cv::countNonZero(binary(r));
+        mask.toMat(view);
+        bool display = sameImage(view, binary);
+
+        igv::BitMask both, either, changed;
+        cv::Mat m;
+        bitAnd(mask, moving, both);
+        cv::bitwise_and(binary, motion, m);
+        bool logic = (int)both.countAll() == cv::countNonZero(m);
+        bitOr(mask, moving, either);
+        cv::bitwise_or(binary, motion, m);
+        logic &= (int)either.countAll() == cv::countNonZero(m);
+        bitXor(mask, moving, changed);
+        cv::bitwise_xor(binary, motion, m);
+        logic &= (int)changed.countAll() == cv::countNonZero(m);
+
+        // Thresholds outside the byte range, repacked into the same masks
+        // (same size: create() keeps the old words)
+        for(int t : { -300, -2, -1, 0, 254, 255, 300 })
+        {
+            mask.packThreshold(gray, t);
+            maskScalar.packThreshold(gray, t, false);
+            moving.packAbsDiff(gray, prev, t);
+            movingScalar.packAbsDiff(gray, prev, t, false);
+            cv::threshold(gray, m, t, 255, cv::THRESH_BINARY);
+            pack &= sameWords(mask, maskScalar) && sameWords(moving, movingScalar) &&
+                    (int)mask.countAll() == cv::countNonZero(m);
+        }
+
+        if(!pack) std::cerr << "IGV::ERROR::SIMD packing differs from scalar" << std::endl;
+        if(!counts) std::cerr << "IGV::ERROR::BitMask counts differ from countNonZero" << std::endl;
+        if(!display) std::cerr << "IGV::ERROR::toMat differs from cv::threshold" << std::endl;
+        if(!logic) std::cerr << "IGV::ERROR::AND / OR / XOR differ from cv::bitwise_*" << std::endl;
+        ok &= pack && counts && display && logic;
+
+        // ==================== TIME ====================
+        volatile int sink = 0;
+        report("path: Mat threshold + counts", timeIt(iterations, [&]{
+            cv::threshold(gray, binary, thresh, 255, cv::THRESH_BINARY);
+            for(const cv::Rect& r : rects) sink = sink + cv::countNonZero(binary(r));
+        }));
+        report("path: BitMask pack + counts", timeIt(iterations, [&]{
+            mask.packThreshold(gray, thresh);
+            for(const cv::Rect& r : rects) sink = sink + mask.count(r);
+        }));
+        report("path: counts only, Mat", timeIt(iterations, [&]{
+            for(const cv::Rect& r : rects) sink = sink + cv::countNonZero(binary(r));
+        }));
+        report("path: counts only, BitMask", timeIt(iterations, [&]{
+            for(const cv::Rect& r : rects) sink = sink + mask.count(r);
+        }));
+        report("motion: absdiff+threshold+count", timeIt(iterations, [&]{
+            cv::absdiff(gray, prev, diff);
+            cv::threshold(diff, motion, 25, 255, cv::THRESH_BINARY);
+            sink = sink + cv::countNonZero(motion);
+        }));
+        report("motion: packAbsDiff + countAll", timeIt(iterations, [&]{
+            moving.packAbsDiff(gray, prev, 25);
+            sink = sink + (int)moving.countAll();
+        }));
+        report("logic: Mat AND + count", timeIt(iterations, [&]{
+            cv::bitwise_and(binary, motion, m);
+            sink = sink + cv::countNonZero(m);
+        }));
+        report("logic: BitMask AND + count", timeIt(iterations, [&]{
+            bitAnd(mask, moving, both);
+            sink = sink + (int)both.countAll();
+        }));
+
+        std::cout << "Mask size                     : " << binary.total() / 1024 << " KB (Mat) -> "
+                  << mask.bytes() / 1024 << " KB (BitMask), x"
+                  << std::setprecision(1) << (double)binary.total() / mask.bytes() << " less to read" << std::endl;
+    }
+
+    std::cout << (ok ? "IGV::BIT MASK OK" : "IGV::ERROR::BIT MASK FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************************
+ *  File Name   : Box_Blur.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Running-sum box blur (igv/BoxBlur.hpp) against cv::blur on a
+ *      1920x1080 BGR frame (04-Blur_demo mode 'b') and its gray version,
+ *      for square kernels from 3 to 101:
+ *
+ *          cv::blur          : OpenCV (its own threads, as the demo ran it)
+ *          boxBlur x1        : one thread
+ *          boxBlur xN        : one row band per core
+ *
+ *      Checks: every pixel within 1 of cv::blur (rounding of the division),
+ *      and the banded result identical to the single-thread one.
+ *
+ *  Usage       : ./build.sh Benchmark/Box_Blur [iterations] [threads]
+ *                default: 20, all cores
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include "../igv/BoxBlur.hpp"
+#include "BenchUtil.hpp"
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 20;
+    int threads    = (argc > 2) ? std::atoi(argv[2]) : igv::hardwareThreads();
+    const int kernels[] = { 3, 5, 9, 15, 25, 35, 50, 75, 101 };
+
+    std::cout << "========== BOX BLUR BENCHMARK ==========" << std::endl;
+    std::cout << iterations << " iterations, " << threads << " threads, ms per frame" << std::endl;
+
+    // Frame with detail at every scale: noise over gradients and edges
+    cv::Mat bgr(1080, 1920, CV_8UC3), gray;
+    cv::randu(bgr, cv::Scalar::all(0), cv::Scalar::all(255));
+    for(int i = 0; i < 20; i++)
+        cv::circle(bgr, cv::Point(96 * i, 54 * i), 40 + 10 * i, cv::Scalar(12 * i, 255 - 12 * i, 128), cv::FILLED);
+    cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);
+
+    bool ok = true;
+    for(const cv::Mat* frame : { &bgr, &gray })
+    {
+        std::cout << "---------- 1920x1080, " << frame->channels() << " channel(s) ----------" << std::endl;
+        std::cout << std::setw(6) << "k" << std::setw(12) << "cv::blur" << std::setw(12) << "boxBlur x1"
+                  << std::setw(12) << "boxBlur xN" << std::setw(10) << "speedup" << std::setw(10) << "max diff" << std::endl;
+
+        cv::Mat ref, one, many;
+        for(int k : kernels)
+        {
+            const cv::Size ksize(k, k);
+            cv::blur(*frame, ref, ksize);
+            igv::boxBlur(*frame, one, ksize, 1);
+            igv::boxBlur(*frame, many, ksize, threads);
+            double diff = maxDiff(ref, one);
+            bool same = maxDiff(one, many) == 0;
+            if(diff > 1) std::cerr << "IGV::ERROR::k " << k << " differs from cv::blur by " << diff << std::endl;
+            if(!same) std::cerr << "IGV::ERROR::k " << k << " banded result differs" << std::endl;
+            ok &= diff <= 1 && same;
+
+            double msCv = timeIt(iterations, [&]{ cv::blur(*frame, ref, ksize); });
+            double msOne = timeIt(iterations, [&]{ igv::boxBlur(*frame, one, ksize, 1); });
+            double msMany = timeIt(iterations, [&]{ igv::boxBlur(*frame, many, ksize, threads); });
+            std::cout << std::setw(6) << k << std::fixed << std::setprecision(3)
+                      << std::setw(12) << msCv << std::setw(12) << msOne << std::setw(12) << msMany
+                      << std::setw(9) << std::setprecision(2) << msCv / msMany << "x"
+                      << std::setw(10) << (int)diff << std::endl;
+        }
+    }
+
+    std::cout << (ok ? "IGV::BOX BLUR OK" : "IGV::ERROR::BOX BLUR FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,163 @@
+/*****************************************************************************************
+ *  File Name   : Capture_Ring.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Compares the old inline loop ("cap >> frame" then process) against the
+ *      threaded igv::CaptureRing, without needing a CSI camera.
+ *
+ *      Source (default) : synthetic "live" 1280x720 camera that produces a new
+ *                         frame every 1/fps seconds whether anyone reads it or not
+ *      Source (argument): any igv::FrameSource spec (file:..., image:..., gst:...)
+ *
+ *      Processing per frame is the path pipeline of 14-IGV_Preception.cpp
+ *      (gray -> Gaussian 5x5 -> OTSU) plus an optional extra delay that stands
+ *      in for imshow / GUI time.
+ *
+ *  Usage       : ./build.sh Benchmark/Capture_Ring [source_spec] [extra_ms]
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include "../igv/FrameSource.hpp"
+#include "../igv/CaptureRing.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// ========== SYNTHETIC LIVE CAMERA ==========
+// Behaves like a sensor: frame k is ready at t0 + k * period.
+// A reader that comes late gets the newest frame, the skipped ones are lost.
+struct LiveSyntheticCamera
+{
+    cv::Size size;
+    double fps;
+    int totalFrames;
+
+    Clock::time_point t0 = Clock::now();
+    long nextIndex = 0;         // Next frame index the reader can get
+    long lostBySensor = 0;      // Frames the sensor produced but nobody read
+
+    bool read(cv::Mat& frame)
+    {
+        if(nextIndex >= totalFrames) return false;
+
+        // Wait until frame "nextIndex" is exposed
+        auto ready = t0 + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(nextIndex / fps));
+        std::this_thread::sleep_until(ready);
+
+        // If we are late, jump to the newest frame the sensor has
+        double elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+        long newest = std::min<long>((long)(elapsed * fps), totalFrames - 1);
+        if(newest > nextIndex)
+        {
+            lostBySensor += newest - nextIndex;
+            nextIndex = newest;
+        }
+
+        frame.create(size, CV_8UC3);
+        frame.setTo(cv::Scalar(nextIndex % 255, 80, 160));
+        cv::rectangle(frame, cv::Rect((nextIndex * 7) % size.width, size.height / 2, 80, 80),
+                      cv::Scalar(255, 255, 255), cv::FILLED);
+        nextIndex++;
+        return true;
+    }
+};
+
+// ========== PROCESSING STAGE (same chain as the lessons) ==========
+static void processFrame(const cv::Mat& frame, cv::Mat& gray, cv::Mat& binary, int extraMs)
+{
+    cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    cv::GaussianBlur(gray, gray, cv::Size(5, 5), 0);
+    cv::threshold(gray, binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+    if(extraMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(extraMs));
+}
+
+int main(int argc, char** argv)
+{
+    const int FRAMES = 600;
+    const double FPS = 60.0;
+    std::string spec = (argc > 1) ? argv[1] : "";
+    int extraMs = (argc > 2) ? std::atoi(argv[2]) : 8;
+
+    cv::Mat gray, binary;
+
+    // ==================== 1. INLINE LOOP ====================
+    long inlineFrames = 0;
+    long inlineLost = 0;
+    auto start = Clock::now();
+    {
+        LiveSyntheticCamera cam{cv::Size(1280, 720), FPS, FRAMES};
+        std::unique_ptr<igv::FrameSource> source;
+        if(!spec.empty()) source = igv::openFrameSource(spec);
+        if(!spec.empty() && (!source || !source->isOpened())) return(EXIT_FAILURE);
+
+        cv::Mat frame;
+        while(source ? source->read(frame) : cam.read(frame))
+        {
+            processFrame(frame, gray, binary, extraMs);
+            inlineFrames++;
+        }
+        inlineLost = cam.lostBySensor;
+    }
+    double inlineSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // ==================== 2. CAPTURE RING ====================
+    long ringFrames = 0;
+    long ringLost = 0;
+    igv::CaptureRing::Stats stats;
+    start = Clock::now();
+    {
+        LiveSyntheticCamera cam{cv::Size(1280, 720), FPS, FRAMES};
+        std::unique_ptr<igv::FrameSource> source;
+        if(!spec.empty()) source = igv::openFrameSource(spec);
+        if(!spec.empty() && (!source || !source->isOpened())) return(EXIT_FAILURE);
+
+        igv::CaptureRing::GrabFn grab;
+        if(source)
+            grab = [&source](cv::Mat& m) { return source->read(m); };
+        else
+            grab = [&cam](cv::Mat& m) { return cam.read(m); };
+
+        // Replay / file sources run faster than the loop: BLOCKING, so the
+        // ring processes the same frames as the sequential loop above
+        const igv::CaptureRing::Mode mode = (source && !source->isLive())
+                                            ? igv::CaptureRing::Mode::BLOCKING
+                                            : igv::CaptureRing::Mode::EVERY_FRAME;
+        igv::CaptureRing ring(grab, 4, mode, cv::Size(1280, 720), CV_8UC3);
+        ring.start();
+
+        cv::Mat frame;
+        while(ring.read(frame))
+        {
+            processFrame(frame, gray, binary, extraMs);
+            ringFrames++;
+        }
+        ring.stop();
+        stats = ring.stats();
+        ringLost = cam.lostBySensor;
+    }
+    double ringSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // ==================== REPORT ====================
+    std::cout << "========== CAPTURE RING BENCHMARK ==========" << std::endl;
+    std::cout << "Source         : " << (spec.empty() ? "live synthetic 1280x720 @ 60 fps" : spec) << std::endl;
+    std::cout << "Extra GUI time : " << extraMs << " ms/frame" << std::endl;
+    std::cout << "Inline loop    : " << inlineFrames << " frames, "
+              << inlineFrames / inlineSec << " fps, lost at sensor: " << inlineLost << std::endl;
+    std::cout << "Capture ring   : " << ringFrames << " frames, "
+              << ringFrames / ringSec << " fps, lost at sensor: " << ringLost
+              << ", dropped: " << stats.dropped
+              << ", overwritten: " << stats.overwritten << std::endl;
+
+    return(EXIT_SUCCESS);
+}
@@ -0,0 +1,122 @@
+/*****************************************************************************************
+ *  File Name   : Fixed_Kernels.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Compile-time kernels (igv/FixedKernels.hpp), picked at run time from
+ *      the image type, against OpenCV:
+ *
+ *          Gaussian 3x3 .. 9x9, sigma 0  vs cv::GaussianBlur
+ *          erode / dilate 3x3, 5x5 rect  vs cv::erode / cv::dilate
+ *
+ *      on the images the programs filter: 1920x1080 BGR (04-Blur_demo),
+ *      1280x720 gray (13-Motion_Stop), and the same gray frame as float.
+ *      igv is timed on one thread and on one row band per core; OpenCV runs
+ *      with its own threads, as the programs run it.
+ *
+ *      Checks: 8-bit results identical to OpenCV, float within 1e-3
+ *      (the same kernel, summed in another order).
+ *
+ *  Usage       : ./build.sh Benchmark/Fixed_Kernels [iterations] [threads]
+ *                default: 50, all cores
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include "../igv/FixedKernels.hpp"
+#include "BenchUtil.hpp"
+
+static void printRow(const std::string& name, double msCv, double msOne, double msMany, double diff)
+{
+    std::cout << std::setw(12) << name << std::fixed << std::setprecision(3)
+              << std::setw(12) << msCv << std::setw(12) << msOne << std::setw(12) << msMany
+              << std::setw(9) << std::setprecision(2) << msCv / msMany << "x"
+              << std::setw(12) << std::setprecision(6) << diff << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 50;
+    int threads    = (argc > 2) ? std::atoi(argv[2]) : igv::hardwareThreads();
+
+    std::cout << "========== FIXED KERNELS BENCHMARK ==========" << std::endl;
+    std::cout << iterations << " iterations, " << threads << " threads, ms per frame" << std::endl;
+
+    // Noise over shapes: detail at every scale
+    cv::Mat bgr(1080, 1920, CV_8UC3), gray, grayF;
+    cv::randu(bgr, cv::Scalar::all(0), cv::Scalar::all(255));
+    for(int i = 0; i < 20; i++)
+        cv::circle(bgr, cv::Point(96 * i, 54 * i), 40 + 10 * i, cv::Scalar(12 * i, 255 - 12 * i, 128), cv::FILLED);
+    cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);
+    cv::resize(gray, gray, cv::Size(1280, 720));
+    gray.convertTo(grayF, CV_32F);
+
+    struct Case { const char* name; const cv::Mat* image; };
+    const Case cases[] = { { "1920x1080 BGR", &bgr }, { "1280x720 gray", &gray }, { "1280x720 float", &grayF } };
+
+    bool ok = true;
+    for(const Case& c : cases)
+    {
+        const double tolerance = (c.image->depth() == CV_32F) ? 1e-3 : 0;
+        std::cout << "---------- " << c.name << " ----------" << std::endl;
+        std::cout << std::setw(12) << "filter" << std::setw(12) << "OpenCV" << std::setw(12) << "igv x1"
+                  << std::setw(12) << "igv xN" << std::setw(10) << "speedup" << std::setw(12) << "max diff" << std::endl;
+
+        cv::Mat ref, one, many;
+        for(int k : { 3, 5, 7, 9 })
+        {
+            const cv::Size ksize(k, k);
+            cv::GaussianBlur(*c.image, ref, ksize, 0);
+            igv::gaussianBlur(*c.image, one, ksize, 1);
+            igv::gaussianBlur(*c.image, many, ksize, threads);
+            double diff = std::max(maxDiff(ref, one), maxDiff(ref, many));
+            if(diff > tolerance) std::cerr << "IGV::ERROR::Gaussian " << k << "x" << k << " differs by " << diff << std::endl;
+            ok &= diff <= tolerance;
+
+            double msCv = timeIt(iterations, [&]{ cv::GaussianBlur(*c.image, ref, ksize, 0); });
+            double msOne = timeIt(iterations, [&]{ igv::gaussianBlur(*c.image, one, ksize, 1); });
+            double msMany = timeIt(iterations, [&]{ igv::gaussianBlur(*c.image, many, ksize, threads); });
+            printRow("gauss " + std::to_string(k), msCv, msOne, msMany, diff);
+        }
+
+        for(int k : { 3, 5 })
+        {
+            const cv::Size ksize(k, k);
+            const cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, ksize);
+            for(bool isDilate : { false, true })
+            {
+                auto cvOp = [&](cv::Mat& dst) {
+                    if(isDilate) cv::dilate(*c.image, dst, kernel);
+                    else cv::erode(*c.image, dst, kernel);
+                };
+                auto igvOp = [&](cv::Mat& dst, int t) {
+                    if(isDilate) igv::dilateRect(*c.image, dst, ksize, t);
+                    else igv::erodeRect(*c.image, dst, ksize, t);
+                };
+                cvOp(ref);
+                igvOp(one, 1);
+                igvOp(many, threads);
+                double diff = std::max(maxDiff(ref, one), maxDiff(ref, many));
+                if(diff > 0) std::cerr << "IGV::ERROR::" << (isDilate ? "dilate " : "erode ") << k << " differs by " << diff << std::endl;
+                ok &= diff == 0;
+
+                double msCv = timeIt(iterations, [&]{ cvOp(ref); });
+                double msOne = timeIt(iterations, [&]{ igvOp(one, 1); });
+                double msMany = timeIt(iterations, [&]{ igvOp(many, threads); });
+                printRow((isDilate ? "dilate " : "erode ") + std::to_string(k), msCv, msOne, msMany, diff);
+            }
+        }
+    }
+
+    std::cout << (ok ? "IGV::FIXED KERNELS OK" : "IGV::ERROR::FIXED KERNELS FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
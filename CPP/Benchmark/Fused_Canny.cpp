@@ -0,0 +1,186 @@
+/*****************************************************************************************
+ *  File Name   : Fused_Canny.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Tiled fused edge detector (igv/FusedCanny.hpp) against the OpenCV
+ *      chain of 05-Edge_pipeline / test.cpp:
+ *
+ *          cvtColor(BGR2GRAY) -> GaussianBlur(5x5, 0) -> Canny(low, high)
+ *
+ *      on recorded frames, for 1 .. N threads (OpenCV limited to the same
+ *      count with cv::setNumThreads), at the two program settings:
+ *
+ *          1920x1080, Canny(100, 200)   (05-Edge_pipeline)
+ *          640x480,   Canny(50, 150)    (test.cpp)
+ *
+ *      Frames are read into memory first (capture is not timed); a source
+ *      of another size is resized to each setting.
+ *
+ *      Checks: edge pixels that differ from the OpenCV chain, and the same
+ *      edges for every thread count and tile size.
+ *
+ *  Usage       : ./build.sh Benchmark/Fused_Canny [source_spec] [frames]
+ *                default: synthetic road scene, 60 frames
+ *                e.g.     ./build.sh Benchmark/Fused_Canny file:drive.mp4 200
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../igv/FrameSource.hpp"
+#include "../igv/FusedCanny.hpp"
+
+static void opencvChain(const cv::Mat& frame, cv::Mat& gray, cv::Mat& blurred, cv::Mat& edges, double low, double high)
+{
+    cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    cv::GaussianBlur(gray, blurred, cv::Size(5, 5), 0);
+    cv::Canny(blurred, edges, low, high);
+}
+
+static int differentPixels(const cv::Mat& a, const cv::Mat& b)
+{
+    cv::Mat d;
+    cv::compare(a, b, d, cv::CMP_NE);
+    return cv::countNonZero(d);
+}
+
+int main(int argc, char** argv)
+{
+    std::string spec = (argc > 1) ? argv[1] : "synthetic:1920x1080@60,fast";
+    int frameCount = (argc > 2) ? std::atoi(argv[2]) : 60;
+    const int maxThreads = igv::hardwareThreads();
+
+    std::cout << "========== FUSED CANNY BENCHMARK ==========" << std::endl;
+
+    // ========== RECORDED FRAMES ==========
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSource(spec);
+    if(!source || !source->isOpened())
+    {
+        std::cerr << "IGV::ERROR::Cannot open source " << spec << std::endl;
+        return EXIT_FAILURE;
+    }
+    source->setFast(true);
+    std::vector<cv::Mat> recorded;
+    cv::Mat frame;
+    while((int)recorded.size() < frameCount && source->read(frame))
+    {
+        if(frame.channels() != 3)
+        {
+            std::cerr << "IGV::ERROR::BGR frames needed (source " << spec << ")" << std::endl;
+            return EXIT_FAILURE;
+        }
+        recorded.push_back(frame.clone());
+    }
+    if(recorded.empty())
+    {
+        std::cerr << "IGV::ERROR::No frames from " << spec << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << recorded.size() << " frames from " << source->name() << ", up to "
+              << maxThreads << " threads, ms per frame" << std::endl;
+
+    struct Setting { cv::Size size; double low, high; const char* program; };
+    const Setting settings[] = { { cv::Size(1920, 1080), 100, 200, "05-Edge_pipeline" },
+                                 { cv::Size(640, 480), 50, 150, "test.cpp" } };
+
+    bool ok = true;
+    for(const Setting& s : settings)
+    {
+        std::vector<cv::Mat> frames;
+        for(const cv::Mat& f : recorded)
+        {
+            cv::Mat r;
+            if(f.size() == s.size) r = f;
+            else cv::resize(f, r, s.size, 0, 0, cv::INTER_AREA);
+            frames.push_back(r);
+        }
+
+        std::cout << "---------- " << s.size.width << "x" << s.size.height << ", Canny(" << s.low << ", "
+                  << s.high << ") as in " << s.program << " ----------" << std::endl;
+        std::cout << std::setw(8) << "threads" << std::setw(12) << "OpenCV" << std::setw(12) << "fused"
+                  << std::setw(10) << "speedup" << std::setw(12) << "scaling" << std::setw(14) << "diff pixels"
+                  << std::setw(10) << "stitched" << std::endl;
+
+        // ========== CORRECTNESS ==========
+        // Reference edges: OpenCV chain; fused result fixed across threads / tiles
+        std::vector<cv::Mat> reference(frames.size()), fusedRef(frames.size());
+        cv::Mat gray, blurred, edges;
+        igv::FusedCanny canny;
+        long diffPixels = 0;
+        for(size_t i = 0; i < frames.size(); i++)
+        {
+            opencvChain(frames[i], gray, blurred, reference[i], s.low, s.high);
+            canny.apply(frames[i], fusedRef[i], s.low, s.high, 1);
+            diffPixels += differentPixels(reference[i], fusedRef[i]);
+        }
+        for(int tile : { 8, 64, 1 << 20 })
+        {
+            canny.setTileRows(tile);
+            for(size_t i = 0; i < frames.size(); i += 7)
+                for(int t : { 1, maxThreads })
+                {
+                    canny.apply(frames[i], edges, s.low, s.high, t);
+                    if(differentPixels(edges, fusedRef[i]) != 0)
+                    {
+                        std::cerr << "IGV::ERROR::tile " << tile << ", " << t << " threads changes the edges" << std::endl;
+                        ok = false;
+                    }
+                }
+        }
+        canny.setTileRows(igv::canny::TILE);
+
+        // The OpenCV build can take its own route (e.g. a vendor HAL); report
+        // the difference, fail only on more than 0.1 % of the pixels
+        const double diffShare = diffPixels / ((double)frames.size() * s.size.area());
+        if(diffShare > 1e-3)
+        {
+            std::cerr << "IGV::ERROR::" << diffShare * 100 << " % of the pixels differ from OpenCV" << std::endl;
+            ok = false;
+        }
+
+        // ========== SCALING ==========
+        const int defaultThreads = cv::getNumThreads();
+        double fusedOne = 0;
+        for(int t = 1; t <= maxThreads; t++)
+        {
+            cv::setNumThreads(t);
+            cv::TickMeter tmCv, tmFused;
+            long stitched = 0;
+            opencvChain(frames[0], gray, blurred, edges, s.low, s.high);       // Warm up
+            canny.apply(frames[0], edges, s.low, s.high, t);
+            for(const cv::Mat& f : frames)
+            {
+                tmCv.start();
+                opencvChain(f, gray, blurred, edges, s.low, s.high);
+                tmCv.stop();
+                tmFused.start();
+                canny.apply(f, edges, s.low, s.high, t);
+                tmFused.stop();
+                stitched += canny.stitchedPixels();
+            }
+            const double msCv = tmCv.getTimeMilli() / frames.size();
+            const double msFused = tmFused.getTimeMilli() / frames.size();
+            if(t == 1) fusedOne = msFused;
+            std::cout << std::setw(8) << t << std::fixed << std::setprecision(3)
+                      << std::setw(12) << msCv << std::setw(12) << msFused
+                      << std::setw(9) << std::setprecision(2) << msCv / msFused << "x"
+                      << std::setw(11) << fusedOne / msFused << "x"
+                      << std::setw(14) << diffPixels / (long)frames.size()
+                      << std::setw(10) << stitched / (long)frames.size() << std::endl;
+        }
+        cv::setNumThreads(defaultThreads);
+    }
+
+    std::cout << (ok ? "IGV::FUSED CANNY OK" : "IGV::ERROR::FUSED CANNY FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,183 @@
+/*****************************************************************************************
+ *  File Name   : Gray_Blur_Otsu.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Fused gray + Gaussian 5x5 + Otsu (igv/GrayBlurOtsu.hpp) against the
+ *      cvtColor -> GaussianBlur -> threshold(OTSU) chain of the path
+ *      programs, 1280x720 and 1920x1080, BGR and gray (luma) input.
+ *
+ *      For every size / input:
+ *          - SIMD output == scalar output (blurred, threshold, binary)
+ *          - scalar == a direct 5x5 reference written from the formulas
+ *          - against OpenCV: max difference of the blurred image, both
+ *            thresholds, binary pixels that differ
+ *          - time per frame, and the memory traffic of each version
+ *            (bytes read + written per frame) with the bandwidth it uses
+ *
+ *      The test frame is a synthetic path scene: dark ground with a bright
+ *      lane, a gradient and noise, so the histogram is bimodal like a real one.
+ *
+ *  Usage       : ./build.sh Benchmark/Gray_Blur_Otsu [iterations]
+ *                default: 100
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include "../igv/GrayBlurOtsu.hpp"
+#include "BenchUtil.hpp"
+
+static long differing(const cv::Mat& a, const cv::Mat& b)
+{
+    long n = 0;
+    for(int y = 0; y < a.rows; y++)
+        for(int x = 0; x < a.cols; x++)
+            n += a.ptr<uint8_t>(y)[x] != b.ptr<uint8_t>(y)[x];
+    return n;
+}
+
+static cv::Mat pathScene(cv::Size size, uint64_t seed)
+{
+    cv::Mat bgr(size, CV_8UC3);
+    cv::RNG rng(seed);
+    for(int y = 0; y < size.height; y++)
+    {
+        uint8_t* row = bgr.ptr<uint8_t>(y);
+        // Lane widens towards the bottom of the frame
+        int half = size.width / 10 + (size.width / 4) * y / size.height;
+        for(int x = 0; x < size.width; x++)
+        {
+            bool lane = std::abs(x - size.width / 2) < half && y > size.height / 3;
+            int base = lane ? 170 : 60 + 40 * y / size.height;
+            row[3 * x + 0] = (uint8_t)std::max(0, std::min(255, base - 10 + rng.uniform(-25, 25)));
+            row[3 * x + 1] = (uint8_t)std::max(0, std::min(255, base + 15 + rng.uniform(-25, 25)));
+            row[3 * x + 2] = (uint8_t)std::max(0, std::min(255, base + rng.uniform(-25, 25)));
+        }
+    }
+    return bgr;
+}
+
+// Direct 5x5 from the formulas in GrayBlurOtsu.hpp, no row buffers
+static void reference(const cv::Mat& src, cv::Mat& blurred, int& thresh, cv::Mat& binary)
+{
+    const int w = src.cols, h = src.rows;
+    cv::Mat gray(src.size(), CV_8UC1);
+    for(int y = 0; y < h; y++)
+        for(int x = 0; x < w; x++)
+        {
+            if(src.channels() == 1) { gray.ptr<uint8_t>(y)[x] = src.ptr<uint8_t>(y)[x]; continue; }
+            const uint8_t* p = src.ptr<uint8_t>(y) + 3 * x;
+            gray.ptr<uint8_t>(y)[x] = (uint8_t)((p[0] * 1868 + p[1] * 9617 + p[2] * 4899 + 8192) >> 14);
+        }
+
+    const int k[5] = { 1, 4, 6, 4, 1 };
+    uint32_t hist[256] = {};
+    blurred.create(src.size(), CV_8UC1);
+    for(int y = 0; y < h; y++)
+        for(int x = 0; x < w; x++)
+        {
+            int s = 0;
+            for(int j = 0; j < 5; j++)
+            {
+                int yy = cv::borderInterpolate(y + j - 2, h, cv::BORDER_REFLECT_101);
+                for(int i = 0; i < 5; i++)
+                    s += k[j] * k[i] * gray.ptr<uint8_t>(yy)[cv::borderInterpolate(x + i - 2, w, cv::BORDER_REFLECT_101)];
+            }
+            uint8_t v = (uint8_t)((s + 128) >> 8);
+            blurred.ptr<uint8_t>(y)[x] = v;
+            hist[v]++;
+        }
+
+    thresh = igv::otsuThreshold(hist, (uint64_t)w * h);
+    binary.create(src.size(), CV_8UC1);
+    for(int y = 0; y < h; y++)
+        for(int x = 0; x < w; x++)
+            binary.ptr<uint8_t>(y)[x] = blurred.ptr<uint8_t>(y)[x] > thresh ? 255 : 0;
+}
+
+static void report(const std::string& name, double ms, double bytes)
+{
+    std::cout << std::left << std::setw(26) << name << ": "
+              << std::right << std::setw(7) << std::fixed << std::setprecision(3) << ms << " ms  "
+              << std::setw(6) << std::setprecision(1) << bytes / 1e6 << " MB/frame  "
+              << std::setw(6) << bytes / (ms * 1e-3) / 1e9 << " GB/s" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 100;
+
+    std::cout << "========== GRAY BLUR OTSU BENCHMARK ==========" << std::endl;
+    std::cout << iterations << " iterations, " << igv::simdName() << std::endl;
+    bool ok = true;
+
+    for(cv::Size size : { cv::Size(1280, 720), cv::Size(1920, 1080) })
+    {
+        cv::Mat bgr = pathScene(size, 11);
+        cv::Mat luma;
+        cv::cvtColor(bgr, luma, cv::COLOR_BGR2GRAY);
+
+        for(bool color : { true, false })
+        {
+            const cv::Mat& src = color ? bgr : luma;
+            const double n = (double)size.area();
+            std::cout << "---------- " << size.width << "x" << size.height
+                      << (color ? " BGR" : " gray") << " ----------" << std::endl;
+
+            // ==================== CORRECTNESS ====================
+            igv::GrayBlurOtsu fused, scalar;
+            cv::Mat binary, binaryScalar, refBlurred, refBinary;
+            int refThresh = 0;
+            fused.apply(src, binary);
+            scalar.blurScalar(src);
+            scalar.binarizeScalar(binaryScalar);
+            reference(src, refBlurred, refThresh, refBinary);
+
+            bool same = fused.threshold() == scalar.threshold() &&
+                        maxDiff(fused.blurred(), scalar.blurred()) == 0 && maxDiff(binary, binaryScalar) == 0;
+            bool exact = scalar.threshold() == refThresh &&
+                         maxDiff(scalar.blurred(), refBlurred) == 0 && maxDiff(binaryScalar, refBinary) == 0;
+            if(!same) std::cerr << "IGV::ERROR::SIMD differs from scalar" << std::endl;
+            if(!exact) std::cerr << "IGV::ERROR::scalar differs from the 5x5 reference" << std::endl;
+            ok &= same && exact;
+
+            // OpenCV chain, as in 11-Clear_Path
+            cv::Mat gray, blurred, ocvBinary;
+            if(color) cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+            else gray = src;
+            cv::GaussianBlur(gray, blurred, cv::Size(5, 5), 0);
+            int ocvThresh = (int)cv::threshold(blurred, ocvBinary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+            std::cout << "blurred max diff vs OpenCV : " << maxDiff(fused.blurred(), blurred) << std::endl;
+            std::cout << "threshold igv / OpenCV     : " << fused.threshold() << " / " << ocvThresh << std::endl;
+            std::cout << "binary pixels that differ  : " << differing(binary, ocvBinary) << std::endl;
+
+            // ==================== TIME + TRAFFIC ====================
+            // OpenCV: [cvtColor 3N + N], GaussianBlur N + N, Otsu histogram N, threshold N + N
+            // fused : [3N] or N, blurred N, binarize N + N
+            const double ocvBytes = (color ? 4 * n : 0) + 5 * n;
+            const double fusedBytes = (color ? 3 * n : n) + 3 * n;
+            report("OpenCV chain", timeIt(iterations, [&]{
+                if(color) cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+                cv::GaussianBlur(gray, blurred, cv::Size(5, 5), 0);
+                cv::threshold(blurred, ocvBinary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+            }), ocvBytes);
+            report("igv scalar", timeIt(iterations, [&]{ scalar.blurScalar(src); scalar.binarizeScalar(binaryScalar); }), fusedBytes);
+            report("igv SIMD", timeIt(iterations, [&]{ fused.apply(src, binary); }), fusedBytes);
+            std::cout << "Traffic                    : " << std::setprecision(1) << ocvBytes / n << " -> "
+                      << fusedBytes / n << " bytes/pixel (" << (int)(100 - 100 * fusedBytes / ocvBytes)
+                      << " % less), intermediate images " << (color ? 2 : 1) << " -> 1" << std::endl;
+        }
+    }
+
+    std::cout << (ok ? "IGV::GRAY BLUR OTSU OK" : "IGV::ERROR::GRAY BLUR OTSU FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,124 @@
+/*****************************************************************************************
+ *  File Name   : Gray_Capture.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Per-frame cost of getting the grayscale image the pipelines work on.
+ *
+ *      BGR path  (old) : NV12 -> BGRx (nvvidconv, not measured)
+ *                        -> BGR  (videoconvert, CPU)  -> gray (cvtColor, CPU)
+ *      Luma path (new) : NV12 -> gray = view of the Y plane (no CPU work)
+ *
+ *      The CPU part of the old path is reproduced with cvtColor on the same
+ *      NV12 data: BGRx -> BGR stands for videoconvert.
+ *
+ *      Input: recorded raw NV12 frames (cat of h*3/2 x w buffers, e.g. from
+ *             "gst-launch-1.0 ... ! video/x-raw,format=NV12 ! filesink") or,
+ *             without arguments, frames from the synthetic source.
+ *
+ *  Usage       : ./build.sh Benchmark/Gray_Capture [file.nv12 width height]
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <vector>
+#include "../igv/PixelFormat.hpp"
+#include "../igv/FrameSource.hpp"
+
+// Loads up to "maxFrames" NV12 frames from a raw file
+static std::vector<cv::Mat> loadRawNv12(const std::string& path, cv::Size size, int maxFrames)
+{
+    std::vector<cv::Mat> frames;
+    std::ifstream in(path, std::ios::binary);
+    const size_t bytes = (size_t)size.width * size.height * 3 / 2;
+
+    while(in && (int)frames.size() < maxFrames)
+    {
+        cv::Mat nv12(size.height * 3 / 2, size.width, CV_8UC1);
+        if(!in.read((char*)nv12.data, bytes)) break;
+        frames.push_back(nv12);
+    }
+    return frames;
+}
+
+// Synthetic NV12 frames (same scene generator as the lessons use)
+static std::vector<cv::Mat> makeNv12(cv::Size size, int count)
+{
+    std::vector<cv::Mat> frames;
+    igv::SyntheticSource source(size, 60, igv::PixelFormat::NV12);
+    cv::Mat f;
+    for(int i = 0; i < count && source.read(f); i++)
+    {
+        frames.push_back(f.clone());
+    }
+    return frames;
+}
+
+static void runCase(const std::vector<cv::Mat>& frames, cv::Size size)
+{
+    if(frames.empty())
+    {
+        std::cerr << "IGV::ERROR::No frames for " << size.width << "x" << size.height << std::endl;
+        return;
+    }
+
+    cv::Mat bgrx, bgr, gray, blurred, scratch;
+    cv::TickMeter tmOld, tmNew, tmBlur;
+
+    for(const cv::Mat& nv12 : frames)
+    {
+        // ----- Old path: BGRx -> BGR -> gray -----
+        cv::cvtColor(nv12, bgrx, cv::COLOR_YUV2BGRA_NV12);  // done by nvvidconv on the Jetson
+        tmOld.start();
+        cv::cvtColor(bgrx, bgr, cv::COLOR_BGRA2BGR);        // videoconvert
+        cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);        // lesson STEP 1
+        tmOld.stop();
+
+        // ----- New path: Y plane view -----
+        tmNew.start();
+        cv::Mat luma = igv::lumaView(nv12, igv::PixelFormat::NV12, scratch);
+        tmNew.stop();
+
+        // Next stage is identical for both paths, reported for scale
+        tmBlur.start();
+        cv::GaussianBlur(luma, blurred, cv::Size(5, 5), 0);
+        tmBlur.stop();
+    }
+
+    const double n = (double)frames.size();
+    std::cout << size.width << "x" << size.height << " (" << frames.size() << " frames)" << std::endl;
+    std::cout << "    BGR path  (videoconvert + cvtColor) : " << tmOld.getTimeMilli() / n << " ms/frame" << std::endl;
+    std::cout << "    Luma path (Y plane view)            : " << tmNew.getTimeMilli() / n << " ms/frame" << std::endl;
+    std::cout << "    Saved per frame                     : " << (tmOld.getTimeMilli() - tmNew.getTimeMilli()) / n << " ms" << std::endl;
+    std::cout << "    (Gaussian 5x5 on gray, for scale    : " << tmBlur.getTimeMilli() / n << " ms/frame)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const int FRAMES = 120;
+
+    std::cout << "========== GRAY CAPTURE BENCHMARK ==========" << std::endl;
+
+    if(argc >= 4)
+    {
+        cv::Size size(std::atoi(argv[2]), std::atoi(argv[3]));
+        runCase(loadRawNv12(argv[1], size, FRAMES), size);
+        return(EXIT_SUCCESS);
+    }
+
+    const cv::Size sizes[] = { cv::Size(1280, 720), cv::Size(1920, 1080) };
+    for(const cv::Size& size : sizes)
+    {
+        runCase(makeNv12(size, FRAMES), size);
+    }
+
+    return(EXIT_SUCCESS);
+}
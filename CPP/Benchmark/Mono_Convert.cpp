@@ -0,0 +1,137 @@
+/*****************************************************************************************
+ *  File Name   : Mono_Convert.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      16-bit mono (Y10 / Y12) to 8-bit gray, igv::MonoTo8 (igv/MonoConvert.hpp)
+ *      against cv::convertScaleAbs and cv::Mat::convertTo, 1920x1080.
+ *
+ *      For every mode (shift, min/max stretch, gamma LUT) and for the whole
+ *      frame and the bottom 70 % ROI:
+ *          - the SIMD output must be identical to the scalar reference
+ *          - shift / stretch are compared against OpenCV (max difference)
+ *          - time per frame
+ *
+ *      The test frame is a synthetic sensor image: gradient + noise, with a
+ *      few saturated pixels, so the stretch / clamp paths are all exercised.
+ *
+ *  Usage       : ./build.sh Benchmark/Mono_Convert [bits] [iterations]
+ *                default: 10 200
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include "../igv/MonoConvert.hpp"
+#include "BenchUtil.hpp"
+
+static void report(const std::string& name, double ms, double diff, const std::string& against)
+{
+    std::cout << std::left << std::setw(28) << name << ": "
+              << std::right << std::setw(7) << std::fixed << std::setprecision(3) << ms << " ms";
+    if(!against.empty()) std::cout << "   max diff vs " << against << " = " << diff;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int bits       = (argc > 1) ? std::atoi(argv[1]) : 10;
+    int iterations = (argc > 2) ? std::atoi(argv[2]) : 200;
+    bits = std::max(9, std::min(bits, 16));
+    const int maxValue = (1 << bits) - 1;
+
+    std::cout << "========== MONO CONVERT BENCHMARK ==========" << std::endl;
+    std::cout << "1920x1080, " << bits << " bit, " << iterations << " iterations, "
+              << igv::simdName() << std::endl;
+
+    // ==================== TEST FRAME ====================
+    cv::Mat src(1080, 1920, CV_16UC1);
+    cv::RNG rng(7);
+    for(int y = 0; y < src.rows; y++)
+    {
+        uint16_t* row = src.ptr<uint16_t>(y);
+        for(int x = 0; x < src.cols; x++)
+        {
+            int v = (int)((double)(x + y) / (src.cols + src.rows) * maxValue * 0.8) + 40
+                  + rng.uniform(-30, 30);
+            row[x] = (uint16_t)std::max(0, std::min(v, maxValue));
+        }
+    }
+    for(int i = 0; i < 500; i++) src.at<uint16_t>(rng.uniform(0, src.rows), rng.uniform(0, src.cols)) = maxValue;
+
+    const cv::Rect roi(0, src.rows * 30 / 100, src.cols, src.rows - src.rows * 30 / 100);
+    cv::Mat dst, ref, ocv;
+    bool ok = true;
+
+    // Every mode: SIMD == scalar, on the full frame and on the ROI
+    auto check = [&](const igv::MonoTo8& conv, const std::string& name)
+    {
+        conv.convert(src, dst);
+        conv.convertScalar(src, ref);
+        double dFull = maxDiff(dst, ref);
+
+        conv.convert(src, dst, roi);
+        conv.convertScalar(src, ref, roi);
+        double dRoi = maxDiff(dst, ref);
+
+        if(dFull != 0 || dRoi != 0)
+        {
+            std::cerr << "IGV::ERROR::" << name << " SIMD differs from scalar (full "
+                      << dFull << ", roi " << dRoi << ")" << std::endl;
+            ok = false;
+        }
+    };
+
+    // ==================== SHIFT ====================
+    std::cout << "---------- shift (>> " << bits - 8 << ") ----------" << std::endl;
+    igv::MonoTo8 shift(bits);
+    check(shift, "shift");
+    const double scale = 1.0 / (1 << (bits - 8));
+    report("cv::convertScaleAbs", timeIt(iterations, [&]{ cv::convertScaleAbs(src, ocv, scale); }), 0, "");
+    report("cv::Mat::convertTo", timeIt(iterations, [&]{ src.convertTo(ocv, CV_8U, scale); }), 0, "");
+    report("igv scalar", timeIt(iterations, [&]{ shift.convertScalar(src, ref); }), 0, "");
+    report("igv SIMD", timeIt(iterations, [&]{ shift.convert(src, dst); }), maxDiff(dst, ocv), "convertTo (rounds)");
+    report("igv SIMD bottom 70 % ROI", timeIt(iterations, [&]{ shift.convert(src, dst, roi); }), 0, "");
+
+    // ==================== STRETCH ====================
+    std::cout << "---------- min/max stretch ----------" << std::endl;
+    igv::MonoTo8 stretch(bits);
+    stretch.setStretch();
+    check(stretch, "stretch");
+    report("cv::minMaxLoc+convertTo", timeIt(iterations, [&]{
+        double mn, mx;
+        cv::minMaxLoc(src, &mn, &mx);
+        src.convertTo(ocv, CV_8U, 255.0 / (mx - mn), -mn * 255.0 / (mx - mn));
+    }), 0, "");
+    report("igv scalar", timeIt(iterations, [&]{ stretch.convertScalar(src, ref); }), 0, "");
+    report("igv SIMD", timeIt(iterations, [&]{ stretch.convert(src, dst); }), maxDiff(dst, ocv), "OpenCV");
+    report("igv SIMD bottom 70 % ROI", timeIt(iterations, [&]{ stretch.convert(src, dst, roi); }), 0, "");
+
+    // ==================== GAMMA LUT ====================
+    std::cout << "---------- gamma 2.2 LUT ----------" << std::endl;
+    igv::MonoTo8 gamma(bits);
+    gamma.setGamma(2.2);
+    check(gamma, "gamma");
+    report("igv LUT", timeIt(iterations, [&]{ gamma.convert(src, dst); }), 0, "");
+    report("igv LUT bottom 70 % ROI", timeIt(iterations, [&]{ gamma.convert(src, dst, roi); }), 0, "");
+
+    // Stretch must stay within 1 of OpenCV's rounding (documented tolerance)
+    stretch.convert(src, dst);
+    {
+        double mn, mx;
+        cv::minMaxLoc(src, &mn, &mx);
+        src.convertTo(ocv, CV_8U, 255.0 / (mx - mn), -mn * 255.0 / (mx - mn));
+    }
+    if(maxDiff(dst, ocv) > 1) ok = false;
+
+    std::cout << (ok ? "IGV::MONO CONVERT OK" : "IGV::ERROR::MONO CONVERT FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
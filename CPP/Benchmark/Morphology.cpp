@@ -0,0 +1,132 @@
+/*****************************************************************************************
+ *  File Name   : Morphology.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Rectangular morphology (igv/Morphology.hpp) against OpenCV on binary
+ *      masks: 640x480 (08-Morphology, 10-Object_Tracking) and 1280x504 (path
+ *      ROI of a 720p frame), square kernels from 3 to 61.
+ *
+ *          OpenCV 4 ops   : cv::erode, cv::dilate, cv::morphologyEx OPEN and
+ *                           CLOSE, as 08-Morphology ran them (6 filters)
+ *          igv all 4      : igv::morphology, one call, shared steps, x1 / xN
+ *          OpenCV close   : cv::morphologyEx CLOSE alone (10-Object_Tracking)
+ *          igv close      : igv::morphClose
+ *          BitMask all 4  : the same four on the bit-packed mask
+ *
+ *      Checks: every result is the same pixels as OpenCV, for bytes and
+ *      bits, and with any number of threads.
+ *
+ *  Usage       : ./build.sh Benchmark/Morphology [iterations] [threads]
+ *                default: 50, all cores
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include "../igv/Morphology.hpp"
+#include "BenchUtil.hpp"
+
+// OTSU-like mask: blobs, thin lines and pepper noise
+static cv::Mat maskScene(cv::Size size)
+{
+    cv::Mat m(size, CV_8UC1, cv::Scalar(0));
+    cv::RNG rng(18);
+    for(int i = 0; i < 40; i++)
+        cv::circle(m, cv::Point(rng.uniform(0, size.width), rng.uniform(0, size.height)),
+                   rng.uniform(5, 60), cv::Scalar(255), cv::FILLED);
+    for(int i = 0; i < 20; i++)
+        cv::line(m, cv::Point(rng.uniform(0, size.width), rng.uniform(0, size.height)),
+                 cv::Point(rng.uniform(0, size.width), rng.uniform(0, size.height)), cv::Scalar(255), 2);
+    for(int i = 0; i < size.area() / 50; i++)
+        m.at<uint8_t>(rng.uniform(0, size.height), rng.uniform(0, size.width)) ^= 255;
+    return m;
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 50;
+    int threads    = (argc > 2) ? std::atoi(argv[2]) : igv::hardwareThreads();
+    const int kernels[] = { 3, 5, 9, 15, 31, 61 };
+
+    std::cout << "========== MORPHOLOGY BENCHMARK ==========" << std::endl;
+    std::cout << iterations << " iterations, " << threads << " threads, ms per frame" << std::endl;
+
+    bool ok = true;
+    for(cv::Size size : { cv::Size(640, 480), cv::Size(1280, 504) })
+    {
+        cv::Mat mask = maskScene(size);
+        igv::BitMask bits;
+        bits.packNonZero(mask);
+
+        std::cout << "---------- " << size.width << "x" << size.height << " ----------" << std::endl;
+        std::cout << std::setw(4) << "k" << std::setw(12) << "cv 4 ops" << std::setw(12) << "igv 4 x1"
+                  << std::setw(12) << "igv 4 xN" << std::setw(12) << "cv close" << std::setw(12) << "igv close"
+                  << std::setw(12) << "bits 4" << std::endl;
+
+        for(int k : kernels)
+        {
+            const cv::Size ksize(k, k);
+            const cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, ksize);
+            cv::Mat e, d, o, c, e2, d2, o2, c2, view;
+            cv::erode(mask, e, kernel);
+            cv::dilate(mask, d, kernel);
+            cv::morphologyEx(mask, o, cv::MORPH_OPEN, kernel);
+            cv::morphologyEx(mask, c, cv::MORPH_CLOSE, kernel);
+
+            // ==================== CORRECTNESS ====================
+            igv::MorphOutputs<cv::Mat> all;
+            all.erode = &e2; all.dilate = &d2; all.open = &o2; all.close = &c2;
+            bool same = true;
+            for(int t : { 1, threads })
+            {
+                igv::morphology(mask, ksize, all, t);
+                same &= sameImage(e, e2) && sameImage(d, d2) && sameImage(o, o2) && sameImage(c, c2);
+            }
+            igv::morphClose(mask, c2, ksize);
+            same &= sameImage(c, c2);
+
+            igv::BitMask be, bd, bo, bc;
+            igv::MorphOutputs<igv::BitMask> allBits;
+            allBits.erode = &be; allBits.dilate = &bd; allBits.open = &bo; allBits.close = &bc;
+            igv::morphology(bits, ksize, allBits);
+            bool sameBits = true;
+            be.toMat(view); sameBits &= sameImage(e, view);
+            bd.toMat(view); sameBits &= sameImage(d, view);
+            bo.toMat(view); sameBits &= sameImage(o, view);
+            bc.toMat(view); sameBits &= sameImage(c, view);
+
+            if(!same) std::cerr << "IGV::ERROR::k " << k << " bytes differ from OpenCV" << std::endl;
+            if(!sameBits) std::cerr << "IGV::ERROR::k " << k << " bits differ from OpenCV" << std::endl;
+            ok &= same && sameBits;
+
+            // ==================== TIME ====================
+            double msCv4 = timeIt(iterations, [&]{
+                cv::erode(mask, e, kernel);
+                cv::dilate(mask, d, kernel);
+                cv::morphologyEx(mask, o, cv::MORPH_OPEN, kernel);
+                cv::morphologyEx(mask, c, cv::MORPH_CLOSE, kernel);
+            });
+            double msIgv4 = timeIt(iterations, [&]{ igv::morphology(mask, ksize, all, 1); });
+            double msIgv4N = timeIt(iterations, [&]{ igv::morphology(mask, ksize, all, threads); });
+            double msCvClose = timeIt(iterations, [&]{ cv::morphologyEx(mask, c, cv::MORPH_CLOSE, kernel); });
+            double msIgvClose = timeIt(iterations, [&]{ igv::morphClose(mask, c2, ksize, threads); });
+            double msBits4 = timeIt(iterations, [&]{ igv::morphology(bits, ksize, allBits); });
+
+            std::cout << std::setw(4) << k << std::fixed << std::setprecision(3)
+                      << std::setw(12) << msCv4 << std::setw(12) << msIgv4 << std::setw(12) << msIgv4N
+                      << std::setw(12) << msCvClose << std::setw(12) << msIgvClose
+                      << std::setw(12) << msBits4 << std::endl;
+        }
+    }
+
+    std::cout << (ok ? "IGV::MORPHOLOGY OK" : "IGV::ERROR::MORPHOLOGY FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
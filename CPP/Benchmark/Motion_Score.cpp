@@ -0,0 +1,175 @@
+/*****************************************************************************************
+ *  File Name   : Motion_Score.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Emergency stop decision of 14-IGV_Preception (frame difference,
+ *      |gray - prevGray| > 25, STOP above 5000 pixels) three ways, on
+ *      replayed frames:
+ *
+ *          OpenCV   absdiff -> threshold -> countNonZero
+ *          BitMask  packAbsDiff -> countAll            (one pass, 1 bit / pixel)
+ *          scorer   igv::MotionScorer, nearest blocks first, early exit
+ *
+ *      Frames are read and blurred first (not timed); every method decides
+ *      on the same consecutive pairs.
+ *
+ *      Reports:
+ *          - decision time per frame: mean, p50, p90, p99, max
+ *          - scorer early exits: share of the STOP frames decided before
+ *            the last block, and the share of blocks they scanned
+ *
+ *      Checks: the scorer gives the decision of the full count on every
+ *      frame, with and without SIMD.
+ *
+ *  Usage       : ./build.sh Benchmark/Motion_Score [source_spec] [frames]
+ *                default: synthetic 1280x720 road scene, 480 frames
+ *                e.g.     ./build.sh Benchmark/Motion_Score log:run1.igvlog,fast
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../igv/FrameSource.hpp"
+#include "../igv/FixedKernels.hpp"
+#include "../igv/BitMask.hpp"
+#include "../igv/MotionScore.hpp"
+
+const int MOTION_THRESHOLD = 25;
+const int STOP_PIXELS = 5000;
+
+// Decision time distribution of one method (ms per frame)
+static void printLatency(const std::string& name, std::vector<double> ms)
+{
+    if(ms.empty()) return;
+    std::sort(ms.begin(), ms.end());
+    auto pct = [&](double p) { return ms[std::min(ms.size() - 1, (size_t)(p * ms.size()))]; };
+    double mean = 0;
+    for(double v : ms) mean += v;
+    mean /= ms.size();
+    std::cout << std::setw(16) << name << std::fixed << std::setprecision(3)
+              << std::setw(10) << mean << std::setw(10) << pct(0.5) << std::setw(10) << pct(0.9)
+              << std::setw(10) << pct(0.99) << std::setw(10) << ms.back() << std::setw(8) << ms.size() << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::string spec = (argc > 1) ? argv[1] : "synthetic:1280x720@60,fast";
+    int frameCount = (argc > 2) ? std::atoi(argv[2]) : 480;
+
+    std::cout << "========== MOTION SCORE BENCHMARK ==========" << std::endl;
+
+    // ========== RECORDED FRAMES ==========
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSource(spec);
+    if(!source || !source->isOpened())
+    {
+        std::cerr << "IGV::ERROR::Cannot open source " << spec << std::endl;
+        return EXIT_FAILURE;
+    }
+    source->setFast(true);
+    std::vector<cv::Mat> grays;
+    cv::Mat frame, lumaScratch;
+    while((int)grays.size() < frameCount && source->read(frame))
+    {
+        cv::Mat gray;
+        igv::gaussianBlur(igv::lumaView(frame, source->format(), lumaScratch), gray, cv::Size(5, 5));
+        grays.push_back(gray);
+    }
+    if(grays.size() < 2)
+    {
+        std::cerr << "IGV::ERROR::Not enough frames from " << spec << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << grays.size() << " frames " << grays[0].cols << "x" << grays[0].rows << " from " << source->name()
+              << ", " << igv::simdName() << ", |diff| > " << MOTION_THRESHOLD << ", STOP above "
+              << STOP_PIXELS << " pixels" << std::endl;
+
+    // ========== DECISIONS ==========
+    igv::MotionScorer scorer;
+    igv::BitMask mask;
+    cv::Mat diff, binary;
+    std::vector<double> msCv, msBits, msScore, msScoreStop, msScoreSafe;
+    int stops = 0, early = 0;
+    long scannedBlocks = 0, stopBlocks = 0;
+    bool ok = true;
+    for(size_t i = 1; i < grays.size(); i++)
+    {
+        const cv::Mat& gray = grays[i];
+        const cv::Mat& prevGray = grays[i - 1];
+        cv::TickMeter tm;
+
+        tm.start();
+        cv::absdiff(gray, prevGray, diff);
+        cv::threshold(diff, binary, MOTION_THRESHOLD, 255, cv::THRESH_BINARY);
+        const int fullCount = cv::countNonZero(binary);
+        tm.stop();
+        msCv.push_back(tm.getTimeMilli());
+
+        tm.reset();
+        tm.start();
+        mask.packAbsDiff(gray, prevGray, MOTION_THRESHOLD);
+        const int bitsCount = (int)mask.countAll();
+        tm.stop();
+        msBits.push_back(tm.getTimeMilli());
+
+        tm.reset();
+        tm.start();
+        igv::MotionScore s = scorer.score(gray, prevGray, MOTION_THRESHOLD, STOP_PIXELS);
+        tm.stop();
+        msScore.push_back(tm.getTimeMilli());
+        (s.stop ? msScoreStop : msScoreSafe).push_back(tm.getTimeMilli());
+
+        // Same decision as the full count; same count when no exit
+        const bool fullStop = fullCount > STOP_PIXELS;
+        igv::MotionScore scalar = scorer.score(gray, prevGray, MOTION_THRESHOLD, STOP_PIXELS, false);
+        if(s.stop != fullStop || scalar.stop != fullStop || bitsCount != fullCount ||
+           (!s.stop && s.pixels != fullCount) || scalar.pixels != s.pixels || scalar.blocks != s.blocks)
+        {
+            std::cerr << "IGV::ERROR::frame " << i << ": full count " << fullCount << ", scorer "
+                      << s.pixels << " (" << s.blocks << " blocks), scalar " << scalar.pixels << std::endl;
+            ok = false;
+        }
+
+        if(s.stop)
+        {
+            stops++;
+            early += s.early();
+            stopBlocks += s.blocks;
+        }
+        scannedBlocks += s.blocks;
+    }
+
+    // ========== REPORT ==========
+    const int pairs = (int)grays.size() - 1;
+    const int totalBlocks = scorer.score(grays[1], grays[0], MOTION_THRESHOLD, STOP_PIXELS).totalBlocks;
+    std::cout << "Decision time (ms)" << std::endl;
+    std::cout << std::setw(16) << "method" << std::setw(10) << "mean" << std::setw(10) << "p50"
+              << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "max"
+              << std::setw(8) << "frames" << std::endl;
+    printLatency("OpenCV", msCv);
+    printLatency("BitMask", msBits);
+    printLatency("scorer", msScore);
+    printLatency("scorer STOP", msScoreStop);
+    printLatency("scorer SAFE", msScoreSafe);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "STOP on " << stops << " / " << pairs << " frames, " << early << " decided early ("
+              << (stops ? 100.0 * early / stops : 0.0) << " %)" << std::endl;
+    std::cout << "Blocks scanned: " << (stops ? 100.0 * stopBlocks / ((double)stops * totalBlocks) : 0.0)
+              << " % on STOP frames, " << 100.0 * scannedBlocks / ((double)pairs * totalBlocks)
+              << " % overall (" << totalBlocks << " blocks of " << scorer.block().width << "x"
+              << scorer.block().height << ")" << std::endl;
+
+    std::cout << (ok ? "IGV::MOTION SCORE OK" : "IGV::ERROR::MOTION SCORE FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,181 @@
+/*****************************************************************************************
+ *  File Name   : Register_Cache.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Rect / cv::Size only), V4L2
+ *
+ *  Description :
+ *      Register shadow cache of the Arducam driver (arducam_regcache.h), on the
+ *      register mock (igv/ArducamRegisterModel.hpp), with and without the cache
+ *      (module parameter regcache=1 / 0).
+ *
+ *      The same sequence of driver operations runs twice:
+ *          probe, set_fmt, stream on, mode changes and back, a control change
+ *          (frame rate: the vblank / exposure ranges follow), crop, power
+ *          cycle, a NACK during set_fmt
+ *      and for every operation:
+ *          - I2C reads / writes with and without the cache, reads saved
+ *          - what the driver learnt (formats, control ranges and values) must
+ *            be the same in both runs and match the firmware model
+ *
+ *  Usage       : ./build.sh Benchmark/Register_Cache
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include "../igv/ArducamRegisterModel.hpp"
+
+namespace arducam = igv::arducam;
+
+// One driver instance on its own mock sensor
+struct Driver
+{
+    explicit Driver(bool cache) : bus(cv::Size(1920, 1080))
+    {
+        arducam_regcache_init(&regs, cache);
+    }
+
+    arducam::Client client() { return arducam::Client(bus, &regs); }
+
+    arducam::RegisterModel bus;
+    arducam::Device dev;
+    arducam_regcache regs;
+};
+
+static bool expect(bool cond, const std::string& what)
+{
+    if(!cond) std::cout << "  FAIL " << what << std::endl;
+    return cond;
+}
+
+// Same knowledge in both drivers, and after set_fmt ("refreshed") the ranges
+// are the firmware's current ones
+static bool sameState(Driver& off, Driver& on, const std::string& step, bool refreshed)
+{
+    bool ok = expect(off.dev.formats.size() == on.dev.formats.size() &&
+                     off.dev.controls.size() == on.dev.controls.size(), step + ": same formats / controls");
+    for(size_t i = 0; ok && i < off.dev.formats.size(); i++)
+        ok &= expect(off.dev.formats[i].dataType == on.dev.formats[i].dataType &&
+                     off.dev.formats[i].resolutions == on.dev.formats[i].resolutions, step + ": format " + std::to_string(i));
+
+    for(size_t i = 0; ok && i < off.dev.controls.size(); i++)
+    {
+        const arducam::Device::Control& a = off.dev.controls[i];
+        const arducam::Device::Control& b = on.dev.controls[i];
+        ok &= expect(a.id == b.id && a.min == b.min && a.max == b.max && a.step == b.step &&
+                     a.def == b.def && a.value == b.value, step + ": control 0x" + std::to_string(a.id));
+
+        // Ranges set_fmt refreshes must be the firmware's, not stale ones
+        if(refreshed && (a.id == V4L2_CID_ARDUCAM_FRAME_RATE || a.id == V4L2_CID_HBLANK ||
+           a.id == V4L2_CID_VBLANK || a.id == V4L2_CID_PIXEL_RATE))
+        {
+            arducam::RegisterModel::Range r = on.bus.range(b.id);
+            ok &= expect(r.min == b.min && r.max == b.max && r.def == b.def, step + ": range of 0x" + std::to_string(b.id) + " is current");
+        }
+        ok &= expect(on.bus.value(b.id) == b.value, step + ": value of 0x" + std::to_string(b.id) + " on the device");
+    }
+    return ok;
+}
+
+int main()
+{
+    std::cout << "========== REGISTER CACHE BENCHMARK ==========" << std::endl;
+
+    std::unique_ptr<Driver> off(new Driver(false));
+    std::unique_ptr<Driver> on(new Driver(true));
+    bool ok = true;
+    uint64_t totalOff = 0, totalOn = 0;
+
+    std::cout << std::left << std::setw(34) << "operation"
+              << std::right << std::setw(16) << "reads/writes off"
+              << std::setw(16) << "reads/writes on"
+              << std::setw(14) << "reads cached" << std::endl;
+
+    // Runs "op" on both drivers and reports the transactions
+    auto step = [&](const std::string& name, const std::function<int(Driver&)>& op)
+    {
+        arducam_i2c_stats a = off->regs.stats, b = on->regs.stats;
+        int retOff = op(*off);
+        int retOn = op(*on);
+        uint64_t rOff = off->regs.stats.reads - a.reads, wOff = off->regs.stats.writes - a.writes;
+        uint64_t rOn = on->regs.stats.reads - b.reads, wOn = on->regs.stats.writes - b.writes;
+        totalOff += rOff + wOff;
+        totalOn += rOn + wOn;
+
+        std::cout << std::left << std::setw(34) << name << std::right
+                  << std::setw(16) << (std::to_string(rOff) + "/" + std::to_string(wOff))
+                  << std::setw(16) << (std::to_string(rOn) + "/" + std::to_string(wOn))
+                  << std::setw(14) << (on->regs.stats.hits - b.hits) << std::endl;
+
+        ok &= expect(retOff == retOn, name + ": same result");
+        ok &= expect(off->regs.stats.hits == 0, name + ": regcache=0 never hits");
+        ok &= sameState(*off, *on, name, name.find("set_fmt") != std::string::npos);
+    };
+
+    auto setFmt = [](int fmt, int res) { return [=](Driver& d) { return arducam::setFmt(d.client(), d.dev, fmt, res); }; };
+    auto streamOn = [](Driver& d) { int ret = arducam::startStreaming(d.client(), d.dev); arducam::stopStreaming(d.client()); return ret; };
+
+    // ==================== OPERATIONS ====================
+    step("probe", [](Driver& d) { return arducam::probe(d.client(), d.dev); });
+    step("set_fmt 1920x1080 Y10", setFmt(0, 0));
+    step("stream on / off", streamOn);
+    step("set_fmt 1280x720 Y10", setFmt(0, 1));
+    step("set_fmt 1920x1080 Y10 (again)", setFmt(0, 0));
+    step("set_fmt 1920x1080 Y10 (same)", setFmt(0, 0));
+    step("stream on / off", streamOn);
+    step("set_fmt 1920x1080 Y10 (restart)", setFmt(0, 0));
+
+    // Frame rate 15: vblank default follows, the cached ranges must go
+    step("s_ctrl frame_rate = 15", [](Driver& d) {
+        return arducam::sCtrl(d.client(), *d.dev.control(V4L2_CID_ARDUCAM_FRAME_RATE), 15, false); });
+    step("set_fmt 1920x1080 Y10", setFmt(0, 0));
+    step("set_fmt 640x480 RAW8", setFmt(1, 2));
+
+    step("crop bottom 70 %", [](Driver& d) {
+        cv::Rect r(0, 324, 1920, 756);
+        return arducam::setSelection(d.client(), d.dev, false, r); });
+
+    // Power on: the firmware restarted, nothing cached may be used
+    step("power cycle + set_fmt", [](Driver& d) {
+        arducam_regcache_invalidate(&d.regs);
+        return arducam::setFmt(d.client(), d.dev, 0, 0); });
+
+    // A NACK costs a retry, never a wrong value
+    step("set_fmt 1280x720 Y10 with a NACK", [](Driver& d) {
+        d.bus.failNext(1);
+        return arducam::setFmt(d.client(), d.dev, 0, 1); });
+    ok &= expect(on->regs.stats.failures == 1 && off->regs.stats.failures == 1, "NACK counted as a failure");
+
+    // ==================== PER OPERATION COUNTERS (debugfs in the driver) ====================
+    std::cout << "---------- per operation, cache on ----------" << std::endl;
+    const char* names[ARDUCAM_NUM_OPS] = { "probe", "set_fmt", "stream_on", "s_ctrl", "selection" };
+    for(int op = 0; op < ARDUCAM_NUM_OPS; op++)
+    {
+        const arducam_op_stats& s = on->regs.ops[op];
+        std::cout << std::left << std::setw(12) << names[op] << std::right
+                  << " calls " << std::setw(4) << s.calls
+                  << "  reads " << std::setw(5) << s.total.reads
+                  << "  writes " << std::setw(5) << s.total.writes
+                  << "  cached " << std::setw(5) << s.total.hits
+                  << "  failures " << s.total.failures << std::endl;
+    }
+    ok &= expect(on->regs.ops[ARDUCAM_OP_PROBE].calls == 1 && on->regs.ops[ARDUCAM_OP_SET_FMT].calls == 9,
+                 "operations counted");
+
+    std::cout << "I2C transactions        : " << totalOff << " -> " << totalOn
+              << " (" << std::fixed << std::setprecision(1)
+              << 100.0 * (double)(totalOff - totalOn) / (double)totalOff << " % less)" << std::endl;
+    ok &= expect(totalOn < totalOff, "fewer transactions with the cache");
+
+    std::cout << (ok ? "IGV::REGISTER CACHE OK" : "IGV::ERROR::REGISTER CACHE FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,152 @@
+/*****************************************************************************************
+ *  File Name   : Roi_First.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      ROI-first preprocessing (GrayBlurOtsu::apply(frame, roi, pathRect))
+ *      against the previous order (whole frame blurred and thresholded, then
+ *      cropped), on a recorded or generated sequence.
+ *
+ *      For every frame:
+ *          - time of both versions
+ *          - blurred ROI: must be the same pixels as the crop of the whole
+ *            frame blur (the rows above the ROI are real blur neighbours)
+ *          - OTSU threshold of the whole frame vs of the ROI only
+ *          - decisions that depend on it: the direction of 14-IGV_Preception
+ *            (LEFT / FORWORD / RIGHT) and the free / obstacle cells of the
+ *            15-ROI_to_map grid, counted where they differ
+ *
+ *  Usage       : ./build.sh Benchmark/Roi_First [source_spec] [frames] [roi_top]
+ *                default: synthetic:1280x720@60,fast 300 0.3
+ *                recorded: ./build.sh Benchmark/Roi_First log:run1.igvlog,fast
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include "../igv/FrameSource.hpp"
+#include "../igv/SensorRoi.hpp"
+#include "../igv/GrayBlurOtsu.hpp"
+
+// Direction of 14-IGV_Preception from a binary ROI: 0 LEFT, 1 FORWORD, 2 RIGHT
+static int direction(const cv::Mat& roi)
+{
+    int zoneWidth = roi.cols / 3;
+    int left = cv::countNonZero(roi(cv::Rect(0, 0, zoneWidth, roi.rows)));
+    int center = cv::countNonZero(roi(cv::Rect(zoneWidth, 0, zoneWidth, roi.rows)));
+    int right = cv::countNonZero(roi(cv::Rect(2 * zoneWidth, 0, zoneWidth, roi.rows)));
+    if(center >= left && center >= right) return 1;
+    return (left > right) ? 0 : 2;
+}
+
+// Cells of the 15-ROI_to_map grid (27 x 48) that are free in one and not the other
+static int cellsChanged(const cv::Mat& a, const cv::Mat& b)
+{
+    const int rows = 9 * 3, cols = 16 * 3;
+    int cw = a.cols / cols, ch = a.rows / rows, changed = 0;
+    if(cw == 0 || ch == 0) return 0;
+    for(int r = 0; r < rows; r++)
+        for(int c = 0; c < cols; c++)
+        {
+            cv::Rect cell(c * cw, r * ch, cw, ch);
+            bool freeA = cv::countNonZero(a(cell)) > cell.area() / 2;
+            bool freeB = cv::countNonZero(b(cell)) > cell.area() / 2;
+            changed += freeA != freeB;
+        }
+    return changed;
+}
+
+int main(int argc, char** argv)
+{
+    std::string spec = (argc > 1) ? argv[1] : "synthetic:1280x720@60,fast";
+    int frames       = (argc > 2) ? std::atoi(argv[2]) : 300;
+    double roiTop    = (argc > 3) ? std::atof(argv[3]) : 0.3;
+
+    std::cout << "========== ROI FIRST BENCHMARK ==========" << std::endl;
+
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSource(spec);
+    if(!source || !source->isOpened())
+    {
+        std::cerr << "IGV::ERROR::Cannot open " << spec << std::endl;
+        return EXIT_FAILURE;
+    }
+    source->setMaxFrames(frames);
+    std::cout << source->name() << ", " << frames << " frames, ROI below "
+              << (int)(roiTop * 100) << " %, " << igv::simdName() << std::endl;
+
+    igv::GrayBlurOtsu whole, first;
+    cv::Mat frame, scratch, binary, roiWhole, roiFirst;
+    cv::TickMeter tWhole, tFirst;
+    int n = 0, sameBlur = 0, directionChanged = 0, cellChanged = 0, cells = 0;
+    double thresholdDiff = 0;
+    int maxThresholdDiff = 0;
+    const char* names[3] = { "LEFT", "FORWORD", "RIGHT" };
+    int transitions[3][3] = {};
+
+    while(source->read(frame))
+    {
+        cv::Mat input = (frame.channels() == 3) ? frame : igv::lumaView(frame, source->format(), scratch);
+        cv::Rect roi = igv::pathRoi(*source, input.size(), roiTop).inFrame;
+        if(roi.empty()) continue;
+
+        // Before: whole frame, threshold from every pixel, then crop
+        tWhole.start();
+        whole.apply(input, binary);
+        roiWhole = binary(roi);
+        tWhole.stop();
+
+        // After: ROI only, threshold from the ROI pixels
+        tFirst.start();
+        first.apply(input, roiFirst, roi);
+        tFirst.stop();
+
+        // Same blur (borders at the ROI edge are real neighbours)
+        cv::Mat blurCrop = whole.blurred()(roi), d;
+        cv::absdiff(blurCrop, first.blurred(), d);
+        sameBlur += cv::countNonZero(d) == 0;
+
+        int td = std::abs(whole.threshold() - first.threshold());
+        thresholdDiff += td;
+        maxThresholdDiff = std::max(maxThresholdDiff, td);
+
+        int a = direction(roiWhole), b = direction(roiFirst);
+        directionChanged += a != b;
+        transitions[a][b]++;
+        cellChanged += cellsChanged(roiWhole, roiFirst);
+        cells += 27 * 48;
+        n++;
+    }
+
+    if(n == 0)
+    {
+        std::cerr << "IGV::ERROR::No frames" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    double msWhole = tWhole.getTimeMilli() / n, msFirst = tFirst.getTimeMilli() / n;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Whole frame, then crop : " << msWhole << " ms/frame" << std::endl;
+    std::cout << "ROI first              : " << msFirst << " ms/frame  (x"
+              << std::setprecision(2) << msWhole / msFirst << ")" << std::endl;
+    std::cout << "Blurred ROI identical  : " << sameBlur << " / " << n << " frames" << std::endl;
+    std::cout << "OTSU threshold change  : mean " << thresholdDiff / n << ", max " << maxThresholdDiff << std::endl;
+    std::cout << "Direction changed      : " << directionChanged << " / " << n << " frames" << std::endl;
+    for(int i = 0; i < 3; i++)
+        for(int j = 0; j < 3; j++)
+            if(i != j && transitions[i][j])
+                std::cout << "    " << names[i] << " -> " << names[j] << " : " << transitions[i][j] << std::endl;
+    std::cout << "Map cells changed      : " << cellChanged << " / " << cells
+              << " (" << 100.0 * cellChanged / cells << " %)" << std::endl;
+
+    bool ok = sameBlur == n;
+    std::cout << (ok ? "IGV::ROI FIRST OK" : "IGV::ERROR::ROI FIRST FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
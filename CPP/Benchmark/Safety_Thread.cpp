@@ -0,0 +1,177 @@
+/*****************************************************************************************
+ *  File Name   : Safety_Thread.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Stall injection for the safety thread of 14-IGV_Preception
+ *      (igv/SafetyStage.hpp), on a paced source (real frame rate):
+ *
+ *          none     : no stalls
+ *          main     : main loop (path + display) blocks 200 ms every 60
+ *                     frames it gets, like a stuck window
+ *          safety   : safety thread slowed before the decision, 20 ms
+ *                     (over the deadline) and 80 ms (over the watchdog)
+ *                     once every 60 frames each
+ *          capture  : no frame for 150 ms every 90 frames
+ *
+ *      Reports per scenario: frames decided, verdict latency (capture ->
+ *      verdict: p50, p99, max, over the frames passed on to the tap),
+ *      deadline misses, watchdog trips and how late the watchdog reacted
+ *      past its budget, frames the main loop got.
+ *
+ *      Checks: main loop stalls do not slow the verdicts (every frame
+ *      decided, no watchdog trip); every injected safety / capture stall
+ *      ends in STOP (deadline miss or watchdog trip).
+ *
+ *  Usage       : ./build.sh Benchmark/Safety_Thread [source_spec] [frames] [rt_priority] [cpu]
+ *                default: synthetic:1280x720@60, 240 frames, normal scheduling
+ *                e.g.     sudo ./Safety_Thread synthetic:1280x720@60 600 80 3
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../igv/FrameSource.hpp"
+#include "../igv/CaptureRing.hpp"
+#include "../igv/SafetyStage.hpp"
+
+enum class Stall { NONE, MAIN, SAFETY, CAPTURE };
+
+struct Outcome
+{
+    igv::SafetyStage::Stats stats;
+    std::vector<double> latencyMs;
+    int mainFrames = 0;
+    int injected = 0;           // Stalls that must end in STOP
+    int injectedLong = 0;       // Of which longer than the watchdog budget
+};
+
+static void sleepMs(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static bool runScenario(const std::string& spec, int frames, const igv::SafetyParams& params, Stall stall, Outcome& out)
+{
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSource(spec);
+    if(!source || !source->isOpened())
+    {
+        std::cerr << "IGV::ERROR::Cannot open source " << spec << std::endl;
+        return false;
+    }
+
+    // Capture: the source, with stalls injected before some frames
+    int grabbed = 0;
+    igv::CaptureRing ring([&](cv::Mat& m) {
+        if(grabbed >= frames) return false;
+        grabbed++;
+        if(stall == Stall::CAPTURE && grabbed % 90 == 45)
+        {
+            sleepMs(150);
+            out.injected++;
+            out.injectedLong++;
+        }
+        return source->read(m);
+    }, 4, igv::CaptureRing::Mode::LATEST);
+
+    igv::SafetyStage safety(ring, source->format(), params);
+    if(stall == Stall::SAFETY)
+    {
+        safety.setStallHook([&](uint64_t frame) {
+            if(frame % 60 == 20) { sleepMs(20); out.injected++; }
+            if(frame % 60 == 50) { sleepMs(80); out.injected++; out.injectedLong++; }
+        });
+    }
+    std::mutex latencyMutex;
+    safety.setTap([&](const cv::Mat&, int64_t, const igv::SafetyVerdict& v) {
+        std::lock_guard<std::mutex> lock(latencyMutex);
+        out.latencyMs.push_back((v.decidedNs - v.captureNs) / 1e6);
+    });
+
+    ring.start();
+    safety.start();
+
+    // Main loop: takes decided frames, reads the verdict, "displays"
+    cv::Mat frame, motionView;
+    while(safety.waitFrame(frame, motionView))
+    {
+        out.mainFrames++;
+        igv::SafetyVerdict verdict = safety.verdict();
+        (void)verdict;
+        if(stall == Stall::MAIN && out.mainFrames % 60 == 0) sleepMs(200);
+    }
+    safety.stop();
+    out.stats = safety.stats();
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::string spec = (argc > 1) ? argv[1] : "synthetic:1280x720@60";
+    int frames = (argc > 2) ? std::atoi(argv[2]) : 240;
+
+    igv::SafetyParams params;                       // As in 14-IGV_Preception
+    params.realtimePriority = (argc > 3) ? std::atoi(argv[3]) : 0;
+    params.cpu = (argc > 4) ? std::atoi(argv[4]) : -1;
+
+    std::cout << "========== SAFETY THREAD BENCHMARK ==========" << std::endl;
+    std::cout << frames << " frames per scenario from " << spec << ", " << igv::motionModelName(params.motion.model)
+              << ", deadline " << params.deadlineMs << " ms, watchdog " << params.watchdogMs << " ms";
+    if(params.realtimePriority > 0) std::cout << ", SCHED_FIFO " << params.realtimePriority;
+    if(params.cpu >= 0) std::cout << ", core " << params.cpu;
+    std::cout << std::endl;
+
+    std::cout << std::setw(10) << "stalls" << std::setw(9) << "decided" << std::setw(9) << "p50 ms"
+              << std::setw(9) << "p99 ms" << std::setw(9) << "max ms" << std::setw(10) << "deadline"
+              << std::setw(10) << "watchdog" << std::setw(12) << "trip late" << std::setw(8) << "main" << std::endl;
+
+    struct Scenario { Stall stall; const char* name; };
+    const Scenario scenarios[] = { { Stall::NONE, "none" }, { Stall::MAIN, "main" },
+                                   { Stall::SAFETY, "safety" }, { Stall::CAPTURE, "capture" } };
+    bool ok = true;
+    for(const Scenario& sc : scenarios)
+    {
+        Outcome out;
+        if(!runScenario(spec, frames, params, sc.stall, out)) return EXIT_FAILURE;
+
+        std::vector<double>& ms = out.latencyMs;
+        std::sort(ms.begin(), ms.end());
+        auto pct = [&](double p) { return ms.empty() ? 0.0 : ms[std::min(ms.size() - 1, (size_t)(p * ms.size()))]; };
+        const igv::SafetyStage::Stats& s = out.stats;
+        std::cout << std::setw(10) << sc.name << std::setw(9) << s.frames << std::fixed << std::setprecision(2)
+                  << std::setw(9) << pct(0.5) << std::setw(9) << pct(0.99) << std::setw(9) << (ms.empty() ? 0.0 : ms.back())
+                  << std::setw(10) << s.deadlineMisses << std::setw(10) << s.watchdogTrips
+                  << std::setw(12) << s.maxTripDelayNs / 1e6 << std::setw(8) << out.mainFrames << std::endl;
+
+        if(sc.stall == Stall::MAIN && ((int)s.frames != frames || s.watchdogTrips != 0))
+        {
+            std::cerr << "IGV::ERROR::main loop stalls reached the safety thread" << std::endl;
+            ok = false;
+        }
+        if((sc.stall == Stall::SAFETY || sc.stall == Stall::CAPTURE) &&
+           ((int)(s.deadlineMisses + s.watchdogTrips) < out.injected || (int)s.watchdogTrips < out.injectedLong))
+        {
+            std::cerr << "IGV::ERROR::" << sc.name << " stalls: " << out.injected << " injected ("
+                      << out.injectedLong << " over the watchdog budget), " << s.deadlineMisses
+                      << " deadline misses, " << s.watchdogTrips << " watchdog trips" << std::endl;
+            ok = false;
+        }
+    }
+
+    std::cout << (ok ? "IGV::SAFETY THREAD OK" : "IGV::ERROR::SAFETY THREAD FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,185 @@
+/*****************************************************************************************
+ *  File Name   : Sensor_Roi.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV, V4L2
+ *
+ *  Description :
+ *      Sensor-side path ROI (crop=bottom70) against the software crop.
+ *
+ *      1. Driver crop sequence on the register mock (igv/ArducamRegisterModel.hpp):
+ *         window applied and read back, alignment / clamping, refused while
+ *         streaming, I2C NACKs retried, transactions per crop
+ *      2. Pipeline: a sensor-cropped frame and the software crop of the full
+ *         frame must give the same ROI pixels and the same sensor coordinates
+ *         (igv/SensorRoi.hpp)
+ *      3. Optional, with a camera: open a v4l2mmap spec, report the crop the
+ *         driver applied and the frame rate
+ *
+ *  Usage       : ./build.sh Benchmark/Sensor_Roi [v4l2mmap_spec] [frames]
+ *                e.g. v4l2mmap:/dev/video0:1920x1080,y10,crop=bottom70,subdev=/dev/v4l-subdev0
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include "../igv/ArducamRegisterModel.hpp"
+#include "../igv/FrameSource.hpp"
+#include "../igv/SensorRoi.hpp"
+
+static bool expect(bool cond, const std::string& what)
+{
+    std::cout << (cond ? "  ok   " : "  FAIL ") << what << std::endl;
+    return cond;
+}
+
+static std::string str(const cv::Rect& r)
+{
+    return std::to_string(r.width) + "x" + std::to_string(r.height) + "+"
+         + std::to_string(r.x) + "+" + std::to_string(r.y);
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "========== SENSOR ROI BENCHMARK ==========" << std::endl;
+    bool ok = true;
+    const cv::Size sensor(1920, 1080);
+
+    // ==================== 1: DRIVER SEQUENCE ON THE MOCK ====================
+    std::cout << "---------- crop registers (mock) ----------" << std::endl;
+    {
+        igv::arducam::RegisterModel regs(sensor);
+        igv::arducam::Device dev;
+
+        // Bottom 70 %: what crop=bottom70 asks for
+        cv::Rect r(0, 324, 1920, 756);
+        int ret = igv::arducam::setSelection(regs, dev, false, r);
+        uint64_t transactions = regs.stats().reads + regs.stats().writes;
+        ok &= expect(ret == 0 && r == cv::Rect(0, 324, 1920, 756) && regs.crop() == r,
+                     "bottom 70 % applied and read back: " + str(regs.crop()));
+        std::cout << "         I2C transactions for one crop: " << transactions << std::endl;
+
+        // Odd / oversized requests are aligned and clamped into the array
+        r = cv::Rect(101, 333, 1001, 557);
+        ret = igv::arducam::setSelection(regs, dev, false, r);
+        ok &= expect(ret == 0 && r == cv::Rect(100, 332, 1000, 556), "odd window aligned: " + str(r));
+
+        r = cv::Rect(-50, 900, 4000, 400);
+        ret = igv::arducam::setSelection(regs, dev, false, r);
+        ok &= expect(ret == 0 && r == cv::Rect(0, 680, 1920, 400), "window clamped to the array: " + str(r));
+
+        r = cv::Rect(0, 0, 10, 10);
+        ret = igv::arducam::setSelection(regs, dev, false, r);
+        ok &= expect(ret == 0 && r.width == igv::arducam::SEL_MIN_SIZE, "tiny window raised to the minimum: " + str(r));
+
+        // Not while streaming, the window stays
+        cv::Rect before = regs.crop();
+        regs.write(STREAM_ON, 1);
+        r = cv::Rect(0, 324, 1920, 756);
+        ret = igv::arducam::setSelection(regs, dev, regs.streaming(), r);
+        ok &= expect(ret == -EBUSY && regs.crop() == before, "refused while streaming");
+
+        // TRY while streaming: fitted into the cached bounds, no I2C, window stays
+        const uint64_t busBefore = regs.stats().reads + regs.stats().writes;
+        r = cv::Rect(101, 900, 1001, 400);
+        ret = igv::arducam::setSelection(regs, dev, regs.streaming(), r, true);
+        ok &= expect(ret == 0 && r == cv::Rect(100, 680, 1000, 400) && regs.crop() == before &&
+                     regs.stats().reads + regs.stats().writes == busBefore, "TRY fitted without register access: " + str(r));
+
+        // Bounds under SEL_MIN_SIZE: the array size, not a wider window
+        igv::arducam::Device small;
+        small.cropBounds = cv::Rect(0, 0, 40, 40);
+        small.cropBoundsValid = true;
+        r = cv::Rect(0, 0, 10, 100);
+        ret = igv::arducam::setSelection(regs, small, true, r, true);
+        ok &= expect(ret == 0 && r == cv::Rect(0, 0, 40, 40), "small array keeps its size: " + str(r));
+
+        // The firmware itself refuses writes while streaming too
+        igv::arducam::write(regs, IPC_SEL_TARGET_REG, V4L2_SEL_TGT_CROP);
+        igv::arducam::write(regs, IPC_SEL_TOP_REG, 0);
+        igv::arducam::waitForFree(regs, 2);
+        ok &= expect(regs.crop() == before, "firmware ignores window writes while streaming");
+        regs.write(STREAM_ON, 0);
+
+        // Single NACKs are absorbed by the retries
+        regs.failNext(1);
+        r = cv::Rect(0, 324, 1920, 756);
+        ret = igv::arducam::setSelection(regs, dev, false, r);
+        ok &= expect(ret == 0 && regs.crop() == cv::Rect(0, 324, 1920, 756), "one NACK retried");
+
+        // A dead bus is reported, not read as a window
+        regs.failNext(1000);
+        r = cv::Rect(0, 0, 1920, 1080);
+        ret = igv::arducam::setSelection(regs, dev, false, r);
+        ok &= expect(ret != 0, "dead bus -> error " + std::to_string(ret));
+        regs.failNext(0);
+    }
+
+    // ==================== 2: SAME ROI, SAME COORDINATES ====================
+    std::cout << "---------- pipeline coordinates ----------" << std::endl;
+    {
+        cv::Mat full(sensor, CV_8UC1);
+        for(int y = 0; y < full.rows; y++)
+            for(int x = 0; x < full.cols; x++)
+                full.at<uchar>(y, x) = (uchar)((x * 7 + y * 13) ^ (x >> 3));
+
+        // Software crop of the full frame (no sensor crop)
+        igv::SensorRoi soft = igv::pathRoi(sensor, cv::Rect(cv::Point(0, 0), sensor), full.size());
+        cv::Mat softRoi = full(soft.inFrame);
+
+        // Sensor sent only the bottom 70 %
+        cv::Rect crop(0, 324, 1920, 756);
+        cv::Mat cropped = full(crop).clone();
+        igv::SensorRoi hard = igv::pathRoi(sensor, crop, cropped.size());
+        cv::Mat hardRoi = cropped(hard.inFrame);
+
+        bool samePixels = softRoi.size() == hardRoi.size();
+        for(int y = 0; samePixels && y < softRoi.rows; y++)
+            samePixels = std::equal(softRoi.ptr<uchar>(y), softRoi.ptr<uchar>(y) + softRoi.cols, hardRoi.ptr<uchar>(y));
+
+        cv::Point p(640, 500);      // e.g. an obstacle found in the ROI
+        ok &= expect(samePixels, "same ROI pixels (" + str(soft.sensorRect()) + ")");
+        ok &= expect(hard.inFrame == cv::Rect(cv::Point(0, 0), cropped.size()), "sensor crop: ROI is the whole frame");
+        ok &= expect(soft.toSensor(p) == hard.toSensor(p) && soft.sensorRect() == hard.sensorRect(),
+                     "same sensor coordinates for ROI points");
+
+        std::cout << "         pixels per frame: " << full.total() << " -> " << cropped.total()
+                  << " (" << 100 - 100 * cropped.total() / full.total() << " % less to capture and process)" << std::endl;
+    }
+
+    // ==================== 3: CAMERA ====================
+    if(argc > 1)
+    {
+        std::cout << "---------- " << argv[1] << " ----------" << std::endl;
+        int frames = (argc > 2) ? std::atoi(argv[2]) : 300;
+        std::unique_ptr<igv::FrameSource> source = igv::openFrameSource(argv[1]);
+        if(!source || !source->isOpened())
+        {
+            std::cerr << "IGV::ERROR::Cannot open " << argv[1] << std::endl;
+            return(EXIT_FAILURE);
+        }
+
+        cv::Mat frame;
+        cv::TickMeter tm;
+        int count = 0;
+        tm.start();
+        while(count < frames && source->read(frame)) count++;
+        tm.stop();
+
+        igv::SensorRoi roi = igv::pathRoi(*source, frame.size());
+        std::cout << "Sensor                 : " << source->sensorSize().width << "x" << source->sensorSize().height << std::endl;
+        std::cout << "Crop applied           : " << str(source->sensorCrop()) << std::endl;
+        std::cout << "Frame                  : " << frame.cols << "x" << frame.rows << std::endl;
+        std::cout << "Path ROI in frame      : " << str(roi.inFrame) << " (sensor " << str(roi.sensorRect()) << ")" << std::endl;
+        std::cout << "Frame rate             : " << count / tm.getTimeSec() << " FPS" << std::endl;
+        ok &= count > 0;
+    }
+
+    std::cout << (ok ? "IGV::SENSOR ROI OK" : "IGV::ERROR::SENSOR ROI FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
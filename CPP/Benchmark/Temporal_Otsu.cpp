@@ -0,0 +1,128 @@
+/*****************************************************************************************
+ *  File Name   : Temporal_Otsu.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Temporal Otsu threshold (GrayBlurOtsu::setReuse, OtsuReuse) against a
+ *      full Otsu on every frame, on a recorded or generated sequence, path
+ *      ROI only (as the programs run it).
+ *
+ *      For every frame:
+ *          - exact threshold (every pixel, every frame) and temporal one
+ *          - full Otsu run or reused, and the drift statistic
+ *          - binary ROI pixels that differ between both
+ *      then the recompute counts (drift / period), the threshold error and
+ *      the time of both. "csv" prints the per-frame values for tuning.
+ *
+ *      A brightness step is added halfway (synthetic sources are steady):
+ *      the drift must catch it on that frame.
+ *
+ *  Usage       : ./build.sh Benchmark/Temporal_Otsu [source_spec] [frames] [step] [period] [csv]
+ *                default: synthetic:1280x720@60,fast 600 4 30
+ *                recorded: ./build.sh Benchmark/Temporal_Otsu log:run1.igvlog,fast 0 4 30 csv
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include "../igv/FrameSource.hpp"
+#include "../igv/SensorRoi.hpp"
+#include "../igv/GrayBlurOtsu.hpp"
+
+int main(int argc, char** argv)
+{
+    std::string spec = (argc > 1) ? argv[1] : "synthetic:1280x720@60,fast";
+    int frames       = (argc > 2) ? std::atoi(argv[2]) : 600;
+    igv::OtsuReuse reuse;
+    reuse.step       = (argc > 3) ? std::atoi(argv[3]) : 4;
+    reuse.period     = (argc > 4) ? std::atoi(argv[4]) : 30;
+    bool csv         = (argc > 5) && std::string(argv[5]) == "csv";
+
+    std::cout << "========== TEMPORAL OTSU BENCHMARK ==========" << std::endl;
+
+    std::unique_ptr<igv::FrameSource> source = igv::openFrameSource(spec);
+    if(!source || !source->isOpened())
+    {
+        std::cerr << "IGV::ERROR::Cannot open " << spec << std::endl;
+        return EXIT_FAILURE;
+    }
+    if(frames > 0) source->setMaxFrames(frames);
+    std::cout << source->name() << ", step " << reuse.step << ", period " << reuse.period
+              << ", bounds: mean " << reuse.maxMeanShift << " gray, split " << reuse.maxSplitShift << std::endl;
+
+    igv::GrayBlurOtsu exact, temporal;
+    temporal.setReuse(reuse);
+    cv::Mat frame, scratch, input, binExact, binTemporal, d;
+    cv::TickMeter tExact, tTemporal;
+    int n = 0, maxErr = 0, stepFrame = -1;
+    double sumErr = 0, mismatch = 0;
+    bool caughtStep = true;
+
+    if(csv) std::cout << "frame,exact,temporal,recomputed,drift,mismatch_pct" << std::endl;
+    while(source->read(frame))
+    {
+        input = (frame.channels() == 3) ? frame : igv::lumaView(frame, source->format(), scratch);
+        cv::Rect roi = igv::pathRoi(*source, input.size(), 0.3).inFrame;
+        if(roi.empty()) continue;
+
+        // Lighting change halfway through (+40 gray)
+        if(frames > 0 && n >= frames / 2)
+        {
+            cv::Mat brighter;
+            input.convertTo(brighter, -1, 1.0, 40);
+            input = brighter;
+            if(stepFrame < 0) stepFrame = n;
+        }
+
+        tExact.start();
+        exact.apply(input, binExact, roi);
+        tExact.stop();
+
+        tTemporal.start();
+        temporal.apply(input, binTemporal, roi);
+        tTemporal.stop();
+
+        int err = std::abs(exact.threshold() - temporal.threshold());
+        sumErr += err;
+        maxErr = std::max(maxErr, err);
+        cv::absdiff(binExact, binTemporal, d);
+        double pct = 100.0 * cv::countNonZero(d) / (double)roi.area();
+        mismatch += pct;
+        if(n == stepFrame) caughtStep = temporal.recomputed();
+
+        if(csv)
+            std::cout << n << "," << exact.threshold() << "," << temporal.threshold() << ","
+                      << temporal.recomputed() << "," << std::setprecision(3) << temporal.drift()
+                      << "," << pct << std::endl;
+        n++;
+    }
+
+    if(n == 0)
+    {
+        std::cerr << "IGV::ERROR::No frames" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const igv::OtsuCounters& c = temporal.counters();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Otsu every frame       : " << tExact.getTimeMilli() / n << " ms/frame" << std::endl;
+    std::cout << "Temporal               : " << tTemporal.getTimeMilli() / n << " ms/frame" << std::endl;
+    std::cout << "Full Otsu runs         : " << c.recomputes << " / " << c.frames
+              << " (drift " << c.onDrift << ", period " << c.onPeriod << ")" << std::endl;
+    std::cout << "Threshold error        : mean " << sumErr / n << ", max " << maxErr << std::endl;
+    std::cout << "Binary pixels differing: " << mismatch / n << " % (mean)" << std::endl;
+
+    bool ok = c.frames == (uint64_t)n && c.recomputes < c.frames && (stepFrame < 0 || caughtStep);
+    if(stepFrame >= 0) std::cout << "Brightness step frame " << stepFrame << ": "
+                                 << (caughtStep ? "recomputed" : "MISSED") << std::endl;
+    std::cout << (ok ? "IGV::TEMPORAL OTSU OK" : "IGV::ERROR::TEMPORAL OTSU FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
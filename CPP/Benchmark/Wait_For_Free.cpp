@@ -0,0 +1,155 @@
+/*****************************************************************************************
+ *  File Name   : Wait_For_Free.cpp
+ *  Project     : IGV Vision System - Benchmarks
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Size only), V4L2
+ *
+ *  Description :
+ *      Adaptive wait_for_free() of the Arducam driver (arducam_wait.h) against
+ *      the fixed "msleep(interval)" polling it replaced, on the register mock
+ *      (igv/ArducamRegisterModel.hpp) with simulated firmware busy times.
+ *
+ *      1. One command, busy 0 .. 40 ms, every interval the driver uses:
+ *         time until the driver sees the firmware idle, polls
+ *      2. A firmware that never gets idle: both give up after ~1 s
+ *      3. Stream on (STREAM_ON + every control again, each waited for):
+ *         time from VIDIOC_STREAMON to the sensor streaming with its
+ *         controls applied, fixed vs adaptive
+ *      4. The wait statistics the driver shows in debugfs (wait_stats)
+ *
+ *      Nothing sleeps: the mock's clock advances with the I2C transfers and
+ *      the driver's sleeps.
+ *
+ *  Usage       : ./build.sh Benchmark/Wait_For_Free
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+*****************************************************************************************/
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include "../igv/ArducamRegisterModel.hpp"
+
+namespace arducam = igv::arducam;
+
+static bool expect(bool cond, const std::string& what)
+{
+    std::cout << (cond ? "  ok   " : "  FAIL ") << what << std::endl;
+    return cond;
+}
+
+// Time from the command write to the driver seeing the firmware idle
+static uint32_t commandWait(uint64_t busyUs, int interval, bool fixed, uint32_t& polls)
+{
+    arducam::RegisterModel bus(cv::Size(1920, 1080));
+    bus.setBusyTime(CTRL_VALUE_REG, busyUs);
+    arducam_wait_stats waits = {};
+    arducam::Client c(bus, nullptr, &waits);
+    c.fixedWait = fixed;
+
+    arducam::write(c, CTRL_ID_REG, V4L2_CID_EXPOSURE);
+    arducam::write(c, CTRL_VALUE_REG, 1000);
+    uint32_t us = arducam::waitForFree(c, interval);
+    polls = (uint32_t)waits.polls;
+    return us;
+}
+
+// probe + set_fmt, then the time one stream on takes
+static double streamOnMs(bool fixed, arducam_wait_stats& waits)
+{
+    arducam::RegisterModel bus(cv::Size(1920, 1080));
+    bus.setBusyTime(STREAM_ON, 3000);
+    bus.setBusyTime(CTRL_VALUE_REG, 300);
+    bus.setBusyTime(IPC_SEL_TARGET_REG, 200);
+    std::unique_ptr<arducam_regcache> regs(new arducam_regcache());
+    arducam_regcache_init(regs.get(), true);
+
+    arducam::Client c(bus, regs.get(), nullptr);
+    c.fixedWait = fixed;
+    arducam::Device dev;
+    arducam::probe(c, dev);
+    arducam::setFmt(c, dev, 0, 0);
+
+    c.waits = &waits;
+    uint64_t start = bus.now();
+    arducam::startStreaming(c, dev);
+    return (bus.now() - start) / 1000.0;
+}
+
+int main()
+{
+    std::cout << "========== WAIT FOR FREE BENCHMARK ==========" << std::endl;
+    bool ok = true;
+
+    // ==================== 1: ONE COMMAND ====================
+    std::cout << "---------- one command (I2C transfer " << arducam::RegisterModel(cv::Size(64, 64)).transferTime()
+              << " us) ----------" << std::endl;
+    std::cout << std::setw(10) << "busy us" << std::setw(10) << "interval"
+              << std::setw(14) << "fixed us" << std::setw(8) << "polls"
+              << std::setw(14) << "adaptive us" << std::setw(8) << "polls" << std::endl;
+
+    bool shortFaster = true, longSame = true, closeToBusy = true;
+    for(int interval : { 1, 2, 5 })
+    {
+        for(uint64_t busy : { 0, 100, 300, 1000, 3000, 10000, 40000 })
+        {
+            uint32_t pFixed, pAdaptive;
+            uint32_t fixed = commandWait(busy, interval, true, pFixed);
+            uint32_t adaptive = commandWait(busy, interval, false, pAdaptive);
+            std::cout << std::setw(10) << busy << std::setw(10) << interval
+                      << std::setw(14) << fixed << std::setw(8) << pFixed
+                      << std::setw(14) << adaptive << std::setw(8) << pAdaptive << std::endl;
+
+            // Shorter than the interval: no more rounding up to it. Longer: both
+            // poll every interval once the backoff got there, only the phase differs
+            if(busy < (uint64_t)interval * 1000) shortFaster &= adaptive <= fixed;
+            else longSame &= adaptive <= fixed + interval * 1000;
+            // Late by at most one backoff step (itself at most the time already waited, and the interval)
+            closeToBusy &= adaptive <= busy + std::min<uint64_t>(busy, interval * 1000) + ARDUCAM_WAIT_TIGHT_SLEEP_US + 2 * 135;
+        }
+    }
+    ok &= expect(shortFaster, "commands shorter than the interval: adaptive never slower");
+    ok &= expect(longSame, "longer commands: adaptive within one interval of fixed");
+    ok &= expect(closeToBusy, "adaptive sees idle within one backoff step of the firmware");
+
+    // ==================== 2: STUCK FIRMWARE ====================
+    std::cout << "---------- firmware never idle ----------" << std::endl;
+    for(bool fixed : { true, false })
+    {
+        uint32_t polls;
+        uint32_t us = commandWait(10000000, 1, fixed, polls);
+        std::cout << "         " << (fixed ? "fixed   " : "adaptive") << ": gives up after "
+                  << us / 1000 << " ms, " << polls << " polls" << std::endl;
+        ok &= expect(us >= 900000 && us <= 1500000, std::string(fixed ? "fixed" : "adaptive") + " times out after ~1 s");
+    }
+
+    // ==================== 3: STREAM ON ====================
+    std::cout << "---------- stream on (STREAM_ON busy 3 ms, controls 300 us) ----------" << std::endl;
+    arducam_wait_stats fixedWaits = {}, adaptiveWaits = {};
+    double fixedMs = streamOnMs(true, fixedWaits);
+    double adaptiveMs = streamOnMs(false, adaptiveWaits);
+    std::cout << "Stream on, fixed        : " << std::fixed << std::setprecision(2) << fixedMs << " ms ("
+              << fixedWaits.calls << " waits, " << fixedWaits.polls << " polls)" << std::endl;
+    std::cout << "Stream on, adaptive     : " << adaptiveMs << " ms ("
+              << adaptiveWaits.calls << " waits, " << adaptiveWaits.polls << " polls)" << std::endl;
+    ok &= expect(adaptiveMs < fixedMs, "stream on faster: " + std::to_string((int)(100 - 100 * adaptiveMs / fixedMs)) + " % less");
+    ok &= expect(adaptiveWaits.timeouts == 0 && adaptiveWaits.calls == fixedWaits.calls, "same waits, no timeout");
+
+    // ==================== 4: DEBUGFS VIEW ====================
+    std::cout << "---------- wait_stats (adaptive stream on) ----------" << std::endl;
+    const arducam_wait_stats& s = adaptiveWaits;
+    std::cout << "calls " << s.calls << ", timeouts " << s.timeouts << ", polls " << s.polls
+              << ", total " << s.total_us << " us, mean " << (s.calls ? s.total_us / s.calls : 0)
+              << " us, max " << s.max_us << " us" << std::endl;
+    for(int i = 0; i < ARDUCAM_WAIT_HIST; i++)
+        std::cout << (i < ARDUCAM_WAIT_HIST - 1 ? "< " : ">=") << std::setw(5)
+                  << (i < ARDUCAM_WAIT_HIST - 1 ? 125 << i : 125 << (i - 1)) << " us: " << s.hist[i] << std::endl;
+
+    std::cout << (ok ? "IGV::WAIT FOR FREE OK" : "IGV::ERROR::WAIT FOR FREE FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
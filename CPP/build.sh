@@ -2,23 +2,33 @@
 
 # ==============================
 # OpenCV Build Script
-# Usage: ./build.sh <filename_without_extension>
+# Usage: ./build.sh <filename_without_extension> [program arguments...]
 # Example: ./build.sh 04-Blur_demo
+#          ./build.sh Benchmark/Capture_Ring video.mp4
 # ==============================
 
 clear
 
-if [ $# -ne 1 ]; then
-    echo "Usage: ./build.sh <filename_without_extension>"
+if [ $# -lt 1 ]; then
+    echo "Usage: ./build.sh <filename_without_extension> [program arguments...]"
     exit 1
 fi
 
 SRC="$1.cpp"
 OUT="$1"
+shift
+
+# Native appsink reader (igv/GstAppSink.hpp) when the GStreamer dev packages exist
+GST_FLAGS=""
+if pkg-config --exists gstreamer-app-1.0 gstreamer-video-1.0; then
+    GST_FLAGS="-DIGV_WITH_GSTREAMER `pkg-config --cflags --libs gstreamer-app-1.0 gstreamer-video-1.0`"
+fi
 
 # Compile
 sudo systemctl restart nvargus-daemon
-g++ "$SRC" -o "$OUT" `pkg-config --cflags --libs opencv4`
+# -pthread      : igv/CaptureRing.hpp runs the grabber on its own thread
+# -march=native : SIMD kernels (igv/Simd.hpp) use the best set of this CPU
+g++ -std=c++17 -O3 -march=native -pthread "$SRC" -o "$OUT" `pkg-config --cflags --libs opencv4` $GST_FLAGS
 
 # Check compile status
 if [ $? -ne 0 ]; then
@@ -29,7 +39,7 @@ fi
 echo "=================================== Build successful ==================================="
 
 # Run
-./"$OUT"
+./"$OUT" "$@"
 
 rm $OUT
 
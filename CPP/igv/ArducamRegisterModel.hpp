@@ -0,0 +1,770 @@
+/*****************************************************************************************
+ *  File Name   : ArducamRegisterModel.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Rect only), V4L2
+ *
+ *  Description :
+ *      Mock of the Arducam Pivariety I2C register interface, to check the
+ *      driver's register sequences (Arducam-Pivariety-V4L2-Driver-master/
+ *      src/arducam.c) without a camera.
+ *
+ *      The register map and the driver's shadow cache are the driver's own
+ *      headers (arducam.h, arducam_regcache.h), built here in user space.
+ *
+ *      Firmware model:
+ *          DEVICE_ID/VERSION_REG   identification
+ *          PIXFORMAT_INDEX_REG     selects the format PIXFORMAT_TYPE/ORDER_REG and
+ *                                  MIPI_LANES_REG describe (NO_DATA_AVAILABLE past
+ *                                  the end of the table)
+ *          RESOLUTION_INDEX_REG    selects the FORMAT_WIDTH/HEIGHT_REG entry of that
+ *                                  format; both indexes together are the mode
+ *          CTRL_INDEX_REG / CTRL_ID_REG
+ *                                  select a control by position / by id
+ *          CTRL_MIN/MAX/STEP/DEF_REG
+ *                                  its range in the current mode; frame rate max
+ *                                  depends on the resolution, vblank and exposure
+ *                                  on the resolution and the frame rate value
+ *          CTRL_VALUE_REG          sets the selected control (clamped to its range),
+ *                                  0 only refreshes the range (what the driver
+ *                                  writes before reading one)
+ *          IPC_SEL_TARGET_REG      selects what IPC_SEL_* read back:
+ *                                  V4L2_SEL_TGT_CROP -> current window,
+ *                                  CROP_BOUNDS / CROP_DEFAULT / NATIVE_SIZE -> pixel array
+ *          IPC_SEL_TOP/LEFT/WIDTH/HEIGHT_REG
+ *                                  written with target CROP: new window, taken
+ *                                  over when the firmware is idle again; refused
+ *                                  while streaming or outside the pixel array
+ *          SYSTEM_IDLE_REG         non-zero after a command (STREAM_ON, CTRL_VALUE_REG,
+ *                                  IPC_SEL_*) for "busyPolls" reads, or for the
+ *                                  time setBusyTime() gives that command;
+ *                                  IPC_SEL_* read NO_DATA_AVAILABLE meanwhile
+ *          STREAM_ON               streaming on / off
+ *
+ *      Every transaction is counted, and failNext(n) makes the next n fail
+ *      (NACK) to exercise the retry / error paths.
+ *
+ *      Time is simulated: each transaction takes transferTime() (6 bytes at
+ *      400 kHz by default) and the driver's sleeps advance the clock
+ *      (sleep()), so waits are measured without a camera and without sleeping.
+ *
+ *      The functions below the model perform the register sequences of their
+ *      arducam.c counterparts step for step (named in front of each); keep the
+ *      two in sync. With a Client that carries an arducam_regcache they read
+ *      through the cache and count transactions per operation like the driver.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+*****************************************************************************************/
+
+#ifndef IGV_ARDUCAM_REGISTER_MODEL_HPP
+#define IGV_ARDUCAM_REGISTER_MODEL_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <linux/videodev2.h>
+
+// Kernel types the driver headers use
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+#include "../../Arducam-Pivariety-V4L2-Driver-master/src/arducam.h"
+#include "../../Arducam-Pivariety-V4L2-Driver-master/src/arducam_regcache.h"
+#include "../../Arducam-Pivariety-V4L2-Driver-master/src/arducam_wait.h"
+
+namespace igv
+{
+
+namespace arducam
+{
+    // arducam.c
+    constexpr int SEL_ALIGN                = 2;
+    constexpr int SEL_MIN_SIZE             = 64;
+
+    // ==================== FIRMWARE MODEL ====================
+    class RegisterModel
+    {
+    public:
+        struct Stats
+        {
+            uint64_t reads = 0;
+            uint64_t writes = 0;
+            uint64_t failures = 0;      // NACKed transactions (failNext)
+        };
+
+        struct Format
+        {
+            uint32_t dataType;          // enum image_dt
+            uint32_t order;             // enum bayer_order
+            std::vector<cv::Size> resolutions;
+            uint32_t pixelRate;         // V4L2_CID_PIXEL_RATE of this format
+        };
+
+        struct Range
+        {
+            uint32_t min, max, step, def;
+        };
+
+        // Default firmware: Y10 and RAW8 mono, three resolutions each
+        explicit RegisterModel(cv::Size pixelArray, int busyPolls = 2)
+            : RegisterModel(pixelArray, {
+                  { IMAGE_DT_RAW10, BAYER_ORDER_GRAY, { pixelArray, cv::Size(1280, 720), cv::Size(640, 480) }, 148500000 },
+                  { IMAGE_DT_RAW8,  BAYER_ORDER_GRAY, { pixelArray, cv::Size(1280, 720), cv::Size(640, 480) }, 185625000 } },
+                  busyPolls)
+        {
+        }
+
+        RegisterModel(cv::Size pixelArray, std::vector<Format> formats, int busyPolls = 2)
+            : array_(0, 0, pixelArray.width, pixelArray.height),
+              crop_(array_),
+              pending_(array_),
+              busyPolls_(busyPolls),
+              formats_(std::move(formats))
+        {
+            for(uint32_t id : controlIds()) values_[id] = range(id).def;
+        }
+
+        // One I2C transaction each. false: NACK (nothing happened)
+        bool write(uint16_t reg, uint32_t value)
+        {
+            stats_.writes++;
+            now_ += transferUs_;
+            if(nack()) return false;
+            regs_[reg] = value;
+
+            switch(reg)
+            {
+            case STREAM_ON:
+                streaming_ = (value != 0);
+                command(reg);
+                break;
+            case PIXFORMAT_INDEX_REG:
+                pixfmt_ = value;
+                break;
+            case RESOLUTION_INDEX_REG:
+                res_ = value;
+                break;
+            case CTRL_INDEX_REG:
+                ctrl_ = (value < controlIds().size()) ? controlIds()[value] : NO_DATA_AVAILABLE;
+                break;
+            case CTRL_ID_REG:
+                ctrl_ = values_.count(value) ? value : NO_DATA_AVAILABLE;
+                break;
+            case CTRL_VALUE_REG:
+                if(ctrl_ != NO_DATA_AVAILABLE && value != 0)
+                {
+                    Range r = range(ctrl_);
+                    values_[ctrl_] = std::min(std::max(value, r.min), r.max);
+                }
+                command(reg);
+                break;
+            case IPC_SEL_TARGET_REG:
+                target_ = value;
+                command(reg);
+                break;
+            case IPC_SEL_TOP_REG:
+            case IPC_SEL_LEFT_REG:
+            case IPC_SEL_WIDTH_REG:
+            case IPC_SEL_HEIGHT_REG:
+                if(target_ != V4L2_SEL_TGT_CROP || streaming_) break;
+                if(reg == IPC_SEL_TOP_REG) pending_.y = (int)value;
+                if(reg == IPC_SEL_LEFT_REG) pending_.x = (int)value;
+                if(reg == IPC_SEL_WIDTH_REG) pending_.width = (int)value;
+                if(reg == IPC_SEL_HEIGHT_REG) pending_.height = (int)value;
+                dirty_ = true;
+                command(reg);
+                break;
+            }
+            return true;
+        }
+
+        bool read(uint16_t reg, uint32_t& value)
+        {
+            stats_.reads++;
+            now_ += transferUs_;
+            if(nack()) return false;
+
+            const Format* fmt = (pixfmt_ < formats_.size()) ? &formats_[pixfmt_] : nullptr;
+            const bool res = fmt && res_ < fmt->resolutions.size();
+            const bool ctrl = ctrl_ != NO_DATA_AVAILABLE;
+
+            switch(reg)
+            {
+            case DEVICE_ID_REG:                 value = DEVICE_ID; return true;
+            case DEVICE_VERSION_REG:            value = 0x0102; return true;
+            case SENSOR_ID_REG:                 value = 0x0462; return true;
+            case FLIPS_DONT_CHANGE_ORDER_REG:   value = 1; return true;
+            case PIXFORMAT_TYPE_REG:            value = fmt ? fmt->dataType : NO_DATA_AVAILABLE; return true;
+            case PIXFORMAT_ORDER_REG:           value = fmt ? fmt->order : NO_DATA_AVAILABLE; return true;
+            case MIPI_LANES_REG:                value = fmt ? 2 : NO_DATA_AVAILABLE; return true;
+            case FORMAT_WIDTH_REG:              value = res ? (uint32_t)fmt->resolutions[res_].width : NO_DATA_AVAILABLE; return true;
+            case FORMAT_HEIGHT_REG:             value = res ? (uint32_t)fmt->resolutions[res_].height : NO_DATA_AVAILABLE; return true;
+            case CTRL_ID_REG:                   value = ctrl_; return true;
+            case CTRL_MIN_REG:                  value = ctrl ? range(ctrl_).min : NO_DATA_AVAILABLE; return true;
+            case CTRL_MAX_REG:                  value = ctrl ? range(ctrl_).max : NO_DATA_AVAILABLE; return true;
+            case CTRL_STEP_REG:                 value = ctrl ? range(ctrl_).step : NO_DATA_AVAILABLE; return true;
+            case CTRL_DEF_REG:                  value = ctrl ? range(ctrl_).def : NO_DATA_AVAILABLE; return true;
+            case CTRL_VALUE_REG:                value = ctrl ? values_[ctrl_] : NO_DATA_AVAILABLE; return true;
+            case SYSTEM_IDLE_REG:
+                if(busy_ > 0) busy_--;
+                if(!busy()) apply();
+                value = busy() ? 1 : 0;
+                return true;
+            case IPC_SEL_TOP_REG:
+            case IPC_SEL_LEFT_REG:
+            case IPC_SEL_WIDTH_REG:
+            case IPC_SEL_HEIGHT_REG:
+            {
+                cv::Rect r;
+                if(busy() || !selection(r))
+                {
+                    value = NO_DATA_AVAILABLE;
+                    return true;
+                }
+                value = (reg == IPC_SEL_TOP_REG)   ? (uint32_t)r.y :
+                        (reg == IPC_SEL_LEFT_REG)  ? (uint32_t)r.x :
+                        (reg == IPC_SEL_WIDTH_REG) ? (uint32_t)r.width : (uint32_t)r.height;
+                return true;
+            }
+            default:
+            {
+                auto it = regs_.find(reg);
+                value = (it == regs_.end()) ? NO_DATA_AVAILABLE : it->second;
+                return true;
+            }
+            }
+        }
+
+        // Controls the firmware reports, in CTRL_INDEX_REG order
+        static const std::vector<uint32_t>& controlIds()
+        {
+            static const std::vector<uint32_t> ids = {
+                V4L2_CID_ARDUCAM_FRAME_RATE, V4L2_CID_EXPOSURE, V4L2_CID_ANALOGUE_GAIN,
+                V4L2_CID_HBLANK, V4L2_CID_VBLANK, V4L2_CID_PIXEL_RATE,
+                V4L2_CID_HFLIP, V4L2_CID_VFLIP };
+            return ids;
+        }
+
+        // Range of control "id" in the current mode with the current values
+        Range range(uint32_t id) const
+        {
+            const Format& fmt = formats_[std::min<size_t>(pixfmt_, formats_.size() - 1)];
+            cv::Size size = fmt.resolutions[std::min<size_t>(res_, fmt.resolutions.size() - 1)];
+            const uint32_t lineLength = (uint32_t)size.width + 280;
+            const uint32_t maxFps = std::max<uint32_t>(1, fmt.pixelRate / (lineLength * ((uint32_t)size.height + 16)));
+            auto value = [&](uint32_t cid, uint32_t def)
+            {
+                auto it = values_.find(cid);
+                return (it == values_.end()) ? def : it->second;
+            };
+            const uint32_t fps = std::min(value(V4L2_CID_ARDUCAM_FRAME_RATE, 30u), maxFps);
+            const uint32_t frameLines = fmt.pixelRate / (lineLength * fps);
+
+            switch(id)
+            {
+            case V4L2_CID_ARDUCAM_FRAME_RATE:   return { 1, maxFps, 1, std::min(30u, maxFps) };
+            case V4L2_CID_EXPOSURE:             return { 4, frameLines - 4, 1, std::min(1000u, frameLines - 4) };
+            case V4L2_CID_ANALOGUE_GAIN:        return { 100, 1600, 1, 100 };
+            case V4L2_CID_HBLANK:               return { 280, 280, 1, 280 };
+            case V4L2_CID_VBLANK:               return { 16, 65535 - (uint32_t)size.height, 1, frameLines - (uint32_t)size.height };
+            case V4L2_CID_PIXEL_RATE:           return { fmt.pixelRate, fmt.pixelRate, 1, fmt.pixelRate };
+            default:                            return { 0, 1, 1, 0 };
+            }
+        }
+
+        uint32_t value(uint32_t id) const { return values_.at(id); }
+        const std::vector<Format>& formats() const { return formats_; }
+
+        void failNext(int n) { failNext_ = n; }
+
+        // Commands written to "reg" keep the firmware busy for "us" (simulated)
+        // instead of busyPolls reads
+        void setBusyTime(uint16_t reg, uint64_t us) { busyUs_[reg] = us; }
+        void setTransferTime(uint64_t us) { transferUs_ = us; }
+        uint64_t transferTime() const { return transferUs_; }
+
+        // Simulated clock, us
+        uint64_t now() const { return now_; }
+        void sleep(uint64_t us) { now_ += us; }
+
+        cv::Rect pixelArray() const { return array_; }
+        cv::Rect crop() const { return crop_; }
+        bool streaming() const { return streaming_; }
+        Stats stats() const { return stats_; }
+        void resetStats() { stats_ = Stats(); }
+
+    private:
+        void command(uint16_t reg)
+        {
+            auto it = busyUs_.find(reg);
+            if(it != busyUs_.end()) busyUntil_ = now_ + it->second;
+            else busy_ = busyPolls_;
+        }
+
+        bool busy() const { return busy_ > 0 || now_ < busyUntil_; }
+
+        bool nack()
+        {
+            if(failNext_ <= 0) return false;
+            failNext_--;
+            stats_.failures++;
+            return true;
+        }
+
+        // Rectangle IPC_SEL_* report for the current target
+        bool selection(cv::Rect& r) const
+        {
+            switch(target_)
+            {
+            case V4L2_SEL_TGT_CROP:         r = crop_;  return true;
+            case V4L2_SEL_TGT_CROP_DEFAULT:
+            case V4L2_SEL_TGT_CROP_BOUNDS:
+            case V4L2_SEL_TGT_NATIVE_SIZE:  r = array_; return true;
+            default:                        return false;
+            }
+        }
+
+        // Firmware takes over the written window when it is valid
+        void apply()
+        {
+            if(!dirty_) return;
+            dirty_ = false;
+            if(pending_.width > 0 && pending_.height > 0 && (pending_ & array_) == pending_)
+                crop_ = pending_;
+            else
+                pending_ = crop_;
+        }
+
+        cv::Rect array_;
+        cv::Rect crop_;
+        cv::Rect pending_;
+        uint32_t target_ = V4L2_SEL_TGT_CROP;
+        bool dirty_ = false;
+        bool streaming_ = false;
+        int busyPolls_;
+        int busy_ = 0;
+        std::map<uint16_t, uint64_t> busyUs_;
+        uint64_t busyUntil_ = 0;
+        uint64_t transferUs_ = 135;
+        uint64_t now_ = 0;
+        int failNext_ = 0;
+        std::vector<Format> formats_;
+        uint32_t pixfmt_ = 0;
+        uint32_t res_ = 0;
+        uint32_t ctrl_ = NO_DATA_AVAILABLE;
+        std::map<uint32_t, uint32_t> values_;
+        std::map<uint16_t, uint32_t> regs_;
+        Stats stats_;
+    };
+
+    // ==================== DRIVER SEQUENCES (arducam.c) ====================
+    // The bus plus, optionally, the driver's register cache and wait statistics
+    // (struct arducam.regs / .waits). fixedWait: wait_for_free() as it was
+    // before arducam_wait.h (interval ms between polls), for comparison
+    struct Client
+    {
+        Client(RegisterModel& bus, arducam_regcache* regs = nullptr, arducam_wait_stats* waits = nullptr)
+            : bus(bus), regs(regs), waits(waits) {}
+        RegisterModel& bus;
+        arducam_regcache* regs;
+        arducam_wait_stats* waits;
+        bool fixedWait = false;
+    };
+
+    // arducam_read() / arducam_write(): retried, 0 or -1
+    inline int read(Client c, uint16_t reg, uint32_t& value)
+    {
+        if(c.regs && arducam_regcache_lookup(c.regs, reg, &value)) return 0;
+        for(int i = 0; i < I2C_READ_RETRY_COUNT; i++)
+        {
+            bool ok = c.bus.read(reg, value);
+            if(c.regs) c.regs->stats.reads++;
+            if(ok)
+            {
+                if(c.regs) arducam_regcache_store(c.regs, reg, value);
+                return 0;
+            }
+            if(c.regs) c.regs->stats.failures++;
+        }
+        return -1;
+    }
+
+    inline int write(Client c, uint16_t reg, uint32_t value)
+    {
+        for(int i = 0; i < I2C_WRITE_RETRY_COUNT; i++)
+        {
+            bool ok = c.bus.write(reg, value);
+            if(c.regs) c.regs->stats.writes++;
+            if(ok)
+            {
+                if(c.regs) arducam_regcache_write(c.regs, reg, value, true);
+                return 0;
+            }
+            if(c.regs) c.regs->stats.failures++;
+        }
+        if(c.regs) arducam_regcache_write(c.regs, reg, value, false);
+        return -1;
+    }
+
+    // wait_for_free(): poll SYSTEM_IDLE_REG, tight then backing off to "interval"
+    // ms, 1 s at most. Returns the time waited (us)
+    inline uint32_t waitForFree(Client c, int interval)
+    {
+        const uint64_t start = c.bus.now();
+        uint32_t elapsed = 0, sleepUs = 0, count = 0, value;
+        bool idle = false;
+
+        while(c.fixedWait ? count < (uint32_t)(1000 / interval) : elapsed < ARDUCAM_WAIT_TIMEOUT_US)
+        {
+            int ret = read(c, SYSTEM_IDLE_REG, value);
+            count++;
+            if(!ret && !value) { idle = true; break; }
+            sleepUs = c.fixedWait ? interval * 1000 : arducam_wait_next_us(elapsed, sleepUs, interval * 1000);
+            c.bus.sleep(sleepUs);
+            elapsed = (uint32_t)(c.bus.now() - start);
+        }
+        elapsed = (uint32_t)(c.bus.now() - start);
+
+        if(c.waits) arducam_wait_account(c.waits, nullptr, elapsed, count, !idle);
+        if(c.regs) c.regs->stats.wait_us += elapsed;
+        return elapsed;
+    }
+
+    // What the driver learnt from the firmware (struct arducam)
+    struct Device
+    {
+        struct Format
+        {
+            uint32_t dataType, order;
+            std::vector<cv::Size> resolutions;
+        };
+        struct Control
+        {
+            uint32_t id, min, max, step, def, value;
+        };
+
+        std::vector<Format> formats;
+        std::vector<Control> controls;
+        uint32_t lanes = 0;
+        bool bayerOrderVolatile = false;
+        cv::Rect cropBounds;                // Last CROP_BOUNDS read (TRY requests)
+        bool cropBoundsValid = false;
+
+        Control* control(uint32_t id)
+        {
+            for(Control& ctrl : controls) if(ctrl.id == id) return &ctrl;
+            return nullptr;
+        }
+    };
+
+    // arducam_read_sel()
+    inline int readSel(Client c, cv::Rect& r)
+    {
+        uint32_t top = 0, left = 0, width = 0, height = 0;
+        int ret = 0;
+        ret += read(c, IPC_SEL_TOP_REG, top);
+        ret += read(c, IPC_SEL_LEFT_REG, left);
+        ret += read(c, IPC_SEL_WIDTH_REG, width);
+        ret += read(c, IPC_SEL_HEIGHT_REG, height);
+        if(ret || top == NO_DATA_AVAILABLE || left == NO_DATA_AVAILABLE ||
+           width == NO_DATA_AVAILABLE || height == NO_DATA_AVAILABLE) return -EINVAL;
+        r = cv::Rect((int)left, (int)top, (int)width, (int)height);
+        return 0;
+    }
+
+    // arducam_read_bounds(): pixel array from the firmware, cached for TRY
+    inline int readBounds(Client c, Device& dev, cv::Rect& bounds)
+    {
+        if(write(c, IPC_SEL_TARGET_REG, V4L2_SEL_TGT_CROP_BOUNDS)) return -EINVAL;
+        waitForFree(c, 2);
+        int ret = readSel(c, bounds);
+        if(ret) return ret;
+        dev.cropBounds = bounds;
+        dev.cropBoundsValid = true;
+        return 0;
+    }
+
+    // arducam_try_bounds(): no register access. The cached bounds, or before
+    // the first read the largest resolution the firmware listed
+    inline cv::Rect tryBounds(const Device& dev)
+    {
+        if(dev.cropBoundsValid) return dev.cropBounds;
+        cv::Rect bounds;
+        for(const Device::Format& f : dev.formats)
+            for(const cv::Size& res : f.resolutions)
+            {
+                bounds.width = std::max(bounds.width, res.width);
+                bounds.height = std::max(bounds.height, res.height);
+            }
+        return bounds;
+    }
+
+    // Minimum first, then the bound: a pixel array under SEL_MIN_SIZE gives
+    // its own size, never a window wider than the array
+    inline int clampSel(int v, int bound)
+    {
+        return std::min(std::max(v, SEL_MIN_SIZE), bound);
+    }
+
+    // arducam_set_selection() (V4L2_SEL_TGT_CROP): "r" in, fitted window out.
+    // tryOnly (V4L2_SUBDEV_FORMAT_TRY): fitted into tryBounds() without a
+    // register access, also while streaming. Otherwise applied and read back.
+    inline int setSelection(Client c, Device& dev, bool streaming, cv::Rect& r, bool tryOnly = false)
+    {
+        arducam_i2c_stats snap = {};
+        if(c.regs) arducam_op_begin(c.regs, &snap);
+
+        int ret = 0;
+        cv::Rect bounds, rect;
+        if(tryOnly)
+        {
+            bounds = tryBounds(dev);
+        }
+        else
+        {
+            // The window cannot move while frames are on the wire
+            ret = streaming ? -EBUSY : readBounds(c, dev, bounds);
+            if(ret) goto out;
+        }
+
+        rect.width = clampSel(r.width / SEL_ALIGN * SEL_ALIGN, bounds.width);
+        rect.height = clampSel(r.height / SEL_ALIGN * SEL_ALIGN, bounds.height);
+        rect.x = std::min(std::max(r.x, bounds.x), bounds.x + bounds.width - rect.width);
+        rect.y = std::min(std::max(r.y, bounds.y), bounds.y + bounds.height - rect.height);
+        rect.x = rect.x / SEL_ALIGN * SEL_ALIGN;
+        rect.y = rect.y / SEL_ALIGN * SEL_ALIGN;
+
+        if(tryOnly)
+        {
+            r = rect;
+            goto out;
+        }
+
+        ret = -EIO;
+        if(write(c, IPC_SEL_TARGET_REG, V4L2_SEL_TGT_CROP)) goto out;
+        ret = 0;
+        ret += write(c, IPC_SEL_TOP_REG, rect.y);
+        ret += write(c, IPC_SEL_LEFT_REG, rect.x);
+        ret += write(c, IPC_SEL_WIDTH_REG, rect.width);
+        ret += write(c, IPC_SEL_HEIGHT_REG, rect.height);
+        if(ret) { ret = -EIO; goto out; }
+        waitForFree(c, 2);
+
+        ret = readSel(c, r);
+    out:
+        if(c.regs) arducam_op_end(c.regs, ARDUCAM_OP_SELECTION, &snap);
+        return ret;
+    }
+
+    // arducam_get_length_of_set()
+    inline int lengthOfSet(Client c, uint16_t idxReg, uint16_t valReg)
+    {
+        int index = 0;
+        uint32_t val;
+        while(true)
+        {
+            if(write(c, idxReg, index) + read(c, valReg, val) < 0) return -1;
+            if(val == NO_DATA_AVAILABLE) break;
+            index++;
+        }
+        write(c, idxReg, 0);
+        return index;
+    }
+
+    // arducam_enum_resolution()
+    inline int enumResolution(Client c, Device::Format& format)
+    {
+        if(lengthOfSet(c, RESOLUTION_INDEX_REG, FORMAT_WIDTH_REG) < 0) return -ENODEV;
+        for(int index = 0; ; index++)
+        {
+            uint32_t width, height;
+            int ret = write(c, RESOLUTION_INDEX_REG, index);
+            ret += read(c, FORMAT_WIDTH_REG, width);
+            ret += read(c, FORMAT_HEIGHT_REG, height);
+            if(ret < 0) return -ENODEV;
+            if(width == NO_DATA_AVAILABLE || height == NO_DATA_AVAILABLE) break;
+            format.resolutions.push_back(cv::Size((int)width, (int)height));
+        }
+        write(c, RESOLUTION_INDEX_REG, 0);
+        return 0;
+    }
+
+    // arducam_enum_pixformat()
+    inline int enumPixformat(Client c, Device& dev)
+    {
+        if(lengthOfSet(c, PIXFORMAT_INDEX_REG, PIXFORMAT_TYPE_REG) < 0) return -ENODEV;
+
+        uint32_t notVolatile = 0, type, lanes = 0, order;
+        int ret = read(c, FLIPS_DONT_CHANGE_ORDER_REG, notVolatile);
+        dev.bayerOrderVolatile = (notVolatile == NO_DATA_AVAILABLE) ? true : !notVolatile;
+        if(ret < 0) return -ENODEV;
+
+        for(int index = 0; ; index++)
+        {
+            ret = write(c, PIXFORMAT_INDEX_REG, index);
+            ret += read(c, PIXFORMAT_TYPE_REG, type);
+            if(type == NO_DATA_AVAILABLE) break;
+            ret += read(c, MIPI_LANES_REG, lanes);
+            if(lanes == NO_DATA_AVAILABLE) break;
+            ret += read(c, PIXFORMAT_ORDER_REG, order);
+            if(ret < 0) return -ENODEV;
+
+            dev.formats.push_back({ type, order, {} });
+            if(enumResolution(c, dev.formats.back())) return -ENODEV;
+        }
+        write(c, PIXFORMAT_INDEX_REG, 0);
+        dev.lanes = lanes;
+        return 0;
+    }
+
+    // arducam_s_ctrl()
+    inline int sCtrl(Client c, Device::Control& ctrl, uint32_t value, bool waitUntilFree)
+    {
+        arducam_i2c_stats snap = {};
+        if(c.regs) arducam_op_begin(c.regs, &snap);
+        int ret = write(c, CTRL_ID_REG, ctrl.id);
+        ret += write(c, CTRL_VALUE_REG, value);
+        if(c.regs)
+        {
+            arducam_regcache_ctrl_set(c.regs, ctrl.id, value, !ret);
+            arducam_op_end(c.regs, ARDUCAM_OP_S_CTRL, &snap);
+        }
+        if(ret < 0) return -EINVAL;
+        ctrl.value = value;
+        if(waitUntilFree) waitForFree(c, 1);
+        else c.bus.sleep(200);          // usleep_range(200, 210)
+        return 0;
+    }
+
+    // arducam_enum_controls() + v4l2_ctrl_handler_setup()
+    inline int enumControls(Client c, Device& dev)
+    {
+        if(lengthOfSet(c, CTRL_INDEX_REG, CTRL_ID_REG) < 0) return -ENODEV;
+        for(int index = 0; ; index++)
+        {
+            uint32_t id, min, max, def, step;
+            int ret = write(c, CTRL_INDEX_REG, index);
+            write(c, CTRL_VALUE_REG, 0);
+            waitForFree(c, 1);
+
+            ret += read(c, CTRL_ID_REG, id);
+            ret += read(c, CTRL_MAX_REG, max);
+            ret += read(c, CTRL_MIN_REG, min);
+            ret += read(c, CTRL_DEF_REG, def);
+            ret += read(c, CTRL_STEP_REG, step);
+            if(ret < 0) return -ENODEV;
+            if(id == NO_DATA_AVAILABLE || max == NO_DATA_AVAILABLE || min == NO_DATA_AVAILABLE ||
+               def == NO_DATA_AVAILABLE || step == NO_DATA_AVAILABLE) break;
+            dev.controls.push_back({ id, min, max, step, def, def });
+        }
+        write(c, CTRL_INDEX_REG, 0);
+
+        for(Device::Control& ctrl : dev.controls) sCtrl(c, ctrl, ctrl.value, false);
+        return 0;
+    }
+
+    // update_control(): re-read one range after a mode change, clamp the value
+    // (__v4l2_ctrl_modify_range() calls s_ctrl when it moves)
+    inline int updateControl(Client c, Device& dev, uint32_t id)
+    {
+        uint32_t id2, min, max, def, step;
+        write(c, CTRL_ID_REG, id);
+        read(c, CTRL_ID_REG, id2);
+
+        if(!c.regs ||
+           !arducam_regcache_peek(c.regs, CTRL_MAX_REG, &max) ||
+           !arducam_regcache_peek(c.regs, CTRL_MIN_REG, &min) ||
+           !arducam_regcache_peek(c.regs, CTRL_DEF_REG, &def) ||
+           !arducam_regcache_peek(c.regs, CTRL_STEP_REG, &step))
+        {
+            write(c, CTRL_VALUE_REG, 0);
+            waitForFree(c, 1);
+        }
+        int ret = 0;
+        ret += read(c, CTRL_MAX_REG, max);
+        ret += read(c, CTRL_MIN_REG, min);
+        ret += read(c, CTRL_DEF_REG, def);
+        ret += read(c, CTRL_STEP_REG, step);
+        Device::Control* ctrl = dev.control(id);
+        if(ret < 0 || !ctrl || max == NO_DATA_AVAILABLE || min == NO_DATA_AVAILABLE ||
+           def == NO_DATA_AVAILABLE || step == NO_DATA_AVAILABLE) return -EINVAL;
+
+        ctrl->min = min; ctrl->max = max; ctrl->step = step; ctrl->def = def;
+        uint32_t value = std::min(std::max(ctrl->value, min), max);
+        if(value != ctrl->value) sCtrl(c, *ctrl, value, false);
+        return -EINVAL;                 // as the driver: the result is not used
+    }
+
+    // __arducam_csi2_set_fmt() for format "fmt", resolution "res" (update_controls())
+    inline int setFmt(Client c, Device& dev, int fmt, int res)
+    {
+        arducam_i2c_stats snap = {};
+        if(c.regs) arducam_op_begin(c.regs, &snap);
+
+        write(c, PIXFORMAT_INDEX_REG, fmt);
+        write(c, RESOLUTION_INDEX_REG, res);
+        waitForFree(c, 5);
+        updateControl(c, dev, V4L2_CID_ARDUCAM_FRAME_RATE);
+        updateControl(c, dev, V4L2_CID_HBLANK);
+        updateControl(c, dev, V4L2_CID_VBLANK);
+        updateControl(c, dev, V4L2_CID_PIXEL_RATE);
+
+        if(c.regs) arducam_op_end(c.regs, ARDUCAM_OP_SET_FMT, &snap);
+        return 0;
+    }
+
+    // arducam_start_streaming(): stream on, then every control again
+    inline int startStreaming(Client c, Device& dev)
+    {
+        arducam_i2c_stats snap = {};
+        if(c.regs) arducam_op_begin(c.regs, &snap);
+
+        int ret = write(c, STREAM_ON, 1);
+        if(!ret)
+        {
+            waitForFree(c, 2);
+            for(Device::Control& ctrl : dev.controls) ret |= sCtrl(c, ctrl, ctrl.value, true);
+            waitForFree(c, 2);
+        }
+
+        if(c.regs) arducam_op_end(c.regs, ARDUCAM_OP_STREAM_ON, &snap);
+        return ret;
+    }
+
+    // arducam_stop_streaming()
+    inline int stopStreaming(Client c)
+    {
+        return write(c, STREAM_ON, 0);
+    }
+
+    // arducam_probe(), register part
+    inline int probe(Client c, Device& dev)
+    {
+        arducam_i2c_stats snap = {};
+        if(c.regs) arducam_op_begin(c.regs, &snap);
+
+        int ret = -ENODEV;
+        uint32_t deviceId = 0, version = 0;
+        if(read(c, DEVICE_ID_REG, deviceId) || deviceId != DEVICE_ID) goto out;
+        read(c, DEVICE_VERSION_REG, version);
+        if(enumPixformat(c, dev)) goto out;
+        write(c, STREAM_ON, 1);
+        waitForFree(c, 5);
+        if(enumControls(c, dev)) goto out;
+        write(c, STREAM_ON, 0);
+        ret = 0;
+    out:
+        if(c.regs) arducam_op_end(c.regs, ARDUCAM_OP_PROBE, &snap);
+        return ret;
+    }
+}
+
+} // namespace igv
+
+#endif // IGV_ARDUCAM_REGISTER_MODEL_HPP
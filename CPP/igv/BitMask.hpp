@@ -0,0 +1,330 @@
+/*****************************************************************************************
+ *  File Name   : BitMask.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat / cv::Rect only)
+ *
+ *  Description :
+ *      Binary mask with 1 bit per pixel, for the masks the programs only
+ *      count (path zones, occupancy cells, motion pixels).
+ *
+ *          cv::Mat 0 / 255 : 1 byte per pixel, countNonZero reads every byte
+ *          BitMask         : 1 bit per pixel, count() is a popcount per
+ *                            64 pixels -> 8x less memory to write and read
+ *
+ *      Layout: row y starts at word y * wordsPerRow(), pixel x is bit x % 64
+ *      of word x / 64 (LSB first). Bits past cols are always 0, so counts and
+ *      AND / OR / XOR can work on whole words.
+ *
+ *      Kernels (AVX2 / SSE2 / NEON, scalar twins give the same bits):
+ *          packThreshold   src > thresh                (threshold / Otsu)
+ *          packNonZero     src != 0                    (existing 0/255 masks)
+ *          packAbsDiff     |a - b| > thresh            (motion mask)
+ *      and count(rect), countAll(), bitAnd / bitOr / bitXor, toMat() for
+ *      display.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_BIT_MASK_HPP
+#define IGV_BIT_MASK_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "Simd.hpp"
+
+namespace igv
+{
+
+namespace bits
+{
+    inline int popcount(uint64_t w) { return __builtin_popcountll(w); }
+
+    // Bits of "n" (<= 64) results, LSB first
+    template<typename Pred>
+    inline uint64_t packScalar(int n, Pred set)
+    {
+        uint64_t w = 0;
+        for(int i = 0; i < n; i++)
+            w |= (uint64_t)(set(i) ? 1 : 0) << i;
+        return w;
+    }
+
+#if defined(IGV_SIMD_NEON)
+    // 16 compare results (0x00 / 0xFF) -> 16 bits
+    inline uint32_t movemask(uint8x16_t m)
+    {
+        static const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        uint8x16_t b = vandq_u8(m, vld1q_u8(weights));
+        uint8x8_t s = vpadd_u8(vget_low_u8(b), vget_high_u8(b));
+        s = vpadd_u8(s, s);
+        s = vpadd_u8(s, s);
+        return (uint32_t)vget_lane_u8(s, 0) | ((uint32_t)vget_lane_u8(s, 1) << 8);
+    }
+#endif
+
+    // ==================== ROW KERNELS ====================
+    // One row of "n" pixels into "dst" words; the last word's unused bits are 0
+
+    inline void thresholdRowScalar(const uint8_t* s, uint64_t* dst, int n, int thresh, int x0 = 0)
+    {
+        for(int x = x0; x < n; x += 64)
+            dst[x / 64] = packScalar(std::min(64, n - x), [&](int i) { return s[x + i] > thresh; });
+    }
+
+    inline void nonZeroRowScalar(const uint8_t* s, uint64_t* dst, int n, int x0 = 0)
+    {
+        for(int x = x0; x < n; x += 64)
+            dst[x / 64] = packScalar(std::min(64, n - x), [&](int i) { return s[x + i] != 0; });
+    }
+
+    inline void absDiffRowScalar(const uint8_t* a, const uint8_t* b, uint64_t* dst, int n, int thresh, int x0 = 0)
+    {
+        for(int x = x0; x < n; x += 64)
+            dst[x / 64] = packScalar(std::min(64, n - x), [&](int i) { return std::abs(a[x + i] - b[x + i]) > thresh; });
+    }
+
+    // Row with every bit "value" (thresholds outside 0 .. 254)
+    inline void fillRow(uint64_t* dst, int n, bool value)
+    {
+        const int words = (n + 63) / 64;
+        std::memset(dst, value ? 0xFF : 0, words * sizeof(uint64_t));
+        if(value && (n & 63)) dst[words - 1] = (~0ULL) >> (64 - (n & 63));
+    }
+
+    // "cmp(x)" returns the compare result of 16 (SSE2 / NEON) or 32 (AVX2)
+    // pixels as a bit field; full 64-pixel words only, the rest is scalar
+#if defined(IGV_SIMD_AVX2)
+    #define IGV_BITS_WORDS(n, dst, cmp32)                                         \
+        int x = 0;                                                                \
+        for(; x <= (n) - 64; x += 64)                                             \
+            (dst)[x / 64] = (uint64_t)(uint32_t)(cmp32(x)) | ((uint64_t)(uint32_t)(cmp32(x + 32)) << 32);
+#elif defined(IGV_SIMD_SSE2) || defined(IGV_SIMD_NEON)
+    #define IGV_BITS_WORDS(n, dst, cmp16)                                         \
+        int x = 0;                                                                \
+        for(; x <= (n) - 64; x += 64)                                             \
+            (dst)[x / 64] = (uint64_t)(cmp16(x)) | ((uint64_t)(cmp16(x + 16)) << 16) | \
+                            ((uint64_t)(cmp16(x + 32)) << 32) | ((uint64_t)(cmp16(x + 48)) << 48);
+#else
+    #define IGV_BITS_WORDS(n, dst, cmp) int x = 0;
+#endif
+
+    inline void thresholdRow(const uint8_t* s, uint64_t* dst, int n, int thresh)
+    {
+        // The SIMD compares take thresh as a byte: settle the rest here
+        if(thresh < 0 || thresh >= 255)
+        {
+            fillRow(dst, n, thresh < 0);
+            return;
+        }
+#if defined(IGV_SIMD_AVX2)
+        // s > t  <=>  max(s, t + 1) == s (unsigned)
+        const __m256i t1 = _mm256_set1_epi8((char)(thresh + 1));
+        auto cmp = [&](int i) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+            return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(v, t1), v)); };
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i t1 = _mm_set1_epi8((char)(thresh + 1));
+        auto cmp = [&](int i) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+            return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, t1), v)); };
+#elif defined(IGV_SIMD_NEON)
+        const uint8x16_t t = vdupq_n_u8((uint8_t)thresh);
+        auto cmp = [&](int i) { return movemask(vcgtq_u8(vld1q_u8(s + i), t)); };
+#endif
+        IGV_BITS_WORDS(n, dst, cmp)
+        thresholdRowScalar(s, dst, n, thresh, x);
+    }
+
+    inline void nonZeroRow(const uint8_t* s, uint64_t* dst, int n)
+    {
+#if defined(IGV_SIMD_AVX2)
+        const __m256i zero = _mm256_setzero_si256();
+        auto cmp = [&](int i) {
+            return ~_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(s + i)), zero)); };
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        auto cmp = [&](int i) {
+            return (uint32_t)(~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(s + i)), zero)) & 0xFFFF); };
+#elif defined(IGV_SIMD_NEON)
+        auto cmp = [&](int i) { return movemask(vtstq_u8(vld1q_u8(s + i), vld1q_u8(s + i))); };
+#endif
+        IGV_BITS_WORDS(n, dst, cmp)
+        nonZeroRowScalar(s, dst, n, x);
+    }
+
+    inline void absDiffRow(const uint8_t* a, const uint8_t* b, uint64_t* dst, int n, int thresh)
+    {
+        // The SIMD compares take thresh as a byte: settle the rest here
+        if(thresh < 0 || thresh >= 255)
+        {
+            fillRow(dst, n, thresh < 0);
+            return;
+        }
+#if defined(IGV_SIMD_AVX2)
+        const __m256i t1 = _mm256_set1_epi8((char)(thresh + 1));
+        auto cmp = [&](int i) {
+            __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+            __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+            __m256i d = _mm256_or_si256(_mm256_subs_epu8(va, vb), _mm256_subs_epu8(vb, va));
+            return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(d, t1), d)); };
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i t1 = _mm_set1_epi8((char)(thresh + 1));
+        auto cmp = [&](int i) {
+            __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+            __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+            __m128i d = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+            return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(d, t1), d)); };
+#elif defined(IGV_SIMD_NEON)
+        const uint8x16_t t = vdupq_n_u8((uint8_t)thresh);
+        auto cmp = [&](int i) { return movemask(vcgtq_u8(vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i)), t)); };
+#endif
+        IGV_BITS_WORDS(n, dst, cmp)
+        absDiffRowScalar(a, b, dst, n, thresh, x);
+    }
+
+    #undef IGV_BITS_WORDS
+}
+
+// ==================== BIT MASK ====================
+class BitMask
+{
+public:
+    BitMask() = default;
+    BitMask(int rows, int cols) { create(rows, cols); }
+
+    // A new size starts all 0; the same size keeps the words (every pack
+    // overwrites all of them, no clearing pass per frame)
+    void create(int rows, int cols)
+    {
+        if(rows == rows_ && cols == cols_) return;
+        rows_ = rows;
+        cols_ = cols;
+        wpr_ = (cols + 63) / 64;
+        words_.assign((size_t)rows_ * wpr_, 0);
+    }
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    cv::Size size() const { return cv::Size(cols_, rows_); }
+    bool empty() const { return rows_ == 0 || cols_ == 0; }
+    int wordsPerRow() const { return wpr_; }
+    uint64_t* row(int y) { return words_.data() + (size_t)y * wpr_; }
+    const uint64_t* row(int y) const { return words_.data() + (size_t)y * wpr_; }
+    bool at(int y, int x) const { return (row(y)[x >> 6] >> (x & 63)) & 1; }
+    size_t bytes() const { return words_.size() * sizeof(uint64_t); }
+
+    // ==================== PACKING ====================
+    // bit = src > thresh (CV_8UC1)
+    void packThreshold(const cv::Mat& src, int thresh, bool simd = true)
+    {
+        CV_Assert(src.type() == CV_8UC1);
+        create(src.rows, src.cols);
+        for(int y = 0; y < rows_; y++)
+        {
+            if(simd) bits::thresholdRow(src.ptr<uint8_t>(y), row(y), cols_, thresh);
+            else bits::thresholdRowScalar(src.ptr<uint8_t>(y), row(y), cols_, thresh);
+        }
+    }
+
+    // bit = src != 0 (CV_8UC1)
+    void packNonZero(const cv::Mat& src, bool simd = true)
+    {
+        CV_Assert(src.type() == CV_8UC1);
+        create(src.rows, src.cols);
+        for(int y = 0; y < rows_; y++)
+        {
+            if(simd) bits::nonZeroRow(src.ptr<uint8_t>(y), row(y), cols_);
+            else bits::nonZeroRowScalar(src.ptr<uint8_t>(y), row(y), cols_);
+        }
+    }
+
+    // bit = |a - b| > thresh (CV_8UC1, same size): absdiff + threshold in one pass
+    void packAbsDiff(const cv::Mat& a, const cv::Mat& b, int thresh, bool simd = true)
+    {
+        CV_Assert(a.type() == CV_8UC1 && b.type() == CV_8UC1 && a.size() == b.size());
+        create(a.rows, a.cols);
+        for(int y = 0; y < rows_; y++)
+        {
+            if(simd) bits::absDiffRow(a.ptr<uint8_t>(y), b.ptr<uint8_t>(y), row(y), cols_, thresh);
+            else bits::absDiffRowScalar(a.ptr<uint8_t>(y), b.ptr<uint8_t>(y), row(y), cols_, thresh);
+        }
+    }
+
+    // ==================== COUNTING ====================
+    uint64_t countAll() const
+    {
+        uint64_t n = 0;
+        for(uint64_t w : words_) n += bits::popcount(w);
+        return n;
+    }
+
+    // Set bits inside "r" (clipped to the mask)
+    int count(cv::Rect r) const
+    {
+        r = r & cv::Rect(0, 0, cols_, rows_);
+        if(r.empty()) return 0;
+
+        const int w0 = r.x >> 6, w1 = (r.x + r.width - 1) >> 6;
+        const uint64_t first = ~0ULL << (r.x & 63);
+        const uint64_t last = ~0ULL >> (63 - ((r.x + r.width - 1) & 63));
+        int n = 0;
+        for(int y = r.y; y < r.y + r.height; y++)
+        {
+            const uint64_t* p = row(y);
+            if(w0 == w1)
+            {
+                n += bits::popcount(p[w0] & first & last);
+                continue;
+            }
+            n += bits::popcount(p[w0] & first);
+            for(int i = w0 + 1; i < w1; i++) n += bits::popcount(p[i]);
+            n += bits::popcount(p[w1] & last);
+        }
+        return n;
+    }
+
+    // ==================== LOGIC ====================
+    friend void bitAnd(const BitMask& a, const BitMask& b, BitMask& dst) { combine(a, b, dst, [](uint64_t x, uint64_t y) { return x & y; }); }
+    friend void bitOr(const BitMask& a, const BitMask& b, BitMask& dst) { combine(a, b, dst, [](uint64_t x, uint64_t y) { return x | y; }); }
+    friend void bitXor(const BitMask& a, const BitMask& b, BitMask& dst) { combine(a, b, dst, [](uint64_t x, uint64_t y) { return x ^ y; }); }
+
+    // ==================== DISPLAY ====================
+    // 0 / 255 CV_8UC1, as cv::threshold would give
+    void toMat(cv::Mat& dst) const
+    {
+        dst.create(rows_, cols_, CV_8UC1);
+        for(int y = 0; y < rows_; y++)
+        {
+            const uint64_t* p = row(y);
+            uint8_t* d = dst.ptr<uint8_t>(y);
+            for(int x = 0; x < cols_; x++)
+                d[x] = ((p[x >> 6] >> (x & 63)) & 1) ? 255 : 0;
+        }
+    }
+
+private:
+    template<typename Op>
+    static void combine(const BitMask& a, const BitMask& b, BitMask& dst, Op op)
+    {
+        CV_Assert(a.rows_ == b.rows_ && a.cols_ == b.cols_);
+        if(&dst != &a && &dst != &b) dst.create(a.rows_, a.cols_);
+        for(size_t i = 0; i < a.words_.size(); i++)
+            dst.words_[i] = op(a.words_[i], b.words_[i]);
+    }
+
+    int rows_ = 0, cols_ = 0, wpr_ = 0;
+    std::vector<uint64_t> words_;
+};
+
+} // namespace igv
+
+#endif // IGV_BIT_MASK_HPP
@@ -0,0 +1,107 @@
+/*****************************************************************************************
+ *  File Name   : BorrowedMat.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      cv::Mat header over memory owned by someone else (GStreamer buffer,
+ *      V4L2 mmap buffer), with a release callback that runs when the LAST
+ *      header referring to it is gone.
+ *
+ *      A plain cv::Mat(rows, cols, type, data) does not track its users, so
+ *      the owner never knows when the memory can be reused. Here the Mat gets
+ *      a normal reference count (cv::UMatData): header copies, ROIs and the
+ *      capture ring slots share it like any other Mat, and the callback
+ *      (unmap, requeue, unref...) runs exactly once.
+ *
+ *      Borrowed pixels are READ-ONLY by convention: the producer may still
+ *      read them (tee, encoder) or they may be mapped read-only.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_BORROWED_MAT_HPP
+#define IGV_BORROWED_MAT_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <functional>
+
+namespace igv
+{
+
+namespace detail
+{
+    // Runs the release callback when the Mat reference count drops to zero.
+    // Never allocates: Mats created or resized later use the default allocator.
+    class BorrowAllocator : public cv::MatAllocator
+    {
+    public:
+        cv::UMatData* allocate(int, const int*, int, void*, size_t*,
+                               cv::AccessFlag, cv::UMatUsageFlags) const override
+        {
+            return nullptr;
+        }
+
+        bool allocate(cv::UMatData*, cv::AccessFlag, cv::UMatUsageFlags) const override
+        {
+            return false;
+        }
+
+        void deallocate(cv::UMatData* u) const override
+        {
+            if(!u) return;
+            std::function<void()>* onRelease = static_cast<std::function<void()>*>(u->userdata);
+            if(onRelease)
+            {
+                (*onRelease)();
+                delete onRelease;
+                liveCount()--;
+            }
+            delete u;
+        }
+
+        static BorrowAllocator* instance()
+        {
+            static BorrowAllocator allocator;
+            return &allocator;
+        }
+
+        static std::atomic<int>& liveCount()
+        {
+            static std::atomic<int> count(0);
+            return count;
+        }
+    };
+}
+
+// Header over "data" (size x type, row stride "step"). "onRelease" runs once,
+// on whichever thread drops the last reference.
+inline cv::Mat borrowMat(cv::Size size, int type, void* data, size_t step,
+                         std::function<void()> onRelease)
+{
+    cv::Mat header(size, type, data, step);
+    cv::UMatData* u = new cv::UMatData(detail::BorrowAllocator::instance());
+    u->data = u->origdata = static_cast<uchar*>(data);
+    u->size = step * size.height;
+    u->userdata = new std::function<void()>(std::move(onRelease));
+    u->refcount = 1;                // Owned by "header"
+    header.u = u;
+    detail::BorrowAllocator::liveCount()++;
+    return header;
+}
+
+// Borrowed buffers still referenced by a Mat somewhere (all producers)
+inline int borrowedMatCount()
+{
+    return detail::BorrowAllocator::liveCount();
+}
+
+} // namespace igv
+
+#endif // IGV_BORROWED_MAT_HPP
@@ -0,0 +1,164 @@
+/*****************************************************************************************
+ *  File Name   : BoxBlur.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat only)
+ *
+ *  Description :
+ *      Normalized box blur (what cv::blur computes) with a cost per pixel
+ *      that does not depend on the kernel size: separable running sums.
+ *
+ *          horizontal : prefix sums P along the row (one register per
+ *                       channel), s(x) = P(x - a + k) - P(x - a)
+ *          vertical   : column sums updated with the row entering the
+ *                       window and the row leaving it (ring of the last
+ *                       kh horizontal sums)
+ *
+ *      3 adds + 2 subtracts per pixel and channel for any kw x kh, where a
+ *      separable direct filter does kw + kh. Same anchor (kernel centre, ksize / 2) and
+ *      border (BORDER_REFLECT_101) as cv::blur's defaults; the division by
+ *      kw * kh is rounded to nearest, so results match cv::blur to within 1.
+ *
+ *      threads > 1 splits the output rows into bands (igv/RowBands.hpp);
+ *      each band primes its own column sums, so the result is the same for
+ *      any number of threads.
+ *
+ *      CV_8UC1 .. CV_8UC4, kw <= 257 (horizontal sums kept as uint16).
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_BOX_BLUR_HPP
+#define IGV_BOX_BLUR_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "RowBands.hpp"
+
+namespace igv
+{
+
+namespace box
+{
+    // P[(x + 1) * CN + c] = sum of p[0 .. x] of channel c, one running sum
+    // per channel kept in a register (no reload of the previous entry)
+    template<int CN>
+    inline void prefixSums(const uint8_t* __restrict p, uint16_t* __restrict P, int pixels)
+    {
+        uint16_t s[CN] = {};
+        for(int c = 0; c < CN; c++) P[c] = 0;
+        for(int x = 0; x < pixels; x++)
+            for(int c = 0; c < CN; c++)
+            {
+                s[c] = (uint16_t)(s[c] + p[x * CN + c]);
+                P[(x + 1) * CN + c] = s[c];
+            }
+    }
+
+    // Sliding sum along one row of "cn" interleaved channels: out[x] = sum of
+    // src[x - a .. x - a + k - 1] (reflect-101 outside the row). Taken as
+    // the difference of two prefix sums: wraps modulo 2^16 like the sums,
+    // and every true sum (<= 257 * 255) fits, so the difference is exact.
+    inline void horizontalSums(const uint8_t* src, uint16_t* out, int width, int cn, int k,
+                               std::vector<uint8_t>& padded, std::vector<uint16_t>& prefix)
+    {
+        const int a = k / 2;
+        const int n = (width + k - 1) * cn;
+        padded.resize(n);
+        prefix.resize(n + cn);
+        std::memcpy(padded.data() + (size_t)a * cn, src, (size_t)width * cn);
+        for(int i = 0; i < width + k - 1; i++)
+        {
+            if(i == a) i = a + width;                       // Interior copied above
+            if(i >= width + k - 1) break;
+            int x = cv::borderInterpolate(i - a, width, cv::BORDER_REFLECT_101);
+            for(int c = 0; c < cn; c++) padded[(size_t)i * cn + c] = src[x * cn + c];
+        }
+
+        switch(cn)
+        {
+            case 1:  prefixSums<1>(padded.data(), prefix.data(), width + k - 1); break;
+            case 2:  prefixSums<2>(padded.data(), prefix.data(), width + k - 1); break;
+            case 3:  prefixSums<3>(padded.data(), prefix.data(), width + k - 1); break;
+            default: prefixSums<4>(padded.data(), prefix.data(), width + k - 1); break;
+        }
+        const uint16_t* P = prefix.data();
+        const int span = k * cn;
+        for(int i = 0; i < width * cn; i++) out[i] = (uint16_t)(P[i + span] - P[i]);
+    }
+
+    // Rows [y0, y1) of the output
+    inline void blurBand(const cv::Mat& src, cv::Mat& dst, int kw, int kh, int y0, int y1)
+    {
+        const int width = src.cols, cn = src.channels(), n = width * cn;
+        const int a = kh / 2;
+        const float scale = 1.0f / (float)(kw * kh);
+
+        // Horizontal sums of the kh rows in the window (window row i in slot
+        // i % kh) and one spare row for the row entering it
+        std::vector<uint16_t> storage((size_t)(kh + 1) * n);
+        std::vector<uint16_t*> ring(kh);
+        for(int i = 0; i < kh; i++) ring[i] = storage.data() + (size_t)i * n;
+        uint16_t* fresh = storage.data() + (size_t)kh * n;
+        std::vector<uint32_t> column(n, 0);
+        std::vector<uint8_t> padded;
+        std::vector<uint16_t> prefix;
+        auto srcRow = [&](int i) { return src.ptr<uint8_t>(cv::borderInterpolate(i, src.rows, cv::BORDER_REFLECT_101)); };
+
+        // Window of output row y0: rows y0 - a .. y0 - a + kh - 1
+        for(int i = 0; i < kh; i++)
+        {
+            horizontalSums(srcRow(y0 - a + i), ring[i], width, cn, kw, padded, prefix);
+            for(int j = 0; j < n; j++) column[j] += ring[i][j];
+        }
+        uint8_t* d = dst.ptr<uint8_t>(y0);
+        for(int j = 0; j < n; j++) d[j] = (uint8_t)((float)column[j] * scale + 0.5f);
+
+        // Slide: row y - 1 - a leaves, row y - 1 - a + kh enters, one pass
+        for(int y = y0 + 1; y < y1; y++)
+        {
+            uint16_t*& slot = ring[(y - 1 - y0) % kh];
+            horizontalSums(srcRow(y - 1 - a + kh), fresh, width, cn, kw, padded, prefix);
+
+            // Local restrict pointers: d is uint8_t, which may alias anything,
+            // and the compiler would not vectorize the loop otherwise
+            const uint16_t* __restrict in = fresh;
+            const uint16_t* __restrict out = slot;
+            uint32_t* __restrict col = column.data();
+            uint8_t* __restrict dy = dst.ptr<uint8_t>(y);
+            for(int j = 0; j < n; j++)
+            {
+                col[j] += (uint32_t)in[j] - out[j];
+                dy[j] = (uint8_t)((float)col[j] * scale + 0.5f);
+            }
+            std::swap(slot, fresh);
+        }
+    }
+} // namespace box
+
+// ==================== BOX BLUR ====================
+// dst = cv::blur(src, ksize) (within 1), O(1) per pixel, "threads" row bands
+inline void boxBlur(const cv::Mat& src, cv::Mat& dst, cv::Size ksize, int threads = 1)
+{
+    CV_Assert(src.depth() == CV_8U && src.channels() <= 4);
+    CV_Assert(ksize.width >= 1 && ksize.height >= 1 && ksize.width <= 257);
+
+    cv::Mat in = src;
+    if(dst.data == src.data) in = src.clone();          // In place: bands read rows others write
+    dst.create(src.size(), src.type());
+    if(src.empty()) return;
+
+    forRowBands(src.rows, threads, [&](int y0, int y1) {
+        box::blurBand(in, dst, ksize.width, ksize.height, y0, y1);
+    });
+}
+
+} // namespace igv
+
+#endif // IGV_BOX_BLUR_HPP
@@ -0,0 +1,377 @@
+/*****************************************************************************************
+ *  File Name   : CaptureRing.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      - Runs frame capture on a dedicated grabber thread
+ *      - Stores frames in a fixed ring of preallocated cv::Mat slots
+ *      - LATEST mode      : consumer always gets the newest frame (low latency)
+ *      - EVERY_FRAME mode : consumer gets frames in order (no silent skips)
+ *      - BLOCKING mode    : like EVERY_FRAME, but the grabber waits for a free
+ *                           slot instead of dropping (replay / benchmark runs)
+ *      - Counts captured / delivered / dropped / overwritten frames
+ *      - pin() keeps a read frame out of the ring for another thread until
+ *        unpin(): the slot buffer is reused afterwards, never reallocated
+ *
+ *  Why:
+ *      With "cap >> frame" inside the processing loop the capture wait and the
+ *      processing time add up. With the grabber thread they overlap, so the
+ *      loop runs at max(capture, processing) instead of capture + processing.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x, GStreamer
+*****************************************************************************************/
+
+#ifndef IGV_CAPTURE_RING_HPP
+#define IGV_CAPTURE_RING_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FrameSource.hpp"
+
+namespace igv
+{
+
+class CaptureRing
+{
+public:
+    // Function used by the grabber thread to fill one slot
+    // Returns false when the stream has ended (or the camera failed)
+    using GrabFn = std::function<bool(cv::Mat&)>;
+
+    enum class Mode
+    {
+        LATEST,         // Skip old frames, always hand out the newest one
+        EVERY_FRAME,    // Hand out frames in capture order
+        BLOCKING        // Capture order, grabber waits when the ring is full
+    };
+
+    struct Stats
+    {
+        uint64_t captured    = 0;   // Frames written into the ring by the grabber
+        uint64_t delivered   = 0;   // Frames handed to the consumer
+        uint64_t dropped     = 0;   // EVERY_FRAME: ring full, frame thrown away at input
+        uint64_t overwritten = 0;   // LATEST: unread frame replaced by a newer one
+    };
+
+    // ==================== CONSTRUCTION ====================
+    // slots      : ring size (LATEST needs >= 3, the other modes need >= 2)
+    // frameSize  : optional size/type used to preallocate every slot
+    CaptureRing(GrabFn grab, size_t slots = 4, Mode mode = Mode::LATEST,
+                cv::Size frameSize = cv::Size(), int frameType = CV_8UC3)
+        : grab_(std::move(grab)), mode_(mode),
+          slots_(std::max<size_t>(slots, mode == Mode::LATEST ? 3 : 2)),
+          state_(slots_.size(), SlotState::FREE),
+          stamps_(slots_.size(), 0)
+    {
+        if(!frameSize.empty())
+        {
+            for(cv::Mat& slot : slots_)
+            {
+                slot.create(frameSize, frameType);
+            }
+        }
+    }
+
+    // Convenience constructor for the lessons: wrap an opened cv::VideoCapture
+    // The capture object must outlive the ring
+    CaptureRing(cv::VideoCapture& cap, size_t slots = 4, Mode mode = Mode::LATEST)
+        : CaptureRing([&cap](cv::Mat& m) { return cap.read(m) && !m.empty(); },
+                      slots, mode,
+                      cv::Size((int)cap.get(cv::CAP_PROP_FRAME_WIDTH),
+                               (int)cap.get(cv::CAP_PROP_FRAME_HEIGHT)))
+    {
+    }
+
+    // Wrap a FrameSource. Default mode: LATEST for cameras, BLOCKING for
+    // replay / synthetic sources so no frame is ever lost.
+    // The source must outlive the ring
+    explicit CaptureRing(FrameSource& source, size_t slots = 4)
+        : CaptureRing(source, slots, source.isLive() ? Mode::LATEST : Mode::BLOCKING)
+    {
+    }
+
+    // Zero-copy sources (frames are views of pipeline buffers): nothing is
+    // preallocated and a slot drops its buffer as soon as it is freed, so the
+    // ring never keeps upstream buffers busy with frames nobody will read.
+    CaptureRing(FrameSource& source, size_t slots, Mode mode)
+        : CaptureRing([&source](cv::Mat& m) { return source.read(m); },
+                      slots, mode,
+                      source.borrowsBuffers() ? cv::Size() : bufferSize(source.format(), source.frameSize()),
+                      bufferType(source.format()))
+    {
+        releaseFreed_ = source.borrowsBuffers();
+        stamp_ = [&source]() { return source.lastTimestampNs(); };
+    }
+
+    ~CaptureRing()
+    {
+        stop();
+    }
+
+    CaptureRing(const CaptureRing&) = delete;
+    CaptureRing& operator=(const CaptureRing&) = delete;
+
+    // ==================== THREAD CONTROL ====================
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(running_) return;
+        running_ = true;
+        ended_ = false;
+        worker_ = std::thread(&CaptureRing::grabLoop, this);
+    }
+
+    // Stops the grabber. The current grab (if any) is allowed to finish.
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        cond_.notify_all();
+        if(worker_.joinable()) worker_.join();
+    }
+
+    // ==================== CONSUMER SIDE ====================
+    // Blocks until a frame is available.
+    //
+    // "frame" is a header over the ring slot (no copy). The slot is reserved
+    // for the consumer until the next read() / release() call, so the grabber
+    // never writes into a frame that is still being processed. To pass the
+    // frame on to another thread, pin() it.
+    //
+    // Returns false once the stream has ended and all frames were consumed.
+    bool read(cv::Mat& frame)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        releaseLocked();
+
+        cond_.wait(lock, [this] { return !filled_.empty() || ended_ || !running_; });
+        if(filled_.empty())
+        {
+            frame.release();
+            return false;
+        }
+
+        int idx;
+        if(mode_ == Mode::LATEST)
+        {
+            // Take the newest frame, everything older is stale
+            idx = filled_.back();
+            filled_.pop_back();
+            while(!filled_.empty())
+            {
+                freeSlotLocked(filled_.front());
+                filled_.pop_front();
+                stats_.overwritten++;
+            }
+        }
+        else
+        {
+            // Oldest first, keep capture order
+            idx = filled_.front();
+            filled_.pop_front();
+        }
+
+        state_[idx] = SlotState::HELD;
+        held_ = idx;
+        stats_.delivered++;
+        frame = slots_[idx];
+
+        lock.unlock();
+        cond_.notify_all();
+        return true;
+    }
+
+    // Give the held slot back without taking a new frame
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            releaseLocked();
+        }
+        cond_.notify_all();
+    }
+
+    // Hands the frame of the last read() over to another thread: its slot
+    // stays out of the ring (no write, no reuse) until unpin(slot), and the
+    // next read() / release() does not free it. A pinned slot is one fewer
+    // for the grabber, size the ring for it. Returns -1 without a frame.
+    int pin()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(held_ < 0) return -1;
+        const int idx = held_;
+        state_[idx] = SlotState::PINNED;
+        held_ = -1;
+        return idx;
+    }
+
+    // Returns a pinned slot to the ring (any thread). Drop the headers of
+    // its frame first: the grabber writes into the same buffer again.
+    void unpin(int slot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(slot < 0 || state_[slot] != SlotState::PINNED) return;
+            freeSlotLocked(slot);
+        }
+        cond_.notify_all();
+    }
+
+    // Capture time of the frame returned by the last read() (steady clock ns,
+    // or the recorded time for log replay)
+    int64_t timestampNs() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return (held_ >= 0) ? stamps_[held_] : 0;
+    }
+
+    Stats stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    size_t slotCount() const { return slots_.size(); }
+    Mode mode() const { return mode_; }
+
+private:
+    enum class SlotState { FREE, WRITING, FILLED, HELD, PINNED };
+
+    // ==================== GRABBER THREAD ====================
+    void grabLoop()
+    {
+        cv::Mat scratch;    // Sink for frames dropped in EVERY_FRAME mode
+
+        while(true)
+        {
+            int idx = -1;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if(mode_ == Mode::BLOCKING)
+                {
+                    // Back-pressure: wait until the consumer frees a slot
+                    cond_.wait(lock, [this] { return !running_ || hasFreeSlotLocked(); });
+                }
+                if(!running_) break;
+                idx = acquireWriteSlotLocked();
+            }
+
+            // The expensive part happens without the lock held
+            bool ok = grab_(idx >= 0 ? slots_[idx] : scratch);
+            int64_t stamp = ok ? stamp_() : 0;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if(!ok)
+                {
+                    if(idx >= 0) freeSlotLocked(idx);
+                    ended_ = true;
+                }
+                else if(idx < 0)
+                {
+                    stats_.dropped++;
+                }
+                else
+                {
+                    state_[idx] = SlotState::FILLED;
+                    stamps_[idx] = stamp;
+                    filled_.push_back(idx);
+                    stats_.captured++;
+                }
+            }
+            cond_.notify_all();
+
+            if(!ok) break;
+        }
+    }
+
+    // Picks the slot the grabber writes next (mutex_ must be held).
+    // Returns -1 when the frame has to be dropped.
+    int acquireWriteSlotLocked()
+    {
+        for(size_t i = 0; i < slots_.size(); i++)
+        {
+            if(state_[i] == SlotState::FREE)
+            {
+                state_[i] = SlotState::WRITING;
+                return (int)i;
+            }
+        }
+
+        if(mode_ == Mode::LATEST && !filled_.empty())
+        {
+            // Ring is full of unread frames: recycle the oldest one
+            int idx = filled_.front();
+            filled_.pop_front();
+            state_[idx] = SlotState::WRITING;
+            stats_.overwritten++;
+            return idx;
+        }
+
+        return -1;
+    }
+
+    bool hasFreeSlotLocked() const
+    {
+        for(SlotState s : state_)
+        {
+            if(s == SlotState::FREE) return true;
+        }
+        return false;
+    }
+
+    void releaseLocked()
+    {
+        if(held_ >= 0)
+        {
+            freeSlotLocked(held_);
+            held_ = -1;
+        }
+    }
+
+    void freeSlotLocked(int idx)
+    {
+        state_[idx] = SlotState::FREE;
+        if(releaseFreed_) slots_[idx].release();
+    }
+
+    GrabFn grab_;
+    Mode mode_;
+    std::function<int64_t()> stamp_ = []() {
+        return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+
+    std::vector<cv::Mat> slots_;
+    std::vector<SlotState> state_;
+    std::vector<int64_t> stamps_;   // Capture time of each slot's frame
+    std::deque<int> filled_;        // Filled slot indices, oldest first
+    int held_ = -1;                 // Slot currently owned by the consumer
+    bool releaseFreed_ = false;     // Free slots give their buffer back (zero-copy sources)
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread worker_;
+    bool running_ = false;
+    bool ended_ = false;
+    Stats stats_;
+};
+
+} // namespace igv
+
+#endif // IGV_CAPTURE_RING_HPP
@@ -0,0 +1,328 @@
+/*****************************************************************************************
+ *  File Name   : EgoMotion.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (imgproc, video, calib3d)
+ *
+ *  Description :
+ *      Global image motion of a driving / turning robot, so the frame
+ *      difference of the emergency stop compares the scene with itself
+ *      instead of with a shifted copy of it:
+ *
+ *          |gray - prevGray|               whole frame moves while driving
+ *          |gray - warp(prevGray, motion)| only what moves in the scene
+ *
+ *      Per frame (update()):
+ *
+ *          resize   gray -> 1/4 size (INTER_AREA, 1280x720 -> 320x180)
+ *          track    corners of the previous frame, pyramidal LK (2 levels)
+ *          fit      similarity (estimateAffinePartial2D) or homography
+ *                   (findHomography, ground-dominated view), RANSAC
+ *          detect   new corners (goodFeaturesToTrack), only when half of
+ *                   them were lost
+ *
+ *      compensate() warps frame t-k onto frame t (motions of the last
+ *      "depth" frames are chained), at full size; pixels the warp does not
+ *      cover keep the current frame, so the border of the view does not
+ *      count as motion.
+ *
+ *      Time budget (budgetMs, per frame, estimate + warps):
+ *          - the estimate gets half of it: the corner count shrinks when
+ *            it runs over and grows back when it runs far under
+ *          - new corners are not searched when the frame is out of time
+ *          - compensate() refuses a warp that would not fit in what is
+ *            left (the first warp of a frame always runs)
+ *
+ *      A failed fit (too few corners / inliers: the scene is blank or an
+ *      obstacle fills the view) reuses the last motion for holdFrames
+ *      frames, then falls back to no motion: the plain frame difference,
+ *      which stops rather than misses.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_EGO_MOTION_HPP
+#define IGV_EGO_MOTION_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace igv
+{
+
+// Global motion model between two frames
+enum class EgoModel { SIMILARITY, HOMOGRAPHY };
+
+inline const char* egoModelName(EgoModel m)
+{
+    return (m == EgoModel::HOMOGRAPHY) ? "homography" : "similarity";
+}
+
+struct EgoMotionParams
+{
+    EgoModel model = EgoModel::SIMILARITY;
+    double scale = 0.25;            // Tracking resolution (of the full frame)
+    int maxCorners = 200;           // Corner count range (adapted to the budget)
+    int minCorners = 40;
+    double quality = 0.01;          // goodFeaturesToTrack, at tracking resolution
+    double minDistance = 8;
+    int window = 15;                // LK window and pyramid levels
+    int levels = 2;
+    double ransacPx = 1.0;          // Inlier distance, at tracking resolution
+    double minInliers = 0.5;        // Share of the tracked corners for a valid fit
+    double budgetMs = 6.0;          // Per frame: estimate + warps
+    int holdFrames = 3;             // Frames the last motion is reused after a failed fit
+    int depth = 4;                  // Motions kept: compensate() up to t-depth
+};
+
+// Last frame, per stage
+struct EgoTiming
+{
+    double resizeMs = 0;
+    double trackMs = 0;
+    double fitMs = 0;
+    double detectMs = 0;
+    double warpMs = 0;              // All warps of the frame
+    int warps = 0;
+    int skipped = 0;                // Warps refused by the budget
+
+    double estimateMs() const { return resizeMs + trackMs + fitMs + detectMs; }
+    double totalMs() const { return estimateMs() + warpMs; }
+};
+
+struct EgoEstimate
+{
+    bool valid = false;             // Fitted on this frame
+    bool held = false;              // Last valid motion reused
+    int tracked = 0;
+    int inliers = 0;
+    cv::Matx33d motion = cv::Matx33d::eye();    // Frame t-1 -> t, full resolution
+};
+
+class EgoMotion
+{
+public:
+    explicit EgoMotion(const EgoMotionParams& params = EgoMotionParams())
+        : params_(params), corners_(params.maxCorners),
+          motions_(std::max(1, params.depth), cv::Matx33d::eye()) {}
+
+    const EgoMotionParams& params() const { return params_; }
+
+    // Drop the tracked corners and motions (camera switch)
+    void reset()
+    {
+        prevSmall_.release();
+        prevPts_.clear();
+        frames_ = 0;
+        held_ = 0;
+        haveLast_ = false;
+        estimate_ = EgoEstimate();
+    }
+
+    // Motion of frame t-1 -> t for "gray" (CV_8UC1, full size), frame t
+    const EgoEstimate& update(const cv::Mat& gray)
+    {
+        CV_Assert(gray.type() == CV_8UC1);
+        if(gray.size() != size_)
+        {
+            reset();
+            size_ = gray.size();
+        }
+        timing_ = EgoTiming();
+        start_ = cv::getTickCount();
+        int64_t t = start_;
+
+        cv::resize(gray, small_, cv::Size(), params_.scale, params_.scale, cv::INTER_AREA);
+        timing_.resizeMs = lap(t);
+
+        estimate_ = EgoEstimate();
+        to_.clear();
+        if(!prevSmall_.empty() && !prevPts_.empty())
+        {
+            cv::calcOpticalFlowPyrLK(prevSmall_, small_, prevPts_, pts_, status_, err_,
+                                     cv::Size(params_.window, params_.window), params_.levels,
+                                     cv::TermCriteria(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 10, 0.03));
+            from_.clear();
+            for(size_t i = 0; i < prevPts_.size(); i++)
+            {
+                if(!status_[i]) continue;
+                from_.push_back(prevPts_[i]);
+                to_.push_back(pts_[i]);
+            }
+            estimate_.tracked = (int)to_.size();
+            timing_.trackMs = lap(t);
+
+            fit();
+            timing_.fitMs = lap(t);
+        }
+
+        if(estimate_.valid)
+        {
+            last_ = estimate_.motion;
+            haveLast_ = true;
+            held_ = 0;
+        }
+        else if(haveLast_ && held_ < params_.holdFrames)
+        {
+            estimate_.motion = last_;
+            estimate_.held = true;
+            held_++;
+        }
+        head_ = (head_ + 1) % motions_.size();
+        motions_[head_] = estimate_.motion;
+        frames_++;
+
+        // Corners for the next frame: the tracked ones, new ones when half
+        // were lost and there is time left (always on the first frame)
+        prevPts_.swap(to_);
+        if((int)prevPts_.size() < corners_ / 2 &&
+           (prevPts_.empty() || elapsedMs() < params_.budgetMs / 2))
+        {
+            cv::goodFeaturesToTrack(small_, prevPts_, corners_, params_.quality, params_.minDistance);
+            timing_.detectMs = lap(t);
+        }
+
+        // Corner count for the estimate to take half of the budget
+        const double spent = timing_.estimateMs();
+        if(spent > params_.budgetMs / 2) corners_ = std::max(params_.minCorners, corners_ * 3 / 4);
+        else if(spent < params_.budgetMs / 4) corners_ = std::min(params_.maxCorners, corners_ + corners_ / 8 + 1);
+
+        cv::swap(prevSmall_, small_);
+        return estimate_;
+    }
+
+    const EgoEstimate& estimate() const { return estimate_; }
+    const EgoTiming& timing() const { return timing_; }
+    int corners() const { return corners_; }
+
+    // Motions are known from frame t-k (k <= depth) to frame t
+    bool has(int k) const { return k >= 0 && k < frames_ && k <= (int)motions_.size(); }
+
+    // Frame t-k -> frame t: motions of the k last frames, chained
+    cv::Matx33d transform(int k) const
+    {
+        CV_Assert(has(k));
+        cv::Matx33d m = cv::Matx33d::eye();
+        for(int j = 0; j < k; j++)
+            m = m * motions_[(head_ + motions_.size() - j) % motions_.size()];
+        return m;
+    }
+
+    // "prev" (frame t-k) warped onto "cur" (frame t) into "warped"; pixels
+    // outside the warped frame are taken from "cur". false when the warp
+    // does not fit in the budget left (warped untouched)
+    bool compensate(const cv::Mat& prev, int k, const cv::Mat& cur, cv::Mat& warped)
+    {
+        CV_Assert(prev.size() == cur.size() && prev.type() == cur.type());
+        if(timing_.warps > 0 && elapsedMs() + lastWarpMs_ > params_.budgetMs)
+        {
+            timing_.skipped++;
+            return false;
+        }
+        int64_t t = cv::getTickCount();
+        const cv::Matx33d m = transform(k);
+        if(isIdentity(m)) prev.copyTo(warped);
+        else
+        {
+            cur.copyTo(warped);
+            if(m(2, 0) == 0 && m(2, 1) == 0 && m(2, 2) == 1)
+            {
+                const cv::Matx23d a(m(0, 0), m(0, 1), m(0, 2), m(1, 0), m(1, 1), m(1, 2));
+                cv::warpAffine(prev, warped, a, cur.size(), cv::INTER_LINEAR, cv::BORDER_TRANSPARENT);
+            }
+            else cv::warpPerspective(prev, warped, m, cur.size(), cv::INTER_LINEAR, cv::BORDER_TRANSPARENT);
+        }
+        lastWarpMs_ = lap(t);
+        timing_.warpMs += lastWarpMs_;
+        timing_.warps++;
+        return true;
+    }
+
+private:
+    static double lap(int64_t& t)
+    {
+        const int64_t now = cv::getTickCount();
+        const double ms = (now - t) * 1000.0 / cv::getTickFrequency();
+        t = now;
+        return ms;
+    }
+
+    double elapsedMs() const { return (cv::getTickCount() - start_) * 1000.0 / cv::getTickFrequency(); }
+
+    // Below 0.05 px of motion anywhere in a 2000 px frame
+    static bool isIdentity(const cv::Matx33d& m)
+    {
+        return std::abs(m(0, 0) - 1) < 2.5e-5 && std::abs(m(1, 1) - 1) < 2.5e-5 &&
+               std::abs(m(0, 1)) < 2.5e-5 && std::abs(m(1, 0)) < 2.5e-5 &&
+               std::abs(m(0, 2)) < 0.05 && std::abs(m(1, 2)) < 0.05 &&
+               m(2, 0) == 0 && m(2, 1) == 0;
+    }
+
+    // from_ -> to_ at tracking resolution, into estimate_ at full resolution
+    void fit()
+    {
+        const int MIN_FIT = 8;
+        if(estimate_.tracked < MIN_FIT) return;
+
+        cv::Mat m;
+        if(params_.model == EgoModel::SIMILARITY)
+            m = cv::estimateAffinePartial2D(from_, to_, inliers_, cv::RANSAC, params_.ransacPx);
+        else
+            m = cv::findHomography(from_, to_, cv::RANSAC, params_.ransacPx, inliers_);
+        if(m.empty()) return;
+
+        estimate_.inliers = cv::countNonZero(inliers_);
+        if(estimate_.inliers < MIN_FIT || estimate_.inliers < params_.minInliers * estimate_.tracked) return;
+
+        cv::Matx33d small = cv::Matx33d::eye();
+        for(int r = 0; r < m.rows; r++)
+            for(int c = 0; c < 3; c++) small(r, c) = m.at<double>(r, c);
+
+        // Pixel centers: small = s * (full + 0.5) - 0.5 (INTER_AREA)
+        const double s = params_.scale, o = 0.5 * s - 0.5;
+        const cv::Matx33d toSmall(s, 0, o, 0, s, o, 0, 0, 1);
+        const cv::Matx33d toFull(1 / s, 0, -o / s, 0, 1 / s, -o / s, 0, 0, 1);
+        estimate_.motion = toFull * small * toSmall;
+        estimate_.valid = true;
+
+        // Keep tracking the inliers only: corners on a moving obstacle drop out
+        size_t n = 0;
+        for(size_t i = 0; i < to_.size(); i++)
+            if(inliers_.at<uchar>((int)i)) to_[n++] = to_[i];
+        to_.resize(n);
+    }
+
+    EgoMotionParams params_;
+    int corners_;
+    cv::Size size_;
+
+    cv::Mat small_, prevSmall_;
+    std::vector<cv::Point2f> prevPts_, pts_, from_, to_;
+    std::vector<uchar> status_;
+    std::vector<float> err_;
+    cv::Mat inliers_;
+
+    std::vector<cv::Matx33d> motions_;     // Ring: motions_[head_] = t-1 -> t
+    size_t head_ = 0;
+    int frames_ = 0;
+
+    cv::Matx33d last_ = cv::Matx33d::eye();
+    bool haveLast_ = false;
+    int held_ = 0;
+
+    EgoEstimate estimate_;
+    EgoTiming timing_;
+    int64_t start_ = 0;
+    double lastWarpMs_ = 0;
+};
+
+} // namespace igv
+
+#endif // IGV_EGO_MOTION_HPP
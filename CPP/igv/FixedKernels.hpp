@@ -0,0 +1,355 @@
+/*****************************************************************************************
+ *  File Name   : FixedKernels.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat only)
+ *
+ *  Description :
+ *      Small filters with the kernel size, channel count and pixel type
+ *      fixed at compile time:
+ *
+ *          gaussianBlur<R, CN, T>  : cv::GaussianBlur(src, dst, Size(2R+1, 2R+1), 0)
+ *          erode<R, CN, T>         : cv::erode  with a (2R+1)^2 MORPH_RECT kernel
+ *          dilate<R, CN, T>        : cv::dilate with a (2R+1)^2 MORPH_RECT kernel
+ *
+ *      With R and CN constant the tap loops are fully unrolled, neighbours
+ *      are a constant CN elements apart and every row loop has a single
+ *      body the compiler vectorizes (-O3): no per-pixel loop over a runtime
+ *      kernel, no channel switch. Both passes are separable and run through
+ *      a ring of 2R+1 horizontally filtered rows, so each source row is read
+ *      once; threads > 1 splits the rows into bands (igv/RowBands.hpp).
+ *
+ *      Instantiated for the configurations the programs use:
+ *          R        : Gaussian 1..4 (3x3 .. 9x9), erode / dilate 1..2
+ *          CN       : 1 (gray, masks), 3 (BGR)
+ *          T        : uint8_t, float
+ *      and picked at run time from the Mat by gaussianBlur(src, dst, ksize)
+ *      / erodeRect / dilateRect, which fall back to the general code for
+ *      anything else (Morphology.hpp for large 8-bit masks, OpenCV otherwise).
+ *
+ *      Same results as OpenCV:
+ *          Gaussian 8-bit : OpenCV's bit-exact fixed point for sigma 0, the
+ *                           [1 2 1] / [1 4 6 4 1] / ... tables in 1/256,
+ *                           (sum kx ky p + 2^15) >> 16, BORDER_REFLECT_101
+ *          Gaussian float : getGaussianKernel(2R+1, 0, CV_32F), the exact
+ *                           sigma kernel (9x9 is not the 8-bit table),
+ *                           rounding order differs
+ *          erode / dilate : pixels outside the image ignored
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_FIXED_KERNELS_HPP
+#define IGV_FIXED_KERNELS_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "RowBands.hpp"
+#include "Morphology.hpp"
+
+namespace igv
+{
+
+namespace fixed
+{
+    // ==================== GAUSSIAN TABLES ====================
+    // getGaussianKernel(2R+1, sigma 0) for 8-bit images, in 1/256 (sum 256)
+    template<int R> struct Binomial;
+    template<> struct Binomial<1> { static constexpr int k[3] = { 64, 128, 64 }; };
+    template<> struct Binomial<2> { static constexpr int k[5] = { 16, 64, 96, 64, 16 }; };
+    template<> struct Binomial<3> { static constexpr int k[7] = { 8, 28, 56, 72, 56, 28, 8 }; };
+    template<> struct Binomial<4> { static constexpr int k[9] = { 4, 13, 30, 51, 60, 51, 30, 13, 4 }; };
+
+    // Row (horizontal pass) and sum (vertical pass) types per pixel type
+    template<typename T> struct Gauss;
+    template<> struct Gauss<uint8_t>
+    {
+        typedef uint16_t Row;                       // sum kx p <= 256 * 255
+        typedef uint32_t Sum;                       // sum ky row <= 256 * 65280
+        template<int R> static void kernel(Row* k)
+        {
+            std::copy(Binomial<R>::k, Binomial<R>::k + 2 * R + 1, k);
+        }
+        static uint8_t out(Sum s) { return (uint8_t)((s + (1u << 15)) >> 16); }
+    };
+    template<> struct Gauss<float>
+    {
+        typedef float Row;
+        typedef float Sum;
+        // OpenCV's float kernel, built once per R
+        template<int R> static void kernel(Row* k)
+        {
+            static const cv::Mat g = cv::getGaussianKernel(2 * R + 1, 0, CV_32F);
+            std::copy(g.ptr<float>(), g.ptr<float>() + 2 * R + 1, k);
+        }
+        static float out(Sum s) { return s; }
+    };
+
+    // BORDER_REFLECT_101 (n > 1)
+    inline int reflect101(int i, int n)
+    {
+        if(i < 0) return -i;
+        if(i >= n) return 2 * (n - 1) - i;
+        return i;
+    }
+
+    // ==================== GAUSSIAN ====================
+    // Output rows [y0, y1)
+    template<int R, int CN, typename T>
+    inline void gaussianBand(const cv::Mat& src, cv::Mat& dst, int y0, int y1)
+    {
+        typedef typename Gauss<T>::Row Row;
+        typedef typename Gauss<T>::Sum Sum;
+        constexpr int K = 2 * R + 1;
+        const int width = src.cols, n = width * CN;
+
+        Row kx[K];
+        Gauss<T>::template kernel<R>(kx);
+
+        // Ring of horizontally filtered rows: slot = row % K
+        std::vector<Row> ring((size_t)K * src.cols * CN);
+        std::vector<T> padded((size_t)(src.cols + 2 * R) * CN);
+        int holding[K];
+        std::fill(holding, holding + K, -1);
+        const Row* rows[K];
+
+        for(int y = y0; y < y1; y++)
+        {
+            for(int dy = 0; dy < K; dy++)
+            {
+                const int sy = reflect101(y - R + dy, src.rows);
+                Row* __restrict h = ring.data() + (size_t)(sy % K) * n;
+                if(holding[sy % K] != sy)
+                {
+                    // Pad (reflect 101), then [k0 .. kK-1] along the row
+                    const T* s = src.ptr<T>(sy);
+                    T* __restrict p = padded.data();
+                    std::copy(s, s + n, p + R * CN);
+                    for(int i = 1; i <= R; i++)
+                        for(int c = 0; c < CN; c++)
+                        {
+                            p[(R - i) * CN + c] = s[i * CN + c];
+                            p[(R + width - 1 + i) * CN + c] = s[(width - 1 - i) * CN + c];
+                        }
+                    for(int x = 0; x < n; x++)
+                    {
+                        Row acc = 0;
+                        for(int i = 0; i < K; i++)
+                            acc += kx[i] * (Row)p[x + i * CN];
+                        h[x] = acc;
+                    }
+                    holding[sy % K] = sy;
+                }
+                rows[dy] = h;
+            }
+
+            T* __restrict d = dst.ptr<T>(y);
+            for(int x = 0; x < n; x++)
+            {
+                Sum acc = 0;
+                for(int dy = 0; dy < K; dy++)
+                    acc += (Sum)kx[dy] * (Sum)rows[dy][x];
+                d[x] = Gauss<T>::out(acc);
+            }
+        }
+    }
+
+    // ==================== ERODE / DILATE ====================
+    template<bool MAX, typename T> inline T rank(T a, T b) { return MAX ? std::max(a, b) : std::min(a, b); }
+    template<bool MAX, typename T> inline T identity()
+    {
+        return MAX ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+    }
+
+    // Output rows [y0, y1); rows / columns outside the image are identity
+    template<int R, int CN, typename T, bool MAX>
+    inline void rankBand(const cv::Mat& src, cv::Mat& dst, int y0, int y1)
+    {
+        constexpr int K = 2 * R + 1;
+        const int n = src.cols * CN;
+
+        std::vector<T> ring((size_t)K * src.cols * CN);
+        std::vector<T> padded((size_t)(src.cols + 2 * R) * CN, identity<MAX, T>());
+        const std::vector<T> outside((size_t)src.cols * CN, identity<MAX, T>());
+        int holding[K];
+        std::fill(holding, holding + K, -1);
+        const T* rows[K];
+
+        for(int y = y0; y < y1; y++)
+        {
+            for(int dy = 0; dy < K; dy++)
+            {
+                const int sy = y - R + dy;
+                if(sy < 0 || sy >= src.rows)
+                {
+                    rows[dy] = outside.data();
+                    continue;
+                }
+                T* __restrict h = ring.data() + (size_t)(sy % K) * n;
+                if(holding[sy % K] != sy)
+                {
+                    const T* s = src.ptr<T>(sy);
+                    T* __restrict p = padded.data();
+                    std::copy(s, s + n, p + R * CN);
+                    for(int x = 0; x < n; x++)
+                    {
+                        T v = p[x];
+                        for(int i = 1; i < K; i++)
+                            v = rank<MAX>(v, p[x + i * CN]);
+                        h[x] = v;
+                    }
+                    holding[sy % K] = sy;
+                }
+                rows[dy] = h;
+            }
+
+            T* __restrict d = dst.ptr<T>(y);
+            for(int x = 0; x < n; x++)
+            {
+                T v = rows[0][x];
+                for(int dy = 1; dy < K; dy++)
+                    v = rank<MAX>(v, rows[dy][x]);
+                d[x] = v;
+            }
+        }
+    }
+
+    // Runs "band" over the rows of dst (created like src), cloning src if
+    // it is also the output: bands read rows other bands write
+    template<typename Band>
+    inline void run(const cv::Mat& src, cv::Mat& dst, int threads, Band band)
+    {
+        cv::Mat in = src;
+        if(dst.data == src.data) in = src.clone();
+        dst.create(src.size(), src.type());
+        if(src.empty()) return;
+        forRowBands(src.rows, threads, [&](int y0, int y1) { band(in, dst, y0, y1); });
+    }
+
+    // ==================== RUNTIME DISPATCH ====================
+    // One compiled configuration
+    template<int R_, int CN_, typename T_>
+    struct Spec
+    {
+        static constexpr int R = R_;
+        static constexpr int CN = CN_;
+        typedef T_ T;
+    };
+
+    // fn(Spec<R, CN, T>()) for the Mat type, false if not compiled
+    template<int R, typename Fn>
+    inline bool byType(int type, Fn&& fn)
+    {
+        switch(type)
+        {
+            case CV_8UC1:  fn(Spec<R, 1, uint8_t>()); return true;
+            case CV_8UC3:  fn(Spec<R, 3, uint8_t>()); return true;
+            case CV_32FC1: fn(Spec<R, 1, float>());   return true;
+            case CV_32FC3: fn(Spec<R, 3, float>());   return true;
+        }
+        return false;
+    }
+
+    // Square odd kernel larger than 1x1 that fits the image: its radius, else 0
+    inline int radius(const cv::Mat& src, cv::Size ksize)
+    {
+        if(ksize.width != ksize.height || ksize.width % 2 == 0) return 0;
+        const int r = ksize.width / 2;
+        return (src.rows > r && src.cols > r) ? r : 0;
+    }
+} // namespace fixed
+
+// ==================== COMPILE-TIME KERNELS ====================
+// dst = cv::GaussianBlur(src, Size(2R+1, 2R+1), 0); src rows and cols > R
+template<int R, int CN, typename T>
+inline void gaussianBlur(const cv::Mat& src, cv::Mat& dst, int threads = 1)
+{
+    static_assert(R >= 1 && R <= 4, "igv::gaussianBlur: 3x3 to 9x9");
+    CV_Assert(src.type() == CV_MAKETYPE(cv::DataType<T>::depth, CN));
+    CV_Assert(src.empty() || (src.rows > R && src.cols > R));
+    fixed::run(src, dst, threads, fixed::gaussianBand<R, CN, T>);
+}
+
+// dst = cv::erode(src, (2R+1)^2 MORPH_RECT)
+template<int R, int CN, typename T>
+inline void erode(const cv::Mat& src, cv::Mat& dst, int threads = 1)
+{
+    CV_Assert(src.type() == CV_MAKETYPE(cv::DataType<T>::depth, CN));
+    fixed::run(src, dst, threads, fixed::rankBand<R, CN, T, false>);
+}
+
+// dst = cv::dilate(src, (2R+1)^2 MORPH_RECT)
+template<int R, int CN, typename T>
+inline void dilate(const cv::Mat& src, cv::Mat& dst, int threads = 1)
+{
+    CV_Assert(src.type() == CV_MAKETYPE(cv::DataType<T>::depth, CN));
+    fixed::run(src, dst, threads, fixed::rankBand<R, CN, T, true>);
+}
+
+// ==================== RUNTIME DISPATCH ====================
+// cv::GaussianBlur(src, dst, ksize, 0): compiled kernel for 3x3 .. 9x9
+// square, 8U / 32F, 1 / 3 channels, OpenCV otherwise
+inline void gaussianBlur(const cv::Mat& src, cv::Mat& dst, cv::Size ksize, int threads = 1)
+{
+    auto fn = [&](auto spec) {
+        typedef decltype(spec) S;
+        gaussianBlur<S::R, S::CN, typename S::T>(src, dst, threads);
+    };
+    bool done = false;
+    switch(fixed::radius(src, ksize))
+    {
+        case 1: done = fixed::byType<1>(src.type(), fn); break;
+        case 2: done = fixed::byType<2>(src.type(), fn); break;
+        case 3: done = fixed::byType<3>(src.type(), fn); break;
+        case 4: done = fixed::byType<4>(src.type(), fn); break;
+    }
+    if(!done) cv::GaussianBlur(src, dst, ksize, 0);
+}
+
+// cv::erode / cv::dilate with a MORPH_RECT kernel of ksize: compiled kernel
+// for 3x3 / 5x5 (8U / 32F, 1 / 3 channels), van Herk / Gil-Werman for
+// larger 8-bit masks (Morphology.hpp), OpenCV otherwise
+inline void erodeRect(const cv::Mat& src, cv::Mat& dst, cv::Size ksize, int threads = 1)
+{
+    auto fn = [&](auto spec) {
+        typedef decltype(spec) S;
+        erode<S::R, S::CN, typename S::T>(src, dst, threads);
+    };
+    bool done = false;
+    switch(fixed::radius(src, ksize))
+    {
+        case 1: done = fixed::byType<1>(src.type(), fn); break;
+        case 2: done = fixed::byType<2>(src.type(), fn); break;
+    }
+    if(done) return;
+    if(src.type() == CV_8UC1) erode(src, dst, ksize, threads);
+    else cv::erode(src, dst, cv::getStructuringElement(cv::MORPH_RECT, ksize));
+}
+
+inline void dilateRect(const cv::Mat& src, cv::Mat& dst, cv::Size ksize, int threads = 1)
+{
+    auto fn = [&](auto spec) {
+        typedef decltype(spec) S;
+        dilate<S::R, S::CN, typename S::T>(src, dst, threads);
+    };
+    bool done = false;
+    switch(fixed::radius(src, ksize))
+    {
+        case 1: done = fixed::byType<1>(src.type(), fn); break;
+        case 2: done = fixed::byType<2>(src.type(), fn); break;
+    }
+    if(done) return;
+    if(src.type() == CV_8UC1) dilate(src, dst, ksize, threads);
+    else cv::dilate(src, dst, cv::getStructuringElement(cv::MORPH_RECT, ksize));
+}
+
+} // namespace igv
+
+#endif // IGV_FIXED_KERNELS_HPP
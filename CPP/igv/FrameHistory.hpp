@@ -0,0 +1,96 @@
+/*****************************************************************************************
+ *  File Name   : FrameHistory.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat only)
+ *
+ *  Description :
+ *      The last frames of a stream in preallocated slots, for frame
+ *      differencing without
+ *
+ *          prevGray = gray.clone();    // allocation + full copy per frame
+ *
+ *      The new frame is written straight into a free slot (next()), and
+ *      push() rotates the slot index: nothing is copied or allocated after
+ *      the first frames. Consumers get const views of frames t, t-1 ..
+ *      t-depth:
+ *
+ *          FrameHistory history(4);
+ *          igv::gaussianBlur(luma, history.next(luma.size(), CV_8UC1), cv::Size(5, 5));
+ *          history.push();
+ *          if(history.has(4)) cv::absdiff(history[0], history[4], diff);
+ *
+ *      Differencing over 2 or 4 frames (t vs t-2, t vs t-4) sees obstacles
+ *      that move less than the threshold between two frames.
+ *
+ *      depth + 2 slots: depth + 1 frames kept, one being written, so
+ *      next() never overwrites a frame that can still be read.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_FRAME_HISTORY_HPP
+#define IGV_FRAME_HISTORY_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace igv
+{
+
+class FrameHistory
+{
+public:
+    // Keeps frames t .. t-depth (depth 1: the classic previous frame)
+    explicit FrameHistory(int depth = 1) : slots_(std::max(1, depth) + 2) {}
+
+    int depth() const { return (int)slots_.size() - 2; }
+
+    // Frames that can be read: has(k) <=> frame t-k exists
+    int available() const { return count_; }
+    bool has(int k) const { return k >= 0 && k < count_; }
+
+    // Drop all frames (camera switch): slots stay allocated
+    void reset() { count_ = 0; }
+
+    // Slot for the next frame, allocated for "size" / "type" (only the
+    // first time, or when the stream changes: then the older frames are
+    // dropped). Write the frame into it, then push().
+    cv::Mat& next(cv::Size size, int type)
+    {
+        if(count_ > 0 && ((*this)[0].size() != size || (*this)[0].type() != type)) reset();
+        cv::Mat& slot = slots_[writeSlot()];
+        slot.create(size, type);
+        return slot;
+    }
+
+    // The slot of next() becomes frame t, frame t-depth is dropped
+    void push()
+    {
+        head_ = writeSlot();
+        count_ = std::min(count_ + 1, depth() + 1);
+    }
+
+    // Frame t-k (0 <= k < available())
+    const cv::Mat& operator[](int k) const
+    {
+        CV_Assert(has(k));
+        return slots_[(head_ + slots_.size() - k) % slots_.size()];
+    }
+
+private:
+    size_t writeSlot() const { return (head_ + 1) % slots_.size(); }
+
+    std::vector<cv::Mat> slots_;
+    size_t head_ = 0;
+    int count_ = 0;
+};
+
+} // namespace igv
+
+#endif // IGV_FRAME_HISTORY_HPP
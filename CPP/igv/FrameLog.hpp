@@ -0,0 +1,506 @@
+/*****************************************************************************************
+ *  File Name   : FrameLog.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV, POSIX (mmap)
+ *
+ *  Description :
+ *      Raw frame log: records exactly what the perception loop saw, so field
+ *      incidents (false EMERGENCY STOP, missed obstacle) can be replayed
+ *      frame by frame, as often and as fast as needed.
+ *
+ *      FrameLogWriter : append-only recorder. write() copies the frame into a
+ *                       preallocated buffer and returns; a background thread
+ *                       does the file I/O. When the disk falls behind, frames
+ *                       are dropped (and counted) instead of blocking the loop.
+ *      FrameLogReader : maps the whole file and returns frames as cv::Mat
+ *                       views into the mapping (no copy, no decode).
+ *
+ *      File layout (host byte order, every block 64-byte aligned):
+ *          [ FileHeader ]
+ *          [ RecordHeader | pixels ] [ RecordHeader | pixels ] ...
+ *          [ index: uint64 record offsets ] [ Trailer ]
+ *
+ *      The index and trailer are written by close(). A log cut short (crash,
+ *      power loss) has no trailer; the reader then rebuilds the index by
+ *      walking the records and ignores a truncated last record. A failed
+ *      write (disk full) stops the recording the same way: no more frames,
+ *      no trailer, stats().failed set and an error printed.
+ *
+ *      Replay: FrameSource spec "log:<path>[,fast][,frames=N]"
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_FRAME_LOG_HPP
+#define IGV_FRAME_LOG_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <condition_variable>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "PixelFormat.hpp"
+
+namespace igv
+{
+
+// ==================== ON-DISK STRUCTURES ====================
+namespace framelog
+{
+    const char     FILE_MAGIC[8] = { 'I', 'G', 'V', 'L', 'O', 'G', '0', '1' };
+    const uint32_t RECORD_MAGIC  = 0x4D415246;     // "FRAM"
+    const uint32_t TRAILER_MAGIC = 0x21584449;     // "IDX!"
+    const uint64_t ALIGN         = 64;
+
+    struct FileHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t headerBytes;
+        uint8_t  reserved[48];
+    };
+
+    struct RecordHeader
+    {
+        uint32_t magic;
+        uint32_t headerBytes;
+        uint64_t index;         // Frame number in this log
+        int64_t  timestampNs;   // Capture time (steady clock)
+        int32_t  rows;          // Buffer rows (h*3/2 for NV12 / I420)
+        int32_t  cols;
+        int32_t  type;          // OpenCV type (CV_8UC3, CV_8UC1)
+        int32_t  format;        // igv::PixelFormat
+        uint64_t dataBytes;     // rows * cols * elemSize, packed
+        uint8_t  reserved[16];
+    };
+
+    struct Trailer
+    {
+        uint32_t magic;
+        uint32_t reserved;
+        uint64_t indexOffset;
+        uint64_t count;
+        uint64_t pad[5];
+    };
+
+    static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+    static_assert(sizeof(RecordHeader) == 64, "RecordHeader must be 64 bytes");
+    static_assert(sizeof(Trailer) == 64, "Trailer must be 64 bytes");
+
+    inline uint64_t alignUp(uint64_t n) { return (n + ALIGN - 1) & ~(ALIGN - 1); }
+}
+
+// ==================== RECORDER ====================
+class FrameLogWriter
+{
+public:
+    struct Stats
+    {
+        uint64_t written = 0;   // Frames on disk
+        uint64_t dropped = 0;   // Queue full (disk too slow), frame not recorded
+        uint64_t bytes   = 0;   // File size so far
+        bool failed      = false; // A write failed (disk full): recording stopped, log has no trailer
+    };
+
+    // queueDepth : frames that can wait for the disk before write() drops
+    explicit FrameLogWriter(const std::string& path, size_t queueDepth = 8)
+        : pool_(std::max<size_t>(queueDepth, 1))
+    {
+        file_ = std::fopen(path.c_str(), "wb");
+        if(!file_)
+        {
+            std::cerr << "IGV::ERROR::Cannot create frame log " << path << std::endl;
+            return;
+        }
+
+        framelog::FileHeader header = {};
+        std::memcpy(header.magic, framelog::FILE_MAGIC, sizeof(header.magic));
+        header.version = 1;
+        header.headerBytes = sizeof(framelog::FileHeader);
+        if(std::fwrite(&header, sizeof(header), 1, file_) != 1)
+        {
+            std::cerr << "IGV::ERROR::Cannot write frame log " << path << std::endl;
+            std::fclose(file_);
+            file_ = nullptr;
+            return;
+        }
+        offset_ = sizeof(header);
+
+        for(size_t i = 0; i < pool_.size(); i++) free_.push_back(i);
+        worker_ = std::thread(&FrameLogWriter::writeLoop, this);
+    }
+
+    ~FrameLogWriter()
+    {
+        close();
+    }
+
+    FrameLogWriter(const FrameLogWriter&) = delete;
+    FrameLogWriter& operator=(const FrameLogWriter&) = delete;
+
+    bool isOpened() const { return file_ != nullptr; }
+
+    // Queues one frame. Never waits for the disk: returns false (and counts a
+    // drop) when all buffers are still waiting to be written.
+    bool write(const cv::Mat& frame, PixelFormat fmt, int64_t timestampNs)
+    {
+        if(!file_ || frame.empty()) return false;
+
+        size_t slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(stats_.failed) return false;     // Recording stopped
+            if(free_.empty())
+            {
+                stats_.dropped++;
+                nextIndex_++;
+                return false;
+            }
+            slot = free_.front();
+            free_.pop_front();
+        }
+
+        // The only work done on the caller's thread: one packed copy
+        Pending& p = pool_[slot];
+        frame.copyTo(p.pixels);
+        p.format = fmt;
+        p.timestampNs = timestampNs;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            p.index = nextIndex_++;
+            queue_.push_back(slot);
+        }
+        cond_.notify_one();
+        return true;
+    }
+
+    // Writes everything still queued, then the index and trailer
+    void close()
+    {
+        if(!file_) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closing_ = true;
+        }
+        cond_.notify_one();
+        if(worker_.joinable()) worker_.join();
+
+        // After a failed write the log stays without trailer: the reader
+        // walks the complete records and never takes it for a full log
+        bool ok = !failed();
+        if(ok)
+        {
+            const uint64_t indexOffset = offset_;
+            ok = put(offsets_.data(), offsets_.size() * sizeof(uint64_t)) &&
+                 padTo(framelog::alignUp(offset_));
+
+            framelog::Trailer trailer = {};
+            trailer.magic = framelog::TRAILER_MAGIC;
+            trailer.indexOffset = indexOffset;
+            trailer.count = offsets_.size();
+            ok = ok && put(&trailer, sizeof(trailer));
+        }
+        // fclose() writes what is still buffered: it can fail as well
+        if(std::fclose(file_) != 0) ok = false;
+        file_ = nullptr;
+        if(!ok && !failed()) fail();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.bytes = offset_;
+    }
+
+    Stats stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+private:
+    struct Pending
+    {
+        cv::Mat pixels;
+        PixelFormat format = PixelFormat::BGR;
+        int64_t timestampNs = 0;
+        uint64_t index = 0;
+    };
+
+    // ==================== WRITER THREAD ====================
+    void writeLoop()
+    {
+        while(true)
+        {
+            size_t slot;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return !queue_.empty() || closing_; });
+                if(queue_.empty()) break;       // closing_ and nothing left
+                slot = queue_.front();
+                queue_.pop_front();
+            }
+
+            // After a failure the queued frames are given back unwritten
+            const bool written = !failed() && writeRecord(pool_[slot]);
+            if(!written && !failed()) fail();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                free_.push_back(slot);
+                if(written) stats_.written++;
+                stats_.bytes = offset_;
+            }
+        }
+        if(!failed() && std::fflush(file_) != 0) fail();
+    }
+
+    bool failed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_.failed;
+    }
+
+    // Stops the recording (no more frames, no trailer)
+    void fail()
+    {
+        std::cerr << "IGV::ERROR::Frame log write failed (" << std::strerror(errno)
+                  << "), recording stopped after " << offsets_.size() << " frames" << std::endl;
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.failed = true;
+    }
+
+    bool put(const void* data, size_t bytes)
+    {
+        if(bytes > 0 && std::fwrite(data, 1, bytes, file_) != bytes) return false;
+        offset_ += bytes;
+        return true;
+    }
+
+    bool writeRecord(const Pending& p)
+    {
+        const cv::Mat& m = p.pixels;        // copyTo() made it continuous
+
+        framelog::RecordHeader rec = {};
+        rec.magic = framelog::RECORD_MAGIC;
+        rec.headerBytes = sizeof(framelog::RecordHeader);
+        rec.index = p.index;
+        rec.timestampNs = p.timestampNs;
+        rec.rows = m.rows;
+        rec.cols = m.cols;
+        rec.type = m.type();
+        rec.format = (int32_t)p.format;
+        rec.dataBytes = (uint64_t)m.rows * m.cols * m.elemSize();
+
+        const uint64_t start = offset_;
+        if(!put(&rec, sizeof(rec)) || !put(m.data, rec.dataBytes) || !padTo(framelog::alignUp(offset_)))
+            return false;
+        offsets_.push_back(start);
+        return true;
+    }
+
+    bool padTo(uint64_t target)
+    {
+        static const char zeros[framelog::ALIGN] = {};
+        return target <= offset_ || put(zeros, target - offset_);
+    }
+
+    std::FILE* file_ = nullptr;
+    uint64_t offset_ = 0;               // Writer thread only (and close())
+    std::vector<uint64_t> offsets_;     // Record offsets for the index
+
+    std::vector<Pending> pool_;
+    std::deque<size_t> free_;
+    std::deque<size_t> queue_;
+    uint64_t nextIndex_ = 0;
+    bool closing_ = false;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread worker_;
+    Stats stats_;
+};
+
+// ==================== READER ====================
+// Frames are read-only views into the mapping: they stay valid as long as
+// the reader exists. clone() a frame that has to live longer.
+class FrameLogReader
+{
+public:
+    explicit FrameLogReader(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            std::cerr << "IGV::ERROR::Cannot open frame log " << path << std::endl;
+            return;
+        }
+
+        struct stat st;
+        if(::fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(framelog::FileHeader))
+        {
+            size_ = (size_t)st.st_size;
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if(p != MAP_FAILED)
+            {
+                base_ = static_cast<const uint8_t*>(p);
+                // Replay reads front to back
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);        // The mapping stays valid without the descriptor
+
+        if(!base_ || std::memcmp(base_, framelog::FILE_MAGIC, sizeof(framelog::FILE_MAGIC)) != 0)
+        {
+            std::cerr << "IGV::ERROR::" << path << " is not a frame log" << std::endl;
+            unmap();
+            return;
+        }
+
+        if(!loadIndex()) rebuildIndex();
+    }
+
+    ~FrameLogReader()
+    {
+        unmap();
+    }
+
+    FrameLogReader(const FrameLogReader&) = delete;
+    FrameLogReader& operator=(const FrameLogReader&) = delete;
+
+    bool isOpened() const { return base_ != nullptr; }
+    size_t frameCount() const { return offsets_.size(); }
+
+    // False when the log had no index (recording was not closed cleanly)
+    bool hadIndex() const { return hadIndex_; }
+
+    // Frame i as a header over the mapped file (no copy)
+    cv::Mat frame(size_t i) const
+    {
+        const framelog::RecordHeader* rec = record(i);
+        if(!rec) return cv::Mat();
+        uint8_t* pixels = const_cast<uint8_t*>(base_ + offsets_[i] + rec->headerBytes);
+        return cv::Mat(rec->rows, rec->cols, rec->type, pixels);
+    }
+
+    int64_t timestampNs(size_t i) const
+    {
+        const framelog::RecordHeader* rec = record(i);
+        return rec ? rec->timestampNs : 0;
+    }
+
+    // Index the recorder gave the frame (gaps = frames dropped while recording)
+    uint64_t recordedIndex(size_t i) const
+    {
+        const framelog::RecordHeader* rec = record(i);
+        return rec ? rec->index : 0;
+    }
+
+    PixelFormat format(size_t i = 0) const
+    {
+        const framelog::RecordHeader* rec = record(i);
+        return rec ? (PixelFormat)rec->format : PixelFormat::BGR;
+    }
+
+    // Image size (not buffer size) of frame i
+    cv::Size frameSize(size_t i = 0) const
+    {
+        const framelog::RecordHeader* rec = record(i);
+        if(!rec) return cv::Size();
+        PixelFormat fmt = (PixelFormat)rec->format;
+        int h = (fmt == PixelFormat::NV12 || fmt == PixelFormat::I420) ? rec->rows * 2 / 3 : rec->rows;
+        return cv::Size(rec->cols, h);
+    }
+
+    // Mean frame rate of the recording (0 if unknown)
+    double fps() const
+    {
+        size_t n = frameCount();
+        if(n < 2) return 0;
+        int64_t span = timestampNs(n - 1) - timestampNs(0);
+        return (span > 0) ? (double)(n - 1) * 1e9 / span : 0;
+    }
+
+private:
+    const framelog::RecordHeader* record(size_t i) const
+    {
+        if(i >= offsets_.size()) return nullptr;
+        return reinterpret_cast<const framelog::RecordHeader*>(base_ + offsets_[i]);
+    }
+
+    // Record at "offset" is complete and inside the file. A header shorter
+    // than RecordHeader is corrupt (and would not move rebuildIndex() on)
+    bool validRecord(uint64_t offset) const
+    {
+        if(offset + sizeof(framelog::RecordHeader) > size_) return false;
+        const framelog::RecordHeader* rec =
+            reinterpret_cast<const framelog::RecordHeader*>(base_ + offset);
+        return rec->magic == framelog::RECORD_MAGIC
+            && rec->headerBytes >= sizeof(framelog::RecordHeader)
+            && rec->dataBytes == (uint64_t)rec->rows * rec->cols * CV_ELEM_SIZE(rec->type)
+            && rec->headerBytes <= size_ - offset
+            && rec->dataBytes <= size_ - offset - rec->headerBytes;
+    }
+
+    bool loadIndex()
+    {
+        if(size_ < 2 * sizeof(framelog::Trailer)) return false;
+        const framelog::Trailer* t =
+            reinterpret_cast<const framelog::Trailer*>(base_ + size_ - sizeof(framelog::Trailer));
+        if(t->magic != framelog::TRAILER_MAGIC) return false;
+        if(t->indexOffset + t->count * sizeof(uint64_t) > size_) return false;
+
+        const uint64_t* index = reinterpret_cast<const uint64_t*>(base_ + t->indexOffset);
+        offsets_.assign(index, index + t->count);
+        for(uint64_t off : offsets_)
+        {
+            if(!validRecord(off)) { offsets_.clear(); return false; }
+        }
+        hadIndex_ = true;
+        return true;
+    }
+
+    void rebuildIndex()
+    {
+        offsets_.clear();
+        uint64_t off = sizeof(framelog::FileHeader);
+        while(validRecord(off))
+        {
+            offsets_.push_back(off);
+            const framelog::RecordHeader* rec =
+                reinterpret_cast<const framelog::RecordHeader*>(base_ + off);
+            off = framelog::alignUp(off + rec->headerBytes + rec->dataBytes);
+        }
+    }
+
+    void unmap()
+    {
+        if(base_) ::munmap(const_cast<uint8_t*>(base_), size_);
+        base_ = nullptr;
+        size_ = 0;
+        offsets_.clear();
+    }
+
+    const uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint64_t> offsets_;
+    bool hadIndex_ = false;
+};
+
+} // namespace igv
+
+#endif // IGV_FRAME_LOG_HPP
@@ -0,0 +1,747 @@
+/*****************************************************************************************
+ *  File Name   : FrameSource.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      One interface for every place frames can come from, so the same
+ *      perception binary runs on the Jetson and on any Linux box.
+ *
+ *      Source spec strings (first program argument of the lessons):
+ *          csi[:WxH[@FPS]]                 Jetson CSI camera (nvarguscamerasrc)
+ *          gst:<pipeline ending in appsink>
+ *          v4l2:<index or /dev/videoN>[:WxH[@FPS]]
+ *          v4l2mmap:</dev/videoN>[:WxH[@FPS]][,options]   Native V4L2 streaming (V4l2Capture.hpp)
+ *          file:<video file>[,options]     Video replay
+ *          image:<a.jpg>[+<b.png>...][,options]   Image replay (cycles the list)
+ *          synthetic[:WxH[@FPS]][,options] Deterministic generated road scene
+ *          log:<file.igvlog>[,options]     Raw frame log replay (FrameLog.hpp)
+ *
+ *      Options for the replay / synthetic sources:
+ *          frames=N    stop after N frames (default: end of file / endless)
+ *          fast        ignore FPS, deliver frames as fast as possible
+ *
+ *      Pixel format options (default bgr):
+ *          nv12 | i420 luma-only processing path: gray is a view of the Y plane
+ *          gray        single-channel frames
+ *          y10 | y12 | y16 | yuyv   raw sensor formats (v4l2mmap default: gray)
+ *
+ *          csi         bgr, nv12, i420, gray (what nvvidconv can write)
+ *          v4l2mmap    all but i420
+ *          image / synthetic   all (converted from BGR)
+ *          file / log / v4l2   none (BGR, or the format stored in the log)
+ *
+ *      A format or option the source cannot deliver is an error (nullptr),
+ *      not silently ignored: frames are never labelled with a format they
+ *      are not in.
+ *
+ *      Options for v4l2mmap:
+ *          buffers=N   driver queue depth (default 6)
+ *          dmabuf      also export every buffer as a DMABUF fd
+ *          crop=WxH+L+T   sensor-side crop window (only it crosses CSI-2)
+ *          crop=bottomP   keep the bottom P % of the rows (path ROI: bottom70)
+ *          subdev=/dev/v4l-subdevN   sensor subdevice for the crop
+ *
+ *      Built with -DIGV_WITH_GSTREAMER (build.sh does this when the GStreamer
+ *      dev packages are installed) the csi and gst sources read the appsink
+ *      directly and hand out frames without copying them (GstAppSink.hpp).
+ *
+ *      Examples:
+ *          ./14-IGV_Preception
+ *          ./14-IGV_Preception synthetic:1920x1080@60,frames=600,fast
+ *          ./15-ROI_to_map image:test.jpg+test1.png,frames=300
+ *          ./14-IGV_Preception csi:1280x720@60,nv12
+ *          ./14-IGV_Preception "gst:videotestsrc ! video/x-raw,format=NV12,width=1280,height=720 ! appsink"
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x, GStreamer
+*****************************************************************************************/
+
+#ifndef IGV_FRAME_SOURCE_HPP
+#define IGV_FRAME_SOURCE_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PixelFormat.hpp"
+#include "FrameLog.hpp"
+#include "V4l2Capture.hpp"
+#ifdef IGV_WITH_GSTREAMER
+#include "GstAppSink.hpp"
+#endif
+
+namespace igv
+{
+
+// ========== CSI CAMERA PIPELINE ==========
+// BGR  : nvarguscamerasrc -> NVMM (GPU memory) -> nvvidconv (HW) -> BGRx
+//        -> videoconvert (CPU) -> BGR -> appsink -> cv::Mat
+// NV12 / I420 / GRAY : nvvidconv (HW) writes the format directly, no CPU
+//        videoconvert at all. The gray image is the Y plane.
+inline std::string csiPipeline(int width, int height, int fps,
+                               PixelFormat fmt = PixelFormat::BGR)
+{
+    std::ostringstream ss;
+    ss << "nvarguscamerasrc ! "
+       << "video/x-raw(memory:NVMM), width=" << width << ", height=" << height
+       << ", framerate=" << fps << "/1 ! ";
+
+    switch(fmt)
+    {
+    case PixelFormat::NV12: ss << "nvvidconv ! video/x-raw, format=NV12 ! "; break;
+    case PixelFormat::I420: ss << "nvvidconv ! video/x-raw, format=I420 ! "; break;
+    case PixelFormat::GRAY: ss << "nvvidconv ! video/x-raw, format=GRAY8 ! "; break;
+    default:
+        ss << "nvvidconv ! video/x-raw, format=BGRx ! "
+           << "videoconvert ! video/x-raw, format=BGR ! ";
+        break;
+    }
+
+    // Keep only the newest buffer in the sink (cv::VideoCapture forces the
+    // same, the native appsink reader takes the pipeline as written)
+    ss << "appsink max-buffers=1 drop=true sync=false";
+    return ss.str();
+}
+
+// ==================== FRAME SOURCE INTERFACE ====================
+class FrameSource
+{
+public:
+    virtual ~FrameSource() = default;
+
+    virtual bool isOpened() const = 0;
+    virtual cv::Size frameSize() const = 0;
+    virtual double fps() const = 0;
+    virtual std::string name() const = 0;
+
+    // Live sources (cameras) run at their own pace and can lose frames.
+    // Replay / synthetic sources never lose frames and can run faster than realtime.
+    virtual bool isLive() const = 0;
+
+    // Layout of the frames read() delivers (see PixelFormat.hpp)
+    virtual PixelFormat format() const { return PixelFormat::BGR; }
+
+    // True when read() returns views of pipeline / driver buffers instead of
+    // filling the caller's Mat. Such frames are read-only, and holding them
+    // keeps the buffer away from the producer.
+    virtual bool borrowsBuffers() const { return false; }
+
+    // True when lastTimestampNs() is the time stored in a recording, not a
+    // capture time on this run's steady clock (no latency can be taken from it)
+    virtual bool recordedTimestamps() const { return false; }
+
+    // Where the frames sit in the full sensor image. Only differs from the
+    // frame itself when the sensor crops (see SensorRoi.hpp)
+    virtual cv::Size sensorSize() const { return frameSize(); }
+    virtual cv::Rect sensorCrop() const { return cv::Rect(cv::Point(0, 0), frameSize()); }
+
+    // Reads the next frame. Returns false at end of stream.
+    bool read(cv::Mat& frame)
+    {
+        if(maxFrames_ > 0 && framesRead_ >= maxFrames_) return false;
+        if(!readFrame(frame) || frame.empty()) return false;
+
+        // Throttle replay sources to their nominal FPS (unless "fast")
+        if(!isLive() && !fast_ && fps() > 0)
+        {
+            auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<double>(1.0 / fps()));
+            if(framesRead_ == 0) nextDue_ = std::chrono::steady_clock::now();
+            std::this_thread::sleep_until(nextDue_);
+            nextDue_ += period;
+        }
+
+        lastTimestampNs_ = frameTimestampNs();
+        framesRead_++;
+        return true;
+    }
+
+    uint64_t framesRead() const { return framesRead_; }
+
+    // Capture time of the frame returned by the last read() (steady clock ns)
+    int64_t lastTimestampNs() const { return lastTimestampNs_; }
+
+    void setMaxFrames(uint64_t n) { maxFrames_ = n; }
+    void setFast(bool fast) { fast_ = fast; }
+
+protected:
+    virtual bool readFrame(cv::Mat& frame) = 0;
+
+    // Default: the moment the frame reached the application.
+    // Replay sources return the time stored with the frame.
+    virtual int64_t frameTimestampNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    uint64_t framesRead_ = 0;
+    int64_t lastTimestampNs_ = 0;
+    uint64_t maxFrames_ = 0;
+    bool fast_ = false;
+    std::chrono::steady_clock::time_point nextDue_;
+};
+
+// ==================== BACKEND: cv::VideoCapture ====================
+// Used for the GStreamer pipelines, V4L2 devices and video file replay
+class CaptureSource : public FrameSource
+{
+public:
+    CaptureSource(const std::string& what, int apiPreference, bool live, const std::string& label,
+                  PixelFormat fmt = PixelFormat::BGR)
+        : cap_(what, apiPreference), live_(live), label_(label), format_(fmt)
+    {
+    }
+
+    CaptureSource(int index, int apiPreference, const std::string& label)
+        : cap_(index, apiPreference), live_(true), label_(label)
+    {
+    }
+
+    bool isOpened() const override { return cap_.isOpened(); }
+
+    cv::Size frameSize() const override
+    {
+        return cv::Size((int)cap_.get(cv::CAP_PROP_FRAME_WIDTH),
+                        (int)cap_.get(cv::CAP_PROP_FRAME_HEIGHT));
+    }
+
+    double fps() const override { return cap_.get(cv::CAP_PROP_FPS); }
+    std::string name() const override { return label_; }
+    bool isLive() const override { return live_; }
+    PixelFormat format() const override { return format_; }
+
+    cv::VideoCapture& capture() { return cap_; }
+
+protected:
+    bool readFrame(cv::Mat& frame) override
+    {
+        return cap_.read(frame);
+    }
+
+private:
+    cv::VideoCapture cap_;
+    bool live_;
+    std::string label_;
+    PixelFormat format_ = PixelFormat::BGR;
+};
+
+#ifdef IGV_WITH_GSTREAMER
+// ==================== BACKEND: NATIVE APPSINK (ZERO COPY) ====================
+class AppSinkSource : public FrameSource
+{
+public:
+    AppSinkSource(const std::string& pipeline, const std::string& label)
+        : reader_(pipeline), label_(label)
+    {
+    }
+
+    bool isOpened() const override { return reader_.isOpened(); }
+    cv::Size frameSize() const override { return reader_.frameSize(); }
+    double fps() const override { return reader_.fps(); }
+    std::string name() const override { return label_; }
+    bool isLive() const override { return reader_.isLive(); }
+    PixelFormat format() const override { return reader_.format(); }
+    bool borrowsBuffers() const override { return true; }
+
+    GstAppSinkReader& reader() { return reader_; }
+
+protected:
+    bool readFrame(cv::Mat& frame) override
+    {
+        return reader_.read(frame);
+    }
+
+private:
+    GstAppSinkReader reader_;
+    std::string label_;
+};
+#endif
+
+// ==================== BACKEND: NATIVE V4L2 (ZERO COPY) ====================
+class V4l2MmapSource : public FrameSource
+{
+public:
+    explicit V4l2MmapSource(const V4l2Capture::Options& opt)
+        : cap_(opt)
+    {
+    }
+
+    bool isOpened() const override { return cap_.isOpened(); }
+    cv::Size frameSize() const override { return cap_.frameSize(); }
+    double fps() const override { return cap_.fps(); }
+    std::string name() const override { return "v4l2 mmap"; }
+    bool isLive() const override { return true; }
+    PixelFormat format() const override { return cap_.format(); }
+    bool borrowsBuffers() const override { return true; }
+    cv::Size sensorSize() const override { return cap_.sensorSize(); }
+    cv::Rect sensorCrop() const override { return cap_.crop(); }
+
+    V4l2Capture& capture() { return cap_; }
+
+protected:
+    bool readFrame(cv::Mat& frame) override
+    {
+        return cap_.read(frame);
+    }
+
+    // Driver timestamp (CLOCK_MONOTONIC): time the frame was captured
+    int64_t frameTimestampNs() override
+    {
+        return cap_.lastTimestampNs();
+    }
+
+private:
+    V4l2Capture cap_;
+};
+
+// ==================== BACKEND: IMAGE REPLAY ====================
+// Cycles through a list of still images (e.g. test.jpg, test1.png).
+// All images are resized to the size of the first one.
+class ImageReplaySource : public FrameSource
+{
+public:
+    ImageReplaySource(const std::vector<std::string>& paths, double fps,
+                      PixelFormat fmt = PixelFormat::BGR)
+        : fps_(fps), format_(fmt)
+    {
+        for(const std::string& path : paths)
+        {
+            cv::Mat img = cv::imread(path, cv::IMREAD_COLOR);
+            if(img.empty())
+            {
+                std::cerr << "IGV::ERROR::Cannot load image " << path << std::endl;
+                images_.clear();
+                return;
+            }
+            if(!images_.empty() && img.size() != images_[0].size())
+            {
+                cv::resize(img, img, images_[0].size());
+            }
+            images_.push_back(img);
+        }
+        if(!images_.empty()) size_ = images_[0].size();
+
+        // Convert once at load time, replay is then a plain copy
+        for(cv::Mat& img : images_)
+        {
+            img = convertFromBgr(img, fmt);
+        }
+    }
+
+    bool isOpened() const override { return !images_.empty(); }
+    cv::Size frameSize() const override { return size_; }
+    double fps() const override { return fps_; }
+    std::string name() const override { return "image replay"; }
+    bool isLive() const override { return false; }
+    PixelFormat format() const override { return format_; }
+
+protected:
+    bool readFrame(cv::Mat& frame) override
+    {
+        if(images_.empty()) return false;
+
+        // Copy into the caller's buffer: consumers draw on the frame
+        images_[next_].copyTo(frame);
+        next_ = (next_ + 1) % images_.size();
+        return true;
+    }
+
+private:
+    std::vector<cv::Mat> images_;
+    size_t next_ = 0;
+    double fps_;
+    PixelFormat format_;
+    cv::Size size_;
+};
+
+// ==================== BACKEND: RAW FRAME LOG REPLAY ====================
+// Frames are views into the mapped log file (no copy, no decode).
+// Default pace: the recorded frame rate; ",fast" replays unthrottled.
+class LogReplaySource : public FrameSource
+{
+public:
+    explicit LogReplaySource(const std::string& path)
+        : log_(path)
+    {
+    }
+
+    bool isOpened() const override { return log_.isOpened() && log_.frameCount() > 0; }
+    cv::Size frameSize() const override { return log_.frameSize(); }
+    double fps() const override { return log_.fps(); }
+    std::string name() const override { return "log replay"; }
+    bool isLive() const override { return false; }
+    PixelFormat format() const override { return log_.format(); }
+    bool borrowsBuffers() const override { return true; }
+    bool recordedTimestamps() const override { return true; }
+
+    const FrameLogReader& log() const { return log_; }
+
+protected:
+    bool readFrame(cv::Mat& frame) override
+    {
+        if(next_ >= log_.frameCount()) return false;
+        current_ = next_++;
+        frame = log_.frame(current_);
+        return true;
+    }
+
+    int64_t frameTimestampNs() override
+    {
+        return log_.timestampNs(current_);
+    }
+
+private:
+    FrameLogReader log_;
+    size_t next_ = 0;
+    size_t current_ = 0;
+};
+
+// ==================== BACKEND: SYNTHETIC ROAD SCENE ====================
+// Deterministic generator: the same frame index always gives the same image.
+//  - Bright path (trapezoid) on a darker ground, swaying left/right
+//  - Fixed sensor-like noise pattern
+//  - An obstacle that crosses the path every few seconds (motion stop test)
+class SyntheticSource : public FrameSource
+{
+public:
+    SyntheticSource(cv::Size size, double fps, PixelFormat fmt = PixelFormat::BGR)
+        : size_(size), fps_(fps), format_(fmt)
+    {
+        // Noise plane built once with a fixed seed (cheap per frame)
+        noise_.create(size_, CV_8UC3);
+        uint32_t state = 0x1234567u;
+        for(int y = 0; y < size_.height; y++)
+        {
+            uchar* row = noise_.ptr<uchar>(y);
+            for(int x = 0; x < size_.width; x++)
+            {
+                state = state * 1664525u + 1013904223u;     // LCG
+                uchar v = (uchar)(state >> 28);               // 0..15
+                row[3 * x + 0] = v;
+                row[3 * x + 1] = v;
+                row[3 * x + 2] = v;
+            }
+        }
+    }
+
+    bool isOpened() const override { return size_.area() > 0; }
+    cv::Size frameSize() const override { return size_; }
+    double fps() const override { return fps_; }
+    std::string name() const override { return "synthetic"; }
+    bool isLive() const override { return false; }
+    PixelFormat format() const override { return format_; }
+
+protected:
+    bool readFrame(cv::Mat& frame) override
+    {
+        const int w = size_.width;
+        const int h = size_.height;
+        const double t = (double)index_ / (fps_ > 0 ? fps_ : 60.0);
+
+        // The scene is drawn in BGR, then converted if another format was asked
+        cv::Mat& bgr = (format_ == PixelFormat::BGR) ? frame : scene_;
+        bgr.create(size_, CV_8UC3);
+
+        // Sky / background (top 30%) and ground
+        bgr(cv::Rect(0, 0, w, h * 3 / 10)).setTo(cv::Scalar(200, 170, 140));
+        bgr(cv::Rect(0, h * 3 / 10, w, h - h * 3 / 10)).setTo(cv::Scalar(60, 70, 70));
+
+        // Path: trapezoid from the horizon to the bottom edge, swaying slowly
+        int sway = (int)(0.15 * w * std::sin(2.0 * CV_PI * t / 6.0));
+        std::vector<cv::Point> path = {
+            cv::Point(w / 2 - w / 20 + sway / 2, h * 3 / 10),
+            cv::Point(w / 2 + w / 20 + sway / 2, h * 3 / 10),
+            cv::Point(w / 2 + w / 4 + sway, h - 1),
+            cv::Point(w / 2 - w / 4 + sway, h - 1)
+        };
+        cv::fillConvexPoly(bgr, path, cv::Scalar(210, 210, 210));
+
+        // Obstacle crossing the path for 1 s out of every 4 s
+        double phase = std::fmod(t, 4.0);
+        if(phase < 1.0)
+        {
+            int bx = (int)(phase * w);
+            cv::rectangle(bgr, cv::Rect(bx - w / 16, h / 2, w / 8, h / 4),
+                          cv::Scalar(20, 20, 160), cv::FILLED);
+        }
+
+        // Fixed noise pattern, rolled by a few rows per frame so it is not static
+        int shift = (int)(index_ % 16) % h;
+        cv::Mat top = bgr.rowRange(0, h - shift);
+        cv::Mat bottom = bgr.rowRange(h - shift, h);
+        cv::add(top, noise_.rowRange(shift, h), top);
+        if(shift > 0) cv::add(bottom, noise_.rowRange(0, shift), bottom);
+
+        if(format_ != PixelFormat::BGR)
+        {
+            frame = convertFromBgr(scene_, format_, frame);
+        }
+
+        index_++;
+        return true;
+    }
+
+private:
+    cv::Size size_;
+    double fps_;
+    PixelFormat format_;
+    cv::Mat noise_;
+    cv::Mat scene_;
+    uint64_t index_ = 0;
+};
+
+// ==================== SPEC PARSING ====================
+namespace detail
+{
+    // "1280x720@60" -> size + fps (keeps the defaults for missing parts)
+    inline void parseMode(const std::string& s, cv::Size& size, double& fps)
+    {
+        if(s.empty()) return;
+        int w = 0, h = 0;
+        double f = 0;
+        size_t at = s.find('@');
+        if(std::sscanf(s.substr(0, at).c_str(), "%dx%d", &w, &h) == 2)
+        {
+            size = cv::Size(w, h);
+        }
+        if(at != std::string::npos && std::sscanf(s.c_str() + at + 1, "%lf", &f) == 1)
+        {
+            fps = f;
+        }
+    }
+
+    // "WxH+L+T" window, or "bottomP": bottom P percent (fraction in cropTop)
+    // Returns false (and prints why) for anything else
+    inline bool parseCrop(const std::string& s, cv::Rect& rect, double& cropTop)
+    {
+        int w = 0, h = 0, l = 0, t = 0, p = 0;
+        if(std::sscanf(s.c_str(), "bottom%d", &p) == 1 && p > 0 && p <= 100)
+        {
+            cropTop = (100 - p) / 100.0;
+            return true;
+        }
+        if(std::sscanf(s.c_str(), "%dx%d+%d+%d", &w, &h, &l, &t) == 4 && w > 0 && h > 0 && l >= 0 && t >= 0)
+        {
+            rect = cv::Rect(l, t, w, h);
+            return true;
+        }
+        std::cerr << "IGV::ERROR::Bad crop \"" << s << "\" (WxH+L+T or bottomP)" << std::endl;
+        return false;
+    }
+
+    // Pixel format option ("nv12", "gray", ...); false for other options
+    inline bool parseFormat(const std::string& s, PixelFormat& fmt)
+    {
+        if(s == "bgr") fmt = PixelFormat::BGR;
+        else if(s == "nv12") fmt = PixelFormat::NV12;
+        else if(s == "i420") fmt = PixelFormat::I420;
+        else if(s == "gray") fmt = PixelFormat::GRAY;
+        else if(s == "y10") fmt = PixelFormat::Y10;
+        else if(s == "y12") fmt = PixelFormat::Y12;
+        else if(s == "y16") fmt = PixelFormat::Y16;
+        else if(s == "yuyv") fmt = PixelFormat::YUYV;
+        else return false;
+        return true;
+    }
+
+    inline std::vector<std::string> split(const std::string& s, char sep)
+    {
+        std::vector<std::string> parts;
+        std::stringstream ss(s);
+        std::string item;
+        while(std::getline(ss, item, sep)) parts.push_back(item);
+        return parts;
+    }
+}
+
+// Creates a source from a spec string (see top of file).
+// Returns nullptr for an unknown spec; check isOpened() for open failures.
+inline std::unique_ptr<FrameSource> openFrameSource(const std::string& spec)
+{
+    size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    std::string rest = (colon == std::string::npos) ? "" : spec.substr(colon + 1);
+
+    // GStreamer pipelines contain commas, so they take the rest verbatim
+    if(kind == "gst")
+    {
+#ifdef IGV_WITH_GSTREAMER
+        return std::unique_ptr<FrameSource>(new AppSinkSource(rest, "gstreamer"));
+#else
+        return std::unique_ptr<FrameSource>(
+            new CaptureSource(rest, cv::CAP_GSTREAMER, true, "gstreamer"));
+#endif
+    }
+
+    // Split off ",frames=N,fast" options
+    std::vector<std::string> parts = detail::split(rest, ',');
+    std::string main = parts.empty() ? "" : parts[0];
+    uint64_t maxFrames = 0;
+    bool fast = false;
+    PixelFormat fmt = (kind == "v4l2mmap") ? PixelFormat::GRAY : PixelFormat::BGR;
+    int buffers = 6;
+    bool dmabuf = false;
+    cv::Rect crop;
+    double cropTop = 0;
+    std::string subdevice;
+    std::string fmtOption;          // Format option given, if any
+    std::string captureOption;      // v4l2mmap-only option given, if any
+    for(size_t i = 1; i < parts.size(); i++)
+    {
+        const std::string& opt = parts[i];
+        PixelFormat optFmt;
+        if(opt == "fast") fast = true;
+        else if(detail::parseFormat(opt, optFmt))
+        {
+            fmt = optFmt;
+            fmtOption = opt;
+        }
+        else if(opt.compare(0, 7, "frames=") == 0) maxFrames = std::strtoull(opt.c_str() + 7, nullptr, 10);
+        else
+        {
+            if(opt == "dmabuf") dmabuf = true;
+            else if(opt.compare(0, 5, "crop=") == 0)
+            {
+                if(!detail::parseCrop(opt.substr(5), crop, cropTop)) return nullptr;
+            }
+            else if(opt.compare(0, 7, "subdev=") == 0) subdevice = opt.substr(7);
+            else if(opt.compare(0, 8, "buffers=") == 0) buffers = std::atoi(opt.c_str() + 8);
+            else
+            {
+                std::cerr << "IGV::ERROR::Unknown option \"" << opt << "\" in frame source \"" << spec << "\"" << std::endl;
+                return nullptr;
+            }
+            captureOption = opt;
+        }
+    }
+
+    // Options the source cannot honour (see top of file)
+    bool fmtSupported = true;
+    if(kind == "csi")
+        fmtSupported = fmt == PixelFormat::BGR || fmt == PixelFormat::NV12 ||
+                       fmt == PixelFormat::I420 || fmt == PixelFormat::GRAY;
+    else if(kind == "v4l2mmap") fmtSupported = fmt != PixelFormat::I420;
+    else if(kind == "file" || kind == "log" || kind == "v4l2") fmtSupported = fmtOption.empty();
+    if(!fmtSupported)
+    {
+        std::cerr << "IGV::ERROR::Frame source \"" << kind << "\" cannot deliver format \"" << fmtOption << "\"" << std::endl;
+        return nullptr;
+    }
+    if(!captureOption.empty() && kind != "v4l2mmap")
+    {
+        std::cerr << "IGV::ERROR::Option \"" << captureOption << "\" needs a v4l2mmap source" << std::endl;
+        return nullptr;
+    }
+
+    std::unique_ptr<FrameSource> source;
+
+    if(kind == "csi")
+    {
+        cv::Size size(1280, 720);
+        double fps = 60;
+        detail::parseMode(main, size, fps);
+#ifdef IGV_WITH_GSTREAMER
+        source.reset(new AppSinkSource(csiPipeline(size.width, size.height, (int)fps, fmt), "csi"));
+#else
+        source.reset(new CaptureSource(csiPipeline(size.width, size.height, (int)fps, fmt),
+                                       cv::CAP_GSTREAMER, true, "csi", fmt));
+#endif
+    }
+    else if(kind == "v4l2")
+    {
+        // "0" or "/dev/video0", optionally followed by ":WxH@FPS"
+        size_t modeSep = main.find(':');
+        std::string device = main.substr(0, modeSep);
+        CaptureSource* cs;
+        if(!device.empty() && device.find_first_not_of("0123456789") == std::string::npos)
+            cs = new CaptureSource(std::atoi(device.c_str()), cv::CAP_V4L2, "v4l2");
+        else
+            cs = new CaptureSource(device, cv::CAP_V4L2, true, "v4l2");
+
+        if(modeSep != std::string::npos)
+        {
+            cv::Size size;
+            double fps = 0;
+            detail::parseMode(main.substr(modeSep + 1), size, fps);
+            if(size.area() > 0)
+            {
+                cs->capture().set(cv::CAP_PROP_FRAME_WIDTH, size.width);
+                cs->capture().set(cv::CAP_PROP_FRAME_HEIGHT, size.height);
+            }
+            if(fps > 0) cs->capture().set(cv::CAP_PROP_FPS, fps);
+        }
+        source.reset(cs);
+    }
+    else if(kind == "v4l2mmap")
+    {
+        // "/dev/video0", optionally followed by ":WxH@FPS"
+        size_t modeSep = main.find(':');
+        V4l2Capture::Options opt;
+        opt.device = main.substr(0, modeSep);
+        opt.format = fmt;
+        opt.buffers = buffers;
+        opt.exportDmabuf = dmabuf;
+        opt.crop = crop;
+        opt.cropTop = cropTop;
+        opt.subdevice = subdevice;
+        if(modeSep != std::string::npos) detail::parseMode(main.substr(modeSep + 1), opt.size, opt.fps);
+        source.reset(new V4l2MmapSource(opt));
+    }
+    else if(kind == "file")
+    {
+        source.reset(new CaptureSource(main, cv::CAP_ANY, false, "file replay"));
+    }
+    else if(kind == "image")
+    {
+        source.reset(new ImageReplaySource(detail::split(main, '+'), 30.0, fmt));
+    }
+    else if(kind == "log")
+    {
+        source.reset(new LogReplaySource(main));
+    }
+    else if(kind == "synthetic")
+    {
+        cv::Size size(1280, 720);
+        double fps = 60;
+        detail::parseMode(main, size, fps);
+        source.reset(new SyntheticSource(size, fps, fmt));
+    }
+    else
+    {
+        std::cerr << "IGV::ERROR::Unknown frame source \"" << spec << "\"" << std::endl;
+        return nullptr;
+    }
+
+    source->setMaxFrames(maxFrames);
+    source->setFast(fast);
+    return source;
+}
+
+// Source of the camera programs: first argument, or "fallback" without one.
+// Returns nullptr when the spec is unknown or the source did not open.
+inline std::unique_ptr<FrameSource> openFrameSourceArg(int argc, char** argv,
+                                                       const std::string& fallback = "csi:1280x720@60")
+{
+    std::unique_ptr<FrameSource> source = openFrameSource((argc > 1) ? argv[1] : fallback);
+    if(source && !source->isOpened()) source.reset();
+    return source;
+}
+
+} // namespace igv
+
+#endif // IGV_FRAME_SOURCE_HPP
@@ -0,0 +1,429 @@
+/*****************************************************************************************
+ *  File Name   : FusedCanny.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat only)
+ *
+ *  Description :
+ *      cvtColor(BGR2GRAY) -> GaussianBlur(5x5, sigma 0) -> Canny(low, high),
+ *      the edge pipeline of 05-Edge_pipeline and test.cpp, in one pass over
+ *      the frame instead of three full-frame passes and two intermediate
+ *      images:
+ *
+ *          per row    : gray (5-row ring) -> blur (3-row ring) -> Sobel dx,
+ *                       dy, |dx| + |dy| (3-row ring) -> non-max suppression
+ *                       into the edge map. Each stage reads rows the one
+ *                       before wrote a moment ago, still in L1.
+ *          per tile   : every "tileRows" output rows (default 32, ~60 KB of
+ *                       map at 1080p), hysteresis on the tile while its map
+ *                       is in cache, then the tile's output rows.
+ *          stitching  : edges that continue across a tile border, grown
+ *                       once all tiles are done (usually a few pixels).
+ *
+ *      threads > 1 splits the rows into bands (igv/RowBands.hpp), each band
+ *      its own tiles; a band recomputes the 4 source rows of halo it needs
+ *      on each side.
+ *
+ *      Same pixels as the OpenCV chain (L1 gradient, aperture 3):
+ *          gray, blur : GrayBlurOtsu.hpp kernels (bit-exact)
+ *          Sobel      : 3x3, BORDER_REPLICATE, 16-bit
+ *          NMS        : OpenCV's tan(22.5) / tan(67.5) sectors in 15-bit
+ *                       fixed point, same > / >= tie rules, zero magnitude
+ *                       outside the image
+ *          hysteresis : 8-connected growth of the NMS survivors above "low"
+ *                       from those above "high"
+ *      The result does not depend on the tile size or the thread count.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_FUSED_CANNY_HPP
+#define IGV_FUSED_CANNY_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "Simd.hpp"
+#include "GrayBlurOtsu.hpp"
+#include "RowBands.hpp"
+
+namespace igv
+{
+
+namespace canny
+{
+    const int TILE = 32;                            // Output rows per tile (default)
+    const int SHIFT = 15;
+    const int TG22 = 13573;                         // tan(22.5 deg) << SHIFT, rounded
+
+    // Edge map values
+    const uint8_t CANDIDATE = 0;                    // Survived NMS, above low
+    const uint8_t NONE = 1;
+    const uint8_t EDGE = 2;
+
+    // ==================== SOBEL ====================
+    // Blurred rows a (y - 1), b (y), c (y + 1) -> dx, dy, |dx| + |dy| for
+    // x in [x0, x1). Columns are replicated at both ends (n >= 2).
+    inline void sobelRowScalar(const uint8_t* a, const uint8_t* b, const uint8_t* c,
+                               int16_t* dx, int16_t* dy, int16_t* mag, int n, int x0, int x1)
+    {
+        for(int x = x0; x < x1; x++)
+        {
+            const int xl = std::max(x - 1, 0), xr = std::min(x + 1, n - 1);
+            const int gx = (a[xr] - a[xl]) + 2 * (b[xr] - b[xl]) + (c[xr] - c[xl]);
+            const int gy = (c[xl] + 2 * c[x] + c[xr]) - (a[xl] + 2 * a[x] + a[xr]);
+            dx[x] = (int16_t)gx;
+            dy[x] = (int16_t)gy;
+            mag[x] = (int16_t)(std::abs(gx) + std::abs(gy));
+        }
+    }
+
+    inline void sobelRow(const uint8_t* a, const uint8_t* b, const uint8_t* c,
+                         int16_t* dx, int16_t* dy, int16_t* mag, int n)
+    {
+        int x = 1;
+#if defined(IGV_SIMD_AVX2)
+        auto ld = [](const uint8_t* p) { return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)p)); };
+        for(; x <= n - 17; x += 16)                         // Reads x - 1 .. x + 16
+        {
+            __m256i al = ld(a + x - 1), ac = ld(a + x), ar = ld(a + x + 1);
+            __m256i bl = ld(b + x - 1), br = ld(b + x + 1);
+            __m256i cl = ld(c + x - 1), cc = ld(c + x), cr = ld(c + x + 1);
+            __m256i gx = _mm256_add_epi16(_mm256_add_epi16(_mm256_sub_epi16(ar, al), _mm256_sub_epi16(cr, cl)),
+                                          _mm256_slli_epi16(_mm256_sub_epi16(br, bl), 1));
+            __m256i gy = _mm256_sub_epi16(_mm256_add_epi16(_mm256_add_epi16(cl, cr), _mm256_slli_epi16(cc, 1)),
+                                          _mm256_add_epi16(_mm256_add_epi16(al, ar), _mm256_slli_epi16(ac, 1)));
+            _mm256_storeu_si256((__m256i*)(dx + x), gx);
+            _mm256_storeu_si256((__m256i*)(dy + x), gy);
+            _mm256_storeu_si256((__m256i*)(mag + x), _mm256_add_epi16(_mm256_abs_epi16(gx), _mm256_abs_epi16(gy)));
+        }
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        auto ld = [&](const uint8_t* p) { return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)p), zero); };
+        auto abs16 = [&](__m128i v) { return _mm_max_epi16(v, _mm_sub_epi16(zero, v)); };
+        for(; x <= n - 9; x += 8)                           // Reads x - 1 .. x + 8
+        {
+            __m128i al = ld(a + x - 1), ac = ld(a + x), ar = ld(a + x + 1);
+            __m128i bl = ld(b + x - 1), br = ld(b + x + 1);
+            __m128i cl = ld(c + x - 1), cc = ld(c + x), cr = ld(c + x + 1);
+            __m128i gx = _mm_add_epi16(_mm_add_epi16(_mm_sub_epi16(ar, al), _mm_sub_epi16(cr, cl)),
+                                       _mm_slli_epi16(_mm_sub_epi16(br, bl), 1));
+            __m128i gy = _mm_sub_epi16(_mm_add_epi16(_mm_add_epi16(cl, cr), _mm_slli_epi16(cc, 1)),
+                                       _mm_add_epi16(_mm_add_epi16(al, ar), _mm_slli_epi16(ac, 1)));
+            _mm_storeu_si128((__m128i*)(dx + x), gx);
+            _mm_storeu_si128((__m128i*)(dy + x), gy);
+            _mm_storeu_si128((__m128i*)(mag + x), _mm_add_epi16(abs16(gx), abs16(gy)));
+        }
+#elif defined(IGV_SIMD_NEON)
+        auto ld = [](const uint8_t* p) { return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p))); };
+        for(; x <= n - 9; x += 8)                           // Reads x - 1 .. x + 8
+        {
+            int16x8_t al = ld(a + x - 1), ac = ld(a + x), ar = ld(a + x + 1);
+            int16x8_t bl = ld(b + x - 1), br = ld(b + x + 1);
+            int16x8_t cl = ld(c + x - 1), cc = ld(c + x), cr = ld(c + x + 1);
+            int16x8_t gx = vaddq_s16(vaddq_s16(vsubq_s16(ar, al), vsubq_s16(cr, cl)), vshlq_n_s16(vsubq_s16(br, bl), 1));
+            int16x8_t gy = vsubq_s16(vaddq_s16(vaddq_s16(cl, cr), vshlq_n_s16(cc, 1)),
+                                     vaddq_s16(vaddq_s16(al, ar), vshlq_n_s16(ac, 1)));
+            vst1q_s16(dx + x, gx);
+            vst1q_s16(dy + x, gy);
+            vst1q_s16(mag + x, vaddq_s16(vabsq_s16(gx), vabsq_s16(gy)));
+        }
+#endif
+        sobelRowScalar(a, b, c, dx, dy, mag, n, 0, 1);
+        sobelRowScalar(a, b, c, dx, dy, mag, n, x, n);
+    }
+
+    // ==================== NON-MAX SUPPRESSION ====================
+    // Any of m[0..15] above low (most blocks of a frame are flat)
+    inline bool anyAbove16(const int16_t* m, int low)
+    {
+        low = std::min(low, 32767);
+#if defined(IGV_SIMD_AVX2)
+        const __m256i l = _mm256_set1_epi16((int16_t)low);
+        return _mm256_movemask_epi8(_mm256_cmpgt_epi16(_mm256_loadu_si256((const __m256i*)m), l)) != 0;
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i l = _mm_set1_epi16((int16_t)low);
+        __m128i gt = _mm_or_si128(_mm_cmpgt_epi16(_mm_loadu_si128((const __m128i*)m), l),
+                                  _mm_cmpgt_epi16(_mm_loadu_si128((const __m128i*)(m + 8)), l));
+        return _mm_movemask_epi8(gt) != 0;
+#elif defined(IGV_SIMD_NEON)
+        const int16x8_t l = vdupq_n_s16((int16_t)low);
+        uint16x8_t gt = vorrq_u16(vcgtq_s16(vld1q_s16(m), l), vcgtq_s16(vld1q_s16(m + 8), l));
+        return vmaxvq_u16(gt) != 0;
+#else
+        for(int i = 0; i < 16; i++)
+            if(m[i] > low) return true;
+        return false;
+#endif
+    }
+
+    // mp / mc / mn: magnitude of rows y - 1, y, y + 1, with a 0 at [-1] and
+    // [n]. Writes the map row and pushes the EDGE pixels.
+    inline void nmsRow(const int16_t* dx, const int16_t* dy,
+                       const int16_t* mp, const int16_t* mc, const int16_t* mn,
+                       uint8_t* map, int n, int low, int high, std::vector<uint8_t*>& stack)
+    {
+        for(int j0 = 0; j0 < n; j0 += 16)
+        {
+            const int j1 = std::min(j0 + 16, n);
+            if(j1 - j0 == 16 && !anyAbove16(mc + j0, low))
+            {
+                std::memset(map + j0, NONE, 16);
+                continue;
+            }
+            for(int j = j0; j < j1; j++)
+            {
+                const int m = mc[j];
+                uint8_t v = NONE;
+                if(m > low)
+                {
+                    const int xs = dx[j], ys = dy[j];
+                    const int x = std::abs(xs), y = std::abs(ys) << SHIFT;
+                    const int tg22x = x * TG22;
+                    bool peak;
+                    if(y < tg22x)                               // Horizontal gradient
+                        peak = m > mc[j - 1] && m >= mc[j + 1];
+                    else
+                    {
+                        const int tg67x = tg22x + (x << (SHIFT + 1));
+                        if(y > tg67x)                           // Vertical gradient
+                            peak = m > mp[j] && m >= mn[j];
+                        else                                    // Diagonal
+                        {
+                            const int s = ((xs ^ ys) < 0) ? -1 : 1;
+                            peak = m > mp[j - s] && m > mn[j + s];
+                        }
+                    }
+                    if(peak)
+                    {
+                        v = (m > high) ? EDGE : CANDIDATE;
+                        if(v == EDGE) stack.push_back(map + j);
+                    }
+                }
+                map[j] = v;
+            }
+        }
+    }
+
+    // ==================== HYSTERESIS ====================
+    // Grows EDGE into 8-connected CANDIDATE pixels of map rows [begin, end)
+    // (pointers into the map). onEdge(p) is called for every new EDGE pixel.
+    template<typename OnEdge>
+    inline void grow(std::vector<uint8_t*>& stack, const uint8_t* begin, const uint8_t* end,
+                     size_t step, OnEdge onEdge)
+    {
+        const ptrdiff_t s = (ptrdiff_t)step;
+        const ptrdiff_t offsets[8] = { -s - 1, -s, -s + 1, -1, 1, s - 1, s, s + 1 };
+        while(!stack.empty())
+        {
+            uint8_t* p = stack.back();
+            stack.pop_back();
+            for(ptrdiff_t o : offsets)
+            {
+                uint8_t* q = p + o;
+                if(q >= begin && q < end && *q == CANDIDATE)
+                {
+                    *q = EDGE;
+                    onEdge(q);
+                    stack.push_back(q);
+                }
+            }
+        }
+    }
+
+    inline void edgeRow(const uint8_t* map, uint8_t* __restrict d, int n)
+    {
+        for(int x = 0; x < n; x++)
+            d[x] = (map[x] == EDGE) ? 255 : 0;
+    }
+} // namespace canny
+
+// ==================== FUSED CANNY ====================
+class FusedCanny
+{
+public:
+    // Output rows per tile (hysteresis unit); any value gives the same edges
+    void setTileRows(int rows) { tileRows_ = std::max(1, rows); }
+    int tileRows() const { return tileRows_; }
+
+    // edges = Canny(GaussianBlur(gray(src), 5x5, 0), low, high)
+    //      src : BGR (CV_8UC3) or gray (CV_8UC1), at least 3x3
+    void apply(const cv::Mat& src, cv::Mat& edges, double low, double high, int threads = 1)
+    {
+        CV_Assert(src.type() == CV_8UC1 || src.type() == CV_8UC3);
+        CV_Assert(src.rows >= 3 && src.cols >= 3);
+        if(low > high) std::swap(low, high);
+        const int lo = (int)std::floor(low), hi = (int)std::floor(high);
+        const int w = src.cols, h = src.rows;
+
+        cv::Mat in = src;
+        if(edges.data == src.data) in = src.clone();
+        edges.create(src.size(), CV_8UC1);
+
+        // Map with a NONE frame: 1 column each side, 1 row above and below
+        step_ = (size_t)w + 2;
+        map_.resize(step_ * (h + 2));
+        std::memset(map_.data(), canny::NONE, step_);
+        std::memset(map_.data() + step_ * (h + 1), canny::NONE, step_);
+        tileStart_.assign(h, 0);
+
+        forRowBands(h, threads, [&](int y0, int y1) { band(in, edges, y0, y1, lo, hi); });
+        stitch(edges);
+    }
+
+    // Pixels the stitching pass added in the last frame (edges that crossed
+    // a tile border into a tile where they had no strong pixel)
+    int stitchedPixels() const { return stitched_; }
+
+private:
+    uint8_t* mapRow(int y) { return map_.data() + step_ * (y + 1) + 1; }
+
+    // Output rows [y0, y1)
+    void band(const cv::Mat& src, cv::Mat& edges, int y0, int y1, int low, int high)
+    {
+        const int w = src.cols, h = src.rows;
+        const bool bgr = src.channels() == 3;
+
+        // Rings: slot = row % size, held[slot] = row in it
+        std::vector<uint8_t> grayRing(bgr ? 5 * (size_t)w : 0), blurRing(3 * (size_t)w);
+        std::vector<uint16_t> vrow((size_t)w + 4);
+        std::vector<int16_t> dxRing(3 * (size_t)w), dyRing(3 * (size_t)w), magRing(3 * ((size_t)w + 2), 0);
+        const std::vector<int16_t> zeroMag((size_t)w + 2, 0);
+        int grayHeld[5], blurHeld[3], sobelHeld[3];
+        std::fill(grayHeld, grayHeld + 5, -1);
+        std::fill(blurHeld, blurHeld + 3, -1);
+        std::fill(sobelHeld, sobelHeld + 3, -1);
+        std::vector<uint8_t*> stack;
+        stack.reserve(1024);
+
+        auto grayAt = [&](int y) -> const uint8_t*
+        {
+            if(!bgr) return src.ptr<uint8_t>(y);
+            uint8_t* g = grayRing.data() + (size_t)(y % 5) * w;
+            if(grayHeld[y % 5] != y)
+            {
+                gbo::grayRow(src.ptr<uint8_t>(y), g, w);
+                grayHeld[y % 5] = y;
+            }
+            return g;
+        };
+
+        auto blurAt = [&](int y) -> const uint8_t*
+        {
+            uint8_t* b = blurRing.data() + (size_t)(y % 3) * w;
+            if(blurHeld[y % 3] != y)
+            {
+                const uint8_t* r[5];
+                for(int k = 0; k < 5; k++)
+                    r[k] = grayAt(cv::borderInterpolate(y + k - 2, h, cv::BORDER_REFLECT_101));
+                uint16_t* v = vrow.data() + 2;
+                gbo::verticalRow(r, v, w);
+                v[-1] = v[1]; v[-2] = v[2];                 // BORDER_REFLECT_101
+                v[w] = v[w - 2]; v[w + 1] = v[w - 3];
+                gbo::horizontalRow(v, b, w);
+                blurHeld[y % 3] = y;
+            }
+            return b;
+        };
+
+        // Slot of row y's Sobel, or -1 outside the image (zero magnitude)
+        auto sobelAt = [&](int y) -> int
+        {
+            if(y < 0 || y >= h) return -1;
+            const int slot = y % 3;
+            if(sobelHeld[slot] != y)
+            {
+                const uint8_t* a = blurAt(std::max(y - 1, 0));      // BORDER_REPLICATE
+                const uint8_t* b = blurAt(y);
+                const uint8_t* c = blurAt(std::min(y + 1, h - 1));
+                canny::sobelRow(a, b, c, dxRing.data() + (size_t)slot * w, dyRing.data() + (size_t)slot * w,
+                                magRing.data() + (size_t)slot * (w + 2) + 1, w);
+                sobelHeld[slot] = y;
+            }
+            return slot;
+        };
+        auto magOf = [&](int slot) -> const int16_t*
+        {
+            return (slot < 0 ? zeroMag.data() : magRing.data() + (size_t)slot * (w + 2)) + 1;
+        };
+
+        for(int t0 = y0; t0 < y1; t0 += tileRows_)
+        {
+            const int t1 = std::min(t0 + tileRows_, y1);
+            tileStart_[t0] = 1;
+            for(int y = t0; y < t1; y++)
+            {
+                const int p = sobelAt(y - 1), c = sobelAt(y), n = sobelAt(y + 1);
+                mapRow(y)[-1] = mapRow(y)[w] = canny::NONE;
+                canny::nmsRow(dxRing.data() + (size_t)c * w, dyRing.data() + (size_t)c * w,
+                              magOf(p), magOf(c), magOf(n), mapRow(y), w, low, high, stack);
+            }
+
+            // Hysteresis inside the tile, then its output rows
+            canny::grow(stack, mapRow(t0) - 1, mapRow(t1) - 1, step_, [](uint8_t*) {});
+            for(int y = t0; y < t1; y++)
+                canny::edgeRow(mapRow(y), edges.ptr<uint8_t>(y), w);
+        }
+    }
+
+    // Edges that cross tile borders: seed the CANDIDATE pixels next to an
+    // EDGE pixel of the other tile, then grow over the whole map
+    void stitch(cv::Mat& edges)
+    {
+        const int w = edges.cols, h = edges.rows;
+        std::vector<uint8_t*> stack;
+        stitched_ = 0;
+        uint8_t* const origin = map_.data() + step_ + 1;
+        auto mark = [&](uint8_t* q)
+        {
+            const size_t i = (size_t)(q - origin);
+            edges.ptr<uint8_t>((int)(i / step_))[i % step_] = 255;
+            stitched_++;
+        };
+
+        for(int y = 1; y < h; y++)
+        {
+            if(!tileStart_[y]) continue;
+            uint8_t* above = mapRow(y - 1);
+            uint8_t* below = mapRow(y);
+            for(int x = 0; x < w; x++)
+            {
+                uint8_t* from[2] = { above + x, below + x };
+                uint8_t* to[2] = { below + x, above + x };
+                for(int k = 0; k < 2; k++)
+                {
+                    if(*from[k] != canny::EDGE) continue;
+                    for(int dx = -1; dx <= 1; dx++)
+                    {
+                        uint8_t* q = to[k] + dx;
+                        if(*q == canny::CANDIDATE)
+                        {
+                            *q = canny::EDGE;
+                            mark(q);
+                            stack.push_back(q);
+                        }
+                    }
+                }
+            }
+        }
+        canny::grow(stack, mapRow(0) - 1, mapRow(h) - 1, step_, mark);
+    }
+
+    int tileRows_ = canny::TILE;
+    size_t step_ = 0;
+    std::vector<uint8_t> map_;
+    std::vector<uint8_t> tileStart_;                // Rows where a tile begins
+    int stitched_ = 0;
+};
+
+} // namespace igv
+
+#endif // IGV_FUSED_CANNY_HPP
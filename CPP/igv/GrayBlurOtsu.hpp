@@ -0,0 +1,651 @@
+/*****************************************************************************************
+ *  File Name   : GrayBlurOtsu.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat only)
+ *
+ *  Description :
+ *      cvtColor(BGR2GRAY) -> GaussianBlur(5x5, sigma 0) -> threshold(OTSU), the
+ *      preprocessing of the path programs, fused into two sweeps:
+ *
+ *          sweep 1 (blur)     : row by row, convert the 5 source rows the
+ *                               blur needs (kept in a 5-row ring), blur them,
+ *                               write the blurred row and count its histogram
+ *                               while it is still in L1. Otsu on the histogram.
+ *          sweep 2 (binarize) : blurred > threshold -> 255
+ *
+ *      Memory traffic per pixel (BGR input):
+ *          OpenCV chain : 3 + 1 (gray) + 1 + 1 (blur) + 1 (Otsu histogram)
+ *                         + 1 + 1 (threshold)                    = 9 bytes
+ *          fused        : 3 + 1 (blurred) + 1 + 1 (binary)       = 6 bytes
+ *      and one intermediate image instead of two. Gray input (Y plane, luma
+ *      view) skips the conversion: 6 -> 4 bytes.
+ *
+ *      Same arithmetic as OpenCV's 8-bit implementations:
+ *          gray    = (1868 B + 9617 G + 4899 R + 8192) >> 14
+ *          blur    = (sum of [1 4 6 4 1]^T [1 4 6 4 1] * gray + 128) >> 8,
+ *                    BORDER_REFLECT_101 (what OpenCV's bit-exact GaussianBlur
+ *                    computes for this kernel)
+ *          Otsu    = getThreshVal_Otsu_8u, same loop in double
+ *          binary  = blurred > threshold ? 255 : 0
+ *      so the output is bit-exact to the OpenCV chain. OpenCV builds that hand
+ *      cvtColor to a vendor HAL (e.g. Carotene on ARM) may round gray
+ *      differently by 1; Benchmark/Gray_Blur_Otsu reports the difference.
+ *
+ *      Both sweeps can be restricted to a ROI (the bottom of the frame for the
+ *      path programs): rows and columns outside it are only read as blur
+ *      neighbours, and the threshold comes from the ROI's histogram, so the
+ *      sky / background above the path does not move it.
+ *
+ *      The threshold can also be kept from frame to frame while the (sampled)
+ *      histogram does not drift (setReuse(), see OtsuReuse).
+ *
+ *      Vectorized with AVX2 / SSE2 / NEON (see Simd.hpp); the BGR conversion
+ *      needs SSSE3 (byte shuffles) on x86, plain SSE2 builds convert in C++.
+ *      Every kernel has a scalar twin with identical results.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_GRAY_BLUR_OTSU_HPP
+#define IGV_GRAY_BLUR_OTSU_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <vector>
+#include "Simd.hpp"
+#include "BitMask.hpp"
+
+#if defined(__SSSE3__)
+    #include <tmmintrin.h>
+#endif
+
+namespace igv
+{
+
+namespace gbo
+{
+    // ==================== BGR -> GRAY ====================
+    // cvtColor(COLOR_BGR2GRAY) fixed point for 8-bit images
+    constexpr int GRAY_SHIFT = 14;
+    constexpr int GRAY_B = 1868, GRAY_G = 9617, GRAY_R = 4899;
+
+    inline void grayRowScalar(const uint8_t* bgr, uint8_t* d, int n)
+    {
+        for(int x = 0; x < n; x++, bgr += 3)
+            d[x] = (uint8_t)((bgr[0] * GRAY_B + bgr[1] * GRAY_G + bgr[2] * GRAY_R + (1 << (GRAY_SHIFT - 1))) >> GRAY_SHIFT);
+    }
+
+    inline void grayRow(const uint8_t* bgr, uint8_t* d, int n)
+    {
+        int x = 0;
+#if defined(__SSSE3__)
+        // 16 pixels = 48 bytes: gather B / G / R with byte shuffles, then
+        // (B, G) . (GRAY_B, GRAY_G) + (R, 1) . (GRAY_R, 8192) with madd
+        const __m128i b0 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i b1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+        const __m128i b2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+        const __m128i g0 = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i g1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+        const __m128i g2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+        const __m128i r0 = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i r1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+        const __m128i r2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+        const __m128i cbg = _mm_setr_epi16(GRAY_B, GRAY_G, GRAY_B, GRAY_G, GRAY_B, GRAY_G, GRAY_B, GRAY_G);
+        const __m128i cr1 = _mm_setr_epi16(GRAY_R, 1 << (GRAY_SHIFT - 1), GRAY_R, 1 << (GRAY_SHIFT - 1),
+                                           GRAY_R, 1 << (GRAY_SHIFT - 1), GRAY_R, 1 << (GRAY_SHIFT - 1));
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi16(1);
+
+        // 4 pixels: words b, g, r -> 4 x int32 gray
+        auto dot4 = [&](__m128i b, __m128i g, __m128i r, bool hi)
+        {
+            __m128i bg = hi ? _mm_unpackhi_epi16(b, g) : _mm_unpacklo_epi16(b, g);
+            __m128i r_ = hi ? _mm_unpackhi_epi16(r, one) : _mm_unpacklo_epi16(r, one);
+            return _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(bg, cbg), _mm_madd_epi16(r_, cr1)), GRAY_SHIFT);
+        };
+
+        for(; x <= n - 16; x += 16)
+        {
+            const uint8_t* p = bgr + 3 * x;
+            __m128i c0 = _mm_loadu_si128((const __m128i*)p);
+            __m128i c1 = _mm_loadu_si128((const __m128i*)(p + 16));
+            __m128i c2 = _mm_loadu_si128((const __m128i*)(p + 32));
+            __m128i B = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, b0), _mm_shuffle_epi8(c1, b1)), _mm_shuffle_epi8(c2, b2));
+            __m128i G = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, g0), _mm_shuffle_epi8(c1, g1)), _mm_shuffle_epi8(c2, g2));
+            __m128i R = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, r0), _mm_shuffle_epi8(c1, r1)), _mm_shuffle_epi8(c2, r2));
+
+            __m128i bl = _mm_unpacklo_epi8(B, zero), bh = _mm_unpackhi_epi8(B, zero);
+            __m128i gl = _mm_unpacklo_epi8(G, zero), gh = _mm_unpackhi_epi8(G, zero);
+            __m128i rl = _mm_unpacklo_epi8(R, zero), rh = _mm_unpackhi_epi8(R, zero);
+
+            __m128i lo = _mm_packs_epi32(dot4(bl, gl, rl, false), dot4(bl, gl, rl, true));
+            __m128i hi = _mm_packs_epi32(dot4(bh, gh, rh, false), dot4(bh, gh, rh, true));
+            _mm_storeu_si128((__m128i*)(d + x), _mm_packus_epi16(lo, hi));
+        }
+#elif defined(IGV_SIMD_NEON)
+        for(; x <= n - 16; x += 16)
+        {
+            uint8x16x3_t p = vld3q_u8(bgr + 3 * x);
+            uint16x8_t bl = vmovl_u8(vget_low_u8(p.val[0])), bh = vmovl_u8(vget_high_u8(p.val[0]));
+            uint16x8_t gl = vmovl_u8(vget_low_u8(p.val[1])), gh = vmovl_u8(vget_high_u8(p.val[1]));
+            uint16x8_t rl = vmovl_u8(vget_low_u8(p.val[2])), rh = vmovl_u8(vget_high_u8(p.val[2]));
+            auto dot4 = [](uint16x4_t b, uint16x4_t g, uint16x4_t r)
+            {
+                uint32x4_t s = vmull_n_u16(b, GRAY_B);
+                s = vmlal_n_u16(s, g, GRAY_G);
+                s = vmlal_n_u16(s, r, GRAY_R);
+                return vrshrn_n_u32(s, GRAY_SHIFT);      // + 8192, >> 14
+            };
+            uint16x8_t lo = vcombine_u16(dot4(vget_low_u16(bl), vget_low_u16(gl), vget_low_u16(rl)),
+                                         dot4(vget_high_u16(bl), vget_high_u16(gl), vget_high_u16(rl)));
+            uint16x8_t hi = vcombine_u16(dot4(vget_low_u16(bh), vget_low_u16(gh), vget_low_u16(rh)),
+                                         dot4(vget_high_u16(bh), vget_high_u16(gh), vget_high_u16(rh)));
+            vst1q_u8(d + x, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+        }
+#endif
+        grayRowScalar(bgr + 3 * x, d + x, n - x);
+    }
+
+    // ==================== VERTICAL [1 4 6 4 1] ====================
+    // 5 gray rows -> 16-bit sums (max 16 * 255 = 4080)
+    inline void verticalRowScalar(const uint8_t* const r[5], uint16_t* v, int n, int x0 = 0)
+    {
+        for(int x = x0; x < n; x++)
+            v[x] = (uint16_t)(r[0][x] + r[4][x] + 4 * (r[1][x] + r[3][x]) + 6 * r[2][x]);
+    }
+
+    inline void verticalRow(const uint8_t* const r[5], uint16_t* v, int n)
+    {
+        int x = 0;
+#if defined(IGV_SIMD_AVX2)
+        for(; x <= n - 16; x += 16)
+        {
+            __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(r[0] + x)));
+            __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(r[1] + x)));
+            __m256i c = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(r[2] + x)));
+            __m256i e = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(r[3] + x)));
+            __m256i f = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(r[4] + x)));
+            __m256i s = _mm256_add_epi16(a, f);
+            s = _mm256_add_epi16(s, _mm256_slli_epi16(_mm256_add_epi16(b, e), 2));
+            s = _mm256_add_epi16(s, _mm256_add_epi16(_mm256_slli_epi16(c, 2), _mm256_slli_epi16(c, 1)));
+            _mm256_storeu_si256((__m256i*)(v + x), s);
+        }
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        for(; x <= n - 8; x += 8)
+        {
+            __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(r[0] + x)), zero);
+            __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(r[1] + x)), zero);
+            __m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(r[2] + x)), zero);
+            __m128i e = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(r[3] + x)), zero);
+            __m128i f = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(r[4] + x)), zero);
+            __m128i s = _mm_add_epi16(a, f);
+            s = _mm_add_epi16(s, _mm_slli_epi16(_mm_add_epi16(b, e), 2));
+            s = _mm_add_epi16(s, _mm_add_epi16(_mm_slli_epi16(c, 2), _mm_slli_epi16(c, 1)));
+            _mm_storeu_si128((__m128i*)(v + x), s);
+        }
+#elif defined(IGV_SIMD_NEON)
+        for(; x <= n - 8; x += 8)
+        {
+            uint16x8_t s = vaddl_u8(vld1_u8(r[0] + x), vld1_u8(r[4] + x));
+            s = vaddq_u16(s, vshlq_n_u16(vaddl_u8(vld1_u8(r[1] + x), vld1_u8(r[3] + x)), 2));
+            s = vmlaq_n_u16(s, vmovl_u8(vld1_u8(r[2] + x)), 6);
+            vst1q_u16(v + x, s);
+        }
+#endif
+        verticalRowScalar(r, v, n, x);
+    }
+
+    // ==================== HORIZONTAL [1 4 6 4 1] + ROUND ====================
+    // "v" has 2 valid entries on each side (border already filled).
+    // Sum max 16 * 4080 = 65280: (sum + 128) >> 8 never overflows 16 bits.
+    inline void horizontalRowScalar(const uint16_t* v, uint8_t* d, int n, int x0 = 0)
+    {
+        for(int x = x0; x < n; x++)
+        {
+            uint32_t s = v[x - 2] + v[x + 2] + 4u * (v[x - 1] + v[x + 1]) + 6u * v[x];
+            d[x] = (uint8_t)((s + 128) >> 8);
+        }
+    }
+
+    inline void horizontalRow(const uint16_t* v, uint8_t* d, int n)
+    {
+        int x = 0;
+#if defined(IGV_SIMD_AVX2)
+        const __m256i half = _mm256_set1_epi16(128);
+        auto sum16 = [&](int i)
+        {
+            __m256i s = _mm256_add_epi16(_mm256_loadu_si256((const __m256i*)(v + i - 2)),
+                                         _mm256_loadu_si256((const __m256i*)(v + i + 2)));
+            __m256i o = _mm256_add_epi16(_mm256_loadu_si256((const __m256i*)(v + i - 1)),
+                                         _mm256_loadu_si256((const __m256i*)(v + i + 1)));
+            __m256i c = _mm256_loadu_si256((const __m256i*)(v + i));
+            s = _mm256_add_epi16(s, _mm256_slli_epi16(o, 2));
+            s = _mm256_add_epi16(s, _mm256_add_epi16(_mm256_slli_epi16(c, 2), _mm256_slli_epi16(c, 1)));
+            return _mm256_srli_epi16(_mm256_add_epi16(s, half), 8);
+        };
+        for(; x <= n - 32; x += 32)
+        {
+            // packus works per 128-bit lane: restore the order afterwards
+            __m256i p = _mm256_packus_epi16(sum16(x), sum16(x + 16));
+            _mm256_storeu_si256((__m256i*)(d + x), _mm256_permute4x64_epi64(p, _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i half = _mm_set1_epi16(128);
+        auto sum8 = [&](int i)
+        {
+            __m128i s = _mm_add_epi16(_mm_loadu_si128((const __m128i*)(v + i - 2)),
+                                      _mm_loadu_si128((const __m128i*)(v + i + 2)));
+            __m128i o = _mm_add_epi16(_mm_loadu_si128((const __m128i*)(v + i - 1)),
+                                      _mm_loadu_si128((const __m128i*)(v + i + 1)));
+            __m128i c = _mm_loadu_si128((const __m128i*)(v + i));
+            s = _mm_add_epi16(s, _mm_slli_epi16(o, 2));
+            s = _mm_add_epi16(s, _mm_add_epi16(_mm_slli_epi16(c, 2), _mm_slli_epi16(c, 1)));
+            return _mm_srli_epi16(_mm_add_epi16(s, half), 8);
+        };
+        for(; x <= n - 16; x += 16)
+            _mm_storeu_si128((__m128i*)(d + x), _mm_packus_epi16(sum8(x), sum8(x + 8)));
+#elif defined(IGV_SIMD_NEON)
+        auto sum8 = [&](int i)
+        {
+            uint16x8_t s = vaddq_u16(vld1q_u16(v + i - 2), vld1q_u16(v + i + 2));
+            s = vaddq_u16(s, vshlq_n_u16(vaddq_u16(vld1q_u16(v + i - 1), vld1q_u16(v + i + 1)), 2));
+            s = vmlaq_n_u16(s, vld1q_u16(v + i), 6);
+            return vrshrn_n_u16(s, 8);                  // + 128, >> 8
+        };
+        for(; x <= n - 16; x += 16)
+            vst1q_u8(d + x, vcombine_u8(sum8(x), sum8(x + 8)));
+#endif
+        horizontalRowScalar(v, d, n, x);
+    }
+
+    // ==================== THRESHOLD ====================
+    inline void binarizeRowScalar(const uint8_t* s, uint8_t* d, int n, int thresh, int x0 = 0)
+    {
+        for(int x = x0; x < n; x++)
+            d[x] = (s[x] > thresh) ? 255 : 0;
+    }
+
+    inline void binarizeRow(const uint8_t* s, uint8_t* d, int n, int thresh)
+    {
+        int x = 0;
+        if(thresh >= 255)
+        {
+            std::memset(d, 0, n);
+            return;
+        }
+#if defined(IGV_SIMD_AVX2)
+        // s > t  <=>  max(s, t + 1) == s (unsigned)
+        const __m256i t1 = _mm256_set1_epi8((char)(thresh + 1));
+        for(; x <= n - 32; x += 32)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(s + x));
+            _mm256_storeu_si256((__m256i*)(d + x), _mm256_cmpeq_epi8(_mm256_max_epu8(a, t1), a));
+        }
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i t1 = _mm_set1_epi8((char)(thresh + 1));
+        for(; x <= n - 16; x += 16)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(s + x));
+            _mm_storeu_si128((__m128i*)(d + x), _mm_cmpeq_epi8(_mm_max_epu8(a, t1), a));
+        }
+#elif defined(IGV_SIMD_NEON)
+        const uint8x16_t t = vdupq_n_u8((uint8_t)thresh);
+        for(; x <= n - 16; x += 16)
+            vst1q_u8(d + x, vcgtq_u8(vld1q_u8(s + x), t));
+#endif
+        binarizeRowScalar(s, d, n, thresh, x);
+    }
+}
+
+// ==================== OTSU ====================
+// OpenCV's getThreshVal_Otsu_8u on a ready histogram, same operations in the
+// same order (so the same threshold, ties included)
+inline int otsuThreshold(const uint32_t hist[256], uint64_t total)
+{
+    if(total == 0) return 0;
+    const double scale = 1.0 / (double)total;
+    double mu = 0;
+    for(int i = 0; i < 256; i++)
+        mu += i * (double)hist[i];
+    mu *= scale;
+
+    double mu1 = 0, q1 = 0;
+    double maxSigma = 0;
+    int maxVal = 0;
+    for(int i = 0; i < 256; i++)
+    {
+        double p_i = hist[i] * scale;
+        mu1 *= q1;
+        q1 += p_i;
+        double q2 = 1.0 - q1;
+
+        if(std::min(q1, q2) < FLT_EPSILON || std::max(q1, q2) > 1.0 - FLT_EPSILON)
+            continue;
+
+        mu1 = (mu1 + i * p_i) / q1;
+        double mu2 = (mu - q1 * mu1) / q2;
+        double sigma = q1 * q2 * (mu1 - mu2) * (mu1 - mu2);
+        if(sigma > maxSigma)
+        {
+            maxSigma = sigma;
+            maxVal = i;
+        }
+    }
+    return maxVal;
+}
+
+// ==================== TEMPORAL THRESHOLD ====================
+// Lighting changes slowly at 60 fps: the Otsu search can keep its previous
+// result while the histogram has not moved. The histogram itself can be a
+// sample of the pixels (every "step"-th row and column).
+//
+// Drift statistic, against the histogram of the last full Otsu run:
+//      mean shift  : |mean gray - mean gray then|          (gray levels)
+//      split shift : |share of pixels above the threshold
+//                     - share above it then|               (0 .. 1)
+//      drift       = max(mean shift / maxMeanShift, split shift / maxSplitShift)
+// Full Otsu when drift > 1, every "period" frames, or on the first frame.
+// period = 0: Otsu on every frame (OpenCV behaviour, with step 1 bit-exact).
+struct OtsuReuse
+{
+    int step = 1;                   // Histogram from every step-th row / column
+    int period = 0;                 // Full Otsu at least every "period" frames
+    double maxMeanShift = 3.0;      // Gray levels
+    double maxSplitShift = 0.03;    // Share of pixels above the threshold
+
+    // Setting of the camera programs: 1/16 of the pixels in the histogram,
+    // full Otsu on drift or at least every 30 frames (0.5 s at 60 fps)
+    static OtsuReuse video() { OtsuReuse r; r.step = 4; r.period = 30; return r; }
+};
+
+// What the temporal threshold did, for tuning
+struct OtsuCounters
+{
+    uint64_t frames = 0;            // Thresholds given
+    uint64_t recomputes = 0;        // Full Otsu runs (all reasons)
+    uint64_t onDrift = 0;           // ... because the drift exceeded its bound
+    uint64_t onPeriod = 0;          // ... because "period" frames passed
+
+    // One line summary, printed by the programs on exit
+    void print(std::ostream& os) const
+    {
+        os << "OTSU recomputed on " << recomputes << " / " << frames << " frames ("
+           << onDrift << " drift, " << onPeriod << " period)" << std::endl;
+    }
+};
+
+// ==================== FUSED PIPELINE ====================
+class GrayBlurOtsu
+{
+public:
+    explicit GrayBlurOtsu(const OtsuReuse& reuse = OtsuReuse())
+    {
+        setReuse(reuse);
+    }
+
+    // Temporal threshold reuse and histogram sampling (default: off)
+    void setReuse(const OtsuReuse& reuse)
+    {
+        CV_Assert(reuse.maxMeanShift > 0 && reuse.maxSplitShift > 0);     // Drift divisors
+        reuse_ = reuse;
+        reuse_.step = std::max(1, reuse_.step);
+        resetReuse();
+    }
+    const OtsuReuse& reuse() const { return reuse_; }
+
+    // Forget the reference histogram: the next frame runs a full Otsu
+    // (scene cut, camera switch)
+    void resetReuse() { refValid_ = false; }
+
+    // Sweep 1: BGR (CV_8UC3) or gray (CV_8UC1) -> blurred gray + histogram.
+    //      roi   : part of "src" to blur, blurred() is this size (empty: all).
+    //              Pixels around it are real neighbours, only the image
+    //              edges are reflected: the result is the full-frame blur
+    //              cropped to "roi", at the cost of the ROI only.
+    //      stats : pixels the histogram / Otsu threshold come from, in "src"
+    //              coordinates, clipped to "roi" (empty: the whole roi)
+    // Returns the Otsu threshold.
+    int blur(const cv::Mat& src, cv::Rect roi = cv::Rect(), cv::Rect stats = cv::Rect())
+    {
+        return sweep(src, roi, stats, true);
+    }
+    int blurScalar(const cv::Mat& src, cv::Rect roi = cv::Rect(), cv::Rect stats = cv::Rect())
+    {
+        return sweep(src, roi, stats, false);
+    }
+
+    // Sweep 2: binary = blurred() > threshold() ? 255 : 0
+    //      part : rectangle of blurred() to threshold (empty: all)
+    void binarize(cv::Mat& binary, cv::Rect part = cv::Rect()) const { binarizeImpl(binary, part, true); }
+    void binarizeScalar(cv::Mat& binary, cv::Rect part = cv::Rect()) const { binarizeImpl(binary, part, false); }
+
+    // Sweep 2 into a bit-packed mask (1 bit per pixel, BitMask.hpp): for
+    // results that are only counted
+    void binarize(BitMask& mask, cv::Rect part = cv::Rect(), bool simd = true) const
+    {
+        const cv::Rect all(0, 0, blurred_.cols, blurred_.rows);
+        mask.packThreshold(blurred_(part.empty() ? all : (part & all)), threshold_, simd);
+    }
+
+    // Both sweeps: the cvtColor -> GaussianBlur -> threshold(OTSU) chain,
+    // on "roi" of the frame only (binary is roi sized)
+    int apply(const cv::Mat& src, cv::Mat& binary, cv::Rect roi = cv::Rect())
+    {
+        blur(src, roi);
+        binarize(binary);
+        return threshold_;
+    }
+
+    const cv::Mat& blurred() const { return blurred_; }
+    int threshold() const { return threshold_; }
+    const uint32_t* histogram() const { return hist_; }     // Sampled pixels only
+    uint64_t histogramTotal() const { return histTotal_; }
+
+    // Last frame: full Otsu run or previous threshold kept, and its drift
+    bool recomputed() const { return recomputed_; }
+    double drift() const { return drift_; }
+    const OtsuCounters& counters() const { return counters_; }
+
+private:
+    int sweep(const cv::Mat& src, cv::Rect roi, cv::Rect stats, bool simd)
+    {
+        CV_Assert(src.type() == CV_8UC1 || src.type() == CV_8UC3);
+        const int w = src.cols, h = src.rows;
+        const bool bgr = src.channels() == 3;
+
+        const cv::Rect all(0, 0, w, h);
+        roi = roi.empty() ? all : (roi & all);
+        stats = stats.empty() ? roi : (stats & roi);
+
+        // Source columns the ROI needs (2 each side, inside the image)
+        const int x0 = std::max(0, roi.x - 2);
+        const int x1 = std::min(w, roi.x + roi.width + 2);
+
+        blurred_.create(roi.size(), CV_8UC1);
+        if(bgr) ring_.create(5, w, CV_8UC1);
+        vrow_.assign(roi.width + 4, 0);
+        std::fill(ringRow_, ringRow_ + 5, -1);
+        std::memset(sub_, 0, sizeof(sub_));
+        const int step = reuse_.step;
+
+        // v[c]: vertical sum of source column c, c in [roi.x - 2, roi.x + roi.width + 2)
+        uint16_t* v = vrow_.data() + 2 - roi.x;
+        for(int y = roi.y; y < roi.y + roi.height; y++)
+        {
+            const uint8_t* r[5];
+            for(int k = 0; k < 5; k++)
+            {
+                int yy = cv::borderInterpolate(y + k - 2, h, cv::BORDER_REFLECT_101);
+                r[k] = (bgr ? grayOf(src, yy, x0, x1, simd) : src.ptr<uint8_t>(yy)) + x0;
+            }
+
+            if(simd) gbo::verticalRow(r, v + x0, x1 - x0);
+            else gbo::verticalRowScalar(r, v + x0, x1 - x0);
+
+            // BORDER_REFLECT_101 columns, where the ROI touches the image edge
+            for(int c = roi.x - 2; c < x0; c++)
+                v[c] = v[cv::borderInterpolate(c, w, cv::BORDER_REFLECT_101)];
+            for(int c = x1; c < roi.x + roi.width + 2; c++)
+                v[c] = v[cv::borderInterpolate(c, w, cv::BORDER_REFLECT_101)];
+
+            uint8_t* out = blurred_.ptr<uint8_t>(y - roi.y);
+            if(simd) gbo::horizontalRow(v + roi.x, out, roi.width);
+            else gbo::horizontalRowScalar(v + roi.x, out, roi.width);
+
+            if(y >= stats.y && y < stats.y + stats.height && (y - stats.y) % step == 0)
+            {
+                if(step == 1) count(out + stats.x - roi.x, stats.width);
+                else countSampled(out + stats.x - roi.x, stats.width, step);
+            }
+        }
+
+        histTotal_ = 0;
+        for(int i = 0; i < 256; i++)
+        {
+            hist_[i] = sub_[0][i] + sub_[1][i] + sub_[2][i] + sub_[3][i];
+            histTotal_ += hist_[i];
+        }
+        updateThreshold(stats.size());
+        return threshold_;
+    }
+
+    // Full Otsu, or the previous threshold while the histogram has not drifted
+    void updateThreshold(cv::Size stats)
+    {
+        counters_.frames++;
+        if(reuse_.period <= 0)
+        {
+            threshold_ = otsuThreshold(hist_, histTotal_);
+            recomputed_ = true;
+            drift_ = 0;
+            counters_.recomputes++;
+            return;
+        }
+
+        double mean = 0, split = 0;
+        moments(threshold_, mean, split);
+        bool period = false;
+        if(refValid_ && refSize_ == stats)
+        {
+            drift_ = std::max(std::abs(mean - refMean_) / reuse_.maxMeanShift,
+                              std::abs(split - refSplit_) / reuse_.maxSplitShift);
+            period = ++sinceRecompute_ >= reuse_.period;
+            if(drift_ <= 1.0 && !period)
+            {
+                recomputed_ = false;
+                return;
+            }
+        }
+        else
+        {
+            drift_ = 0;
+        }
+
+        if(period && drift_ <= 1.0) counters_.onPeriod++;
+        else if(refValid_ && refSize_ == stats) counters_.onDrift++;
+        counters_.recomputes++;
+
+        threshold_ = otsuThreshold(hist_, histTotal_);
+        moments(threshold_, refMean_, refSplit_);
+        refSize_ = stats;
+        refValid_ = true;
+        sinceRecompute_ = 0;
+        recomputed_ = true;
+    }
+
+    // Mean gray and share of pixels above "thresh" of the histogram
+    void moments(int thresh, double& mean, double& split) const
+    {
+        uint64_t sum = 0, above = 0;
+        for(int i = 0; i < 256; i++)
+        {
+            sum += (uint64_t)i * hist_[i];
+            if(i > thresh) above += hist_[i];
+        }
+        mean = histTotal_ ? (double)sum / histTotal_ : 0;
+        split = histTotal_ ? (double)above / histTotal_ : 0;
+    }
+
+    // 4 sub-histograms: neighbours with equal values do not wait on each
+    // other's increment
+    void count(const uint8_t* p, int n)
+    {
+        int x = 0;
+        for(; x <= n - 4; x += 4)
+        {
+            sub_[0][p[x]]++;
+            sub_[1][p[x + 1]]++;
+            sub_[2][p[x + 2]]++;
+            sub_[3][p[x + 3]]++;
+        }
+        for(; x < n; x++) sub_[0][p[x]]++;
+    }
+
+    void countSampled(const uint8_t* p, int n, int step)
+    {
+        int x = 0, k = 0;
+        for(; x < n; x += step, k = (k + 1) & 3)
+            sub_[k][p[x]]++;
+    }
+
+    // Gray version of source row "yy" (columns x0 .. x1), converted once
+    // into the 5-row ring
+    const uint8_t* grayOf(const cv::Mat& src, int yy, int x0, int x1, bool simd)
+    {
+        int slot = yy % 5;
+        uint8_t* row = ring_.ptr<uint8_t>(slot);
+        if(ringRow_[slot] != yy)
+        {
+            const uint8_t* s = src.ptr<uint8_t>(yy) + 3 * x0;
+            if(simd) gbo::grayRow(s, row + x0, x1 - x0);
+            else gbo::grayRowScalar(s, row + x0, x1 - x0);
+            ringRow_[slot] = yy;
+        }
+        return row;
+    }
+
+    void binarizeImpl(cv::Mat& binary, cv::Rect part, bool simd) const
+    {
+        const cv::Rect all(0, 0, blurred_.cols, blurred_.rows);
+        part = part.empty() ? all : (part & all);
+        binary.create(part.size(), CV_8UC1);
+        for(int y = 0; y < part.height; y++)
+        {
+            const uint8_t* s = blurred_.ptr<uint8_t>(part.y + y) + part.x;
+            if(simd) gbo::binarizeRow(s, binary.ptr<uint8_t>(y), part.width, threshold_);
+            else gbo::binarizeRowScalar(s, binary.ptr<uint8_t>(y), part.width, threshold_);
+        }
+    }
+
+    cv::Mat blurred_;
+    cv::Mat ring_;                      // 5 gray rows (BGR input)
+    int ringRow_[5] = { -1, -1, -1, -1, -1 };
+    std::vector<uint16_t> vrow_;        // Vertical sums + 2 border columns each side
+    uint32_t sub_[4][256] = {};
+    uint32_t hist_[256] = {};
+    uint64_t histTotal_ = 0;
+    int threshold_ = 0;
+
+    OtsuReuse reuse_;
+    OtsuCounters counters_;
+    bool refValid_ = false;             // Reference histogram moments below
+    cv::Size refSize_;
+    double refMean_ = 0, refSplit_ = 0;
+    int sinceRecompute_ = 0;
+    bool recomputed_ = false;
+    double drift_ = 0;
+};
+
+} // namespace igv
+
+#endif // IGV_GRAY_BLUR_OTSU_HPP
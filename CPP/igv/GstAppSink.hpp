@@ -0,0 +1,369 @@
+/*****************************************************************************************
+ *  File Name   : GstAppSink.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV, GStreamer (gstreamer-app-1.0, gstreamer-video-1.0)
+ *
+ *  Description :
+ *      Native appsink reader that hands out frames WITHOUT copying them.
+ *
+ *      cv::VideoCapture(CAP_GSTREAMER) copies every appsink buffer into a new
+ *      cv::Mat. At 1920x1080 BGR @ 60 FPS that is ~370 MB/s of memcpy before
+ *      any processing starts. This reader instead:
+ *          - pulls the GstSample from the appsink
+ *          - maps its GstBuffer (read access)
+ *          - wraps the mapped memory in a cv::Mat header
+ *
+ *      Buffer lifetime:
+ *          The Mat carries a reference count (BorrowedMat.hpp) like any
+ *          normal Mat. Copies of the header (frame2 = frame, ROIs, the
+ *          capture ring slots) share it. When the LAST header is gone the
+ *          buffer is unmapped and the sample is unreferenced, so it goes
+ *          back to the upstream buffer pool.
+ *
+ *      Rules for the consumer:
+ *          - The pixels are READ-ONLY (mapped with GST_MAP_READ). Draw on a
+ *            copy (igv::toBgr() gives one for display).
+ *          - Every held frame keeps one upstream buffer busy. Sources with a
+ *            small pool (v4l2src, nvvidconv) stall if the application holds
+ *            all of them: keep the number of held frames below the pool size.
+ *          - Frames may outlive the reader; the buffer keeps its pool alive.
+ *
+ *      Formats wrapped without copying: BGR, GRAY8, NV12, I420 (see
+ *      PixelFormat.hpp). Buffers whose planes are padded apart are copied
+ *      once into a packed Mat (counted in framesCopied()).
+ *
+ *      Test without a camera:
+ *          videotestsrc ! video/x-raw,format=BGR,width=1920,height=1080 ! appsink
+ *          filesrc location=drive.mp4 ! decodebin ! videoconvert ! video/x-raw,format=NV12 ! appsink
+ *
+ *  Build       : -DIGV_WITH_GSTREAMER `pkg-config --cflags --libs gstreamer-app-1.0 gstreamer-video-1.0`
+ *                (build.sh adds this automatically when the packages are installed)
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x, GStreamer
+*****************************************************************************************/
+
+#ifndef IGV_GST_APP_SINK_HPP
+#define IGV_GST_APP_SINK_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/video/video.h>
+#include "BorrowedMat.hpp"
+#include "PixelFormat.hpp"
+
+namespace igv
+{
+
+namespace detail
+{
+    // Packs "rows" rows of "rowBytes" bytes into contiguous memory
+    inline uchar* copyPlane(const uchar* src, int srcStride, uchar* dst, int rowBytes, int rows)
+    {
+        for(int y = 0; y < rows; y++)
+        {
+            std::memcpy(dst, src + (size_t)y * srcStride, rowBytes);
+            dst += rowBytes;
+        }
+        return dst;
+    }
+}
+
+// ==================== APPSINK READER ====================
+class GstAppSinkReader
+{
+public:
+    // "pipeline" must contain exactly one appsink (any name)
+    explicit GstAppSinkReader(const std::string& pipeline)
+    {
+        open(pipeline);
+    }
+
+    ~GstAppSinkReader()
+    {
+        close();
+    }
+
+    GstAppSinkReader(const GstAppSinkReader&) = delete;
+    GstAppSinkReader& operator=(const GstAppSinkReader&) = delete;
+
+    bool isOpened() const { return sink_ != nullptr; }
+    cv::Size frameSize() const { return size_; }
+    double fps() const { return fps_; }
+    PixelFormat format() const { return format_; }
+
+    // Pipelines with a live source (camera, videotestsrc is-live=true) do not
+    // preroll; file / test pipelines do and can be read without losing frames
+    bool isLive() const { return live_; }
+
+    // Presentation timestamp of the last frame in ns (-1 if unknown)
+    int64_t lastPts() const { return lastPts_; }
+
+    uint64_t framesWrapped() const { return wrapped_; }
+    uint64_t framesCopied() const { return copied_; }
+
+    // Next frame as a header over the GstBuffer. Blocks until a frame arrives.
+    // Returns false at end of stream, or after "timeoutSec" without a frame.
+    bool read(cv::Mat& frame, double timeoutSec = 2.0)
+    {
+        if(!sink_) return false;
+
+        GstSample* sample = pending_;
+        pending_ = nullptr;
+        if(!sample)
+        {
+            sample = gst_app_sink_try_pull_sample(GST_APP_SINK(sink_),
+                                                  (GstClockTime)(timeoutSec * GST_SECOND));
+        }
+        if(!sample)
+        {
+            if(!gst_app_sink_is_eos(GST_APP_SINK(sink_)))
+            {
+                std::cerr << "IGV::ERROR::appsink: no frame for " << timeoutSec << " s" << std::endl;
+            }
+            return false;
+        }
+        return wrap(sample, frame);
+    }
+
+private:
+    // ==================== PIPELINE SETUP ====================
+    void open(const std::string& description)
+    {
+        if(!gst_is_initialized()) gst_init(nullptr, nullptr);
+
+        GError* err = nullptr;
+        pipeline_ = gst_parse_launch(description.c_str(), &err);
+        if(err)
+        {
+            std::cerr << "IGV::ERROR::GStreamer pipeline: " << err->message << std::endl;
+            g_error_free(err);
+            close();
+            return;
+        }
+
+        sink_ = findAppSink(pipeline_);
+        if(!sink_)
+        {
+            std::cerr << "IGV::ERROR::GStreamer pipeline has no appsink" << std::endl;
+            close();
+            return;
+        }
+
+        if(gst_element_set_state(pipeline_, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE)
+        {
+            std::cerr << "IGV::ERROR::GStreamer pipeline failed to start" << std::endl;
+            close();
+            return;
+        }
+        GstStateChangeReturn ret = gst_element_get_state(pipeline_, nullptr, nullptr, 5 * GST_SECOND);
+        live_ = (ret == GST_STATE_CHANGE_NO_PREROLL);
+
+        // The first sample tells the negotiated format / size; it is kept and
+        // returned by the first read()
+        pending_ = gst_app_sink_try_pull_sample(GST_APP_SINK(sink_), 5 * GST_SECOND);
+        if(!pending_ || !parseCaps(gst_sample_get_caps(pending_)))
+        {
+            if(!pending_) std::cerr << "IGV::ERROR::GStreamer pipeline delivered no frame" << std::endl;
+            close();
+        }
+    }
+
+    void close()
+    {
+        if(pending_)
+        {
+            gst_sample_unref(pending_);
+            pending_ = nullptr;
+        }
+        if(pipeline_)
+        {
+            gst_element_set_state(pipeline_, GST_STATE_NULL);
+        }
+        if(sink_)
+        {
+            gst_object_unref(sink_);
+            sink_ = nullptr;
+        }
+        if(pipeline_)
+        {
+            gst_object_unref(pipeline_);
+            pipeline_ = nullptr;
+        }
+    }
+
+    static GstElement* findAppSink(GstElement* pipeline)
+    {
+        if(GST_IS_APP_SINK(pipeline)) return GST_ELEMENT(gst_object_ref(pipeline));
+        if(!GST_IS_BIN(pipeline)) return nullptr;
+
+        GstElement* found = nullptr;
+        GstIterator* it = gst_bin_iterate_sinks(GST_BIN(pipeline));
+        GValue item = G_VALUE_INIT;
+        bool done = false;
+        while(!done)
+        {
+            switch(gst_iterator_next(it, &item))
+            {
+            case GST_ITERATOR_OK:
+            {
+                GstElement* e = GST_ELEMENT(g_value_get_object(&item));
+                if(GST_IS_APP_SINK(e))
+                {
+                    found = GST_ELEMENT(gst_object_ref(e));
+                    done = true;
+                }
+                g_value_reset(&item);
+                break;
+            }
+            case GST_ITERATOR_RESYNC:
+                gst_iterator_resync(it);
+                break;
+            default:
+                done = true;
+                break;
+            }
+        }
+        g_value_unset(&item);
+        gst_iterator_free(it);
+        return found;
+    }
+
+    bool parseCaps(GstCaps* caps)
+    {
+        if(!caps || !gst_video_info_from_caps(&info_, caps))
+        {
+            std::cerr << "IGV::ERROR::appsink caps are not raw video" << std::endl;
+            return false;
+        }
+
+        switch(GST_VIDEO_INFO_FORMAT(&info_))
+        {
+        case GST_VIDEO_FORMAT_BGR:   format_ = PixelFormat::BGR;  break;
+        case GST_VIDEO_FORMAT_GRAY8: format_ = PixelFormat::GRAY; break;
+        case GST_VIDEO_FORMAT_NV12:  format_ = PixelFormat::NV12; break;
+        case GST_VIDEO_FORMAT_I420:  format_ = PixelFormat::I420; break;
+        default:
+            std::cerr << "IGV::ERROR::appsink format "
+                      << gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(&info_))
+                      << " not supported (use BGR, GRAY8, NV12 or I420)" << std::endl;
+            return false;
+        }
+
+        size_ = cv::Size(GST_VIDEO_INFO_WIDTH(&info_), GST_VIDEO_INFO_HEIGHT(&info_));
+        fps_ = (GST_VIDEO_INFO_FPS_D(&info_) > 0)
+             ? (double)GST_VIDEO_INFO_FPS_N(&info_) / GST_VIDEO_INFO_FPS_D(&info_) : 0.0;
+        return true;
+    }
+
+    // ==================== BUFFER -> cv::Mat ====================
+    bool wrap(GstSample* sample, cv::Mat& frame)
+    {
+        GstBuffer* buffer = gst_sample_get_buffer(sample);
+        GstMapInfo* map = new GstMapInfo();
+        if(!buffer || !gst_buffer_map(buffer, map, GST_MAP_READ))
+        {
+            std::cerr << "IGV::ERROR::appsink buffer cannot be mapped" << std::endl;
+            gst_sample_unref(sample);
+            delete map;
+            return false;
+        }
+        lastPts_ = GST_CLOCK_TIME_IS_VALID(GST_BUFFER_PTS(buffer))
+                 ? (int64_t)GST_BUFFER_PTS(buffer) : -1;
+
+        // Gives the buffer back to GStreamer
+        auto unmap = [sample, buffer, map]()
+        {
+            gst_buffer_unmap(buffer, map);
+            gst_sample_unref(sample);
+            delete map;
+        };
+
+        // Plane layout: video meta (pools with padding) or the caps defaults
+        gsize offset[3];
+        gint stride[3];
+        GstVideoMeta* meta = gst_buffer_get_video_meta(buffer);
+        for(int p = 0; p < 3; p++)
+        {
+            offset[p] = meta ? meta->offset[p] : GST_VIDEO_INFO_PLANE_OFFSET(&info_, p);
+            stride[p] = meta ? meta->stride[p] : GST_VIDEO_INFO_PLANE_STRIDE(&info_, p);
+        }
+
+        const int w = size_.width;
+        const int h = size_.height;
+        uchar* base = map->data;
+        bool packed;
+        switch(format_)
+        {
+        case PixelFormat::NV12:
+            // Y and UV planes back to back with the same stride
+            packed = (offset[1] == offset[0] + (gsize)stride[0] * h) && stride[1] == stride[0];
+            break;
+        case PixelFormat::I420:
+            // OpenCV's I420 layout has no row padding at all
+            packed = stride[0] == w && stride[1] == w / 2 && stride[2] == w / 2
+                  && offset[1] == offset[0] + (gsize)w * h
+                  && offset[2] == offset[1] + (gsize)(w / 2) * (h / 2);
+            break;
+        default:
+            packed = true;
+            break;
+        }
+
+        const cv::Size bufSize = bufferSize(format_, size_);
+        if(!packed)
+        {
+            // Rare: copy the planes into a normal Mat and give the buffer back now.
+            // release() first: "frame" may still be a borrowed (read-only)
+            // buffer of the same size and type, which create() would keep
+            frame.release();
+            frame.create(bufSize, bufferType(format_));
+            uchar* dst = detail::copyPlane(base + offset[0], stride[0], frame.data, w, h);
+            if(format_ == PixelFormat::NV12)
+            {
+                detail::copyPlane(base + offset[1], stride[1], dst, w, h / 2);
+            }
+            else
+            {
+                dst = detail::copyPlane(base + offset[1], stride[1], dst, w / 2, h / 2);
+                detail::copyPlane(base + offset[2], stride[2], dst, w / 2, h / 2);
+            }
+            unmap();
+            copied_++;
+            return true;
+        }
+
+        // Header over the mapped memory, unmapped when the last copy is gone.
+        // Assigning drops the previous buffer held by "frame".
+        frame = borrowMat(bufSize, bufferType(format_), base + offset[0], (size_t)stride[0], unmap);
+        wrapped_++;
+        return true;
+    }
+
+    GstElement* pipeline_ = nullptr;
+    GstElement* sink_ = nullptr;
+    GstSample* pending_ = nullptr;
+    GstVideoInfo info_;
+
+    cv::Size size_;
+    double fps_ = 0;
+    PixelFormat format_ = PixelFormat::BGR;
+    bool live_ = true;
+    int64_t lastPts_ = -1;
+
+    uint64_t wrapped_ = 0;
+    uint64_t copied_ = 0;
+};
+
+} // namespace igv
+
+#endif // IGV_GST_APP_SINK_HPP
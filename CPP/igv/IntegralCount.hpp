@@ -0,0 +1,187 @@
+/*****************************************************************************************
+ *  File Name   : IntegralCount.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat / cv::Rect only)
+ *
+ *  Description :
+ *      Summed-area table of a binary ROI: built once per frame, then the
+ *      set pixels of ANY rectangle (zones, occupancy cells, probes) are 4
+ *      reads, whatever its size.
+ *
+ *          S(x, y) = set pixels in [0, x) x [0, y)
+ *          count(x, y, w, h) = S(x+w, y+h) - S(x, y+h) - S(x+w, y) + S(x, y)
+ *
+ *      Built from an igv::BitMask (8 pixels per table lookup) or a 0 / non-0
+ *      CV_8UC1 Mat. int32 entries: enough for 2^31 pixels.
+ *
+ *      Grid is the occupancy grid of 15 / 16 as a runtime value ("27x48" on
+ *      the command line) with the cells the programs always used: ROI / grid
+ *      rounded down, right and bottom remainders not covered.
+ *
+ *          one table per frame : 1 pass over the ROI (1 bit per pixel read)
+ *          every cell          : O(1), so the grid size costs nothing
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_INTEGRAL_COUNT_HPP
+#define IGV_INTEGRAL_COUNT_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "BitMask.hpp"
+
+namespace igv
+{
+
+// ==================== GRID ====================
+struct Grid
+{
+    int rows = 0;
+    int cols = 0;
+
+    bool valid() const { return rows > 0 && cols > 0; }
+    int cells() const { return rows * cols; }
+
+    // Cell (r, c) of an area of "size" pixels
+    cv::Rect cell(cv::Size size, int r, int c) const
+    {
+        int cw = size.width / cols, ch = size.height / rows;
+        return cv::Rect(c * cw, r * ch, cw, ch);
+    }
+};
+
+// "27x48" -> 27 rows, 48 columns
+inline bool parseGrid(const std::string& text, Grid& grid)
+{
+    Grid g;
+    char x = 0;
+    if(std::sscanf(text.c_str(), "%d%c%d", &g.rows, &x, &g.cols) != 3 || (x != 'x' && x != 'X') || !g.valid())
+        return false;
+    grid = g;
+    return true;
+}
+
+// ==================== SUMMED-AREA TABLE ====================
+class IntegralCount
+{
+public:
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    cv::Size size() const { return cv::Size(cols_, rows_); }
+    bool empty() const { return rows_ == 0 || cols_ == 0; }
+
+    // From a packed mask: one byte of bits at a time
+    void build(const BitMask& mask)
+    {
+        create(mask.rows(), mask.cols());
+        const Prefix8& pre = prefix8();
+        for(int y = 0; y < rows_; y++)
+        {
+            const uint8_t* b = reinterpret_cast<const uint8_t*>(mask.row(y));   // LSB-first words = bytes in x order (little endian)
+            const int32_t* above = table_.data() + (size_t)y * stride_ + 1;
+            int32_t* cur = table_.data() + (size_t)(y + 1) * stride_ + 1;
+            int32_t run = 0;
+            int x = 0;
+            for(; x + 8 <= cols_; x += 8)
+            {
+                const uint8_t* p = pre.sums[b[x >> 3]];
+                for(int i = 0; i < 8; i++) cur[x + i] = above[x + i] + run + p[i];
+                run += p[7];
+            }
+            for(; x < cols_; x++)
+            {
+                run += (b[x >> 3] >> (x & 7)) & 1;
+                cur[x] = above[x] + run;
+            }
+        }
+    }
+
+    // From a 0 / non-0 CV_8UC1 image
+    void build(const cv::Mat& binary)
+    {
+        CV_Assert(binary.type() == CV_8UC1);
+        create(binary.rows, binary.cols);
+        for(int y = 0; y < rows_; y++)
+        {
+            const uint8_t* s = binary.ptr<uint8_t>(y);
+            const int32_t* above = table_.data() + (size_t)y * stride_ + 1;
+            int32_t* cur = table_.data() + (size_t)(y + 1) * stride_ + 1;
+            int32_t run = 0;
+            for(int x = 0; x < cols_; x++)
+            {
+                run += s[x] != 0;
+                cur[x] = above[x] + run;
+            }
+        }
+    }
+
+    // Set pixels inside "r" (clipped), 4 reads
+    int count(cv::Rect r) const
+    {
+        r = r & cv::Rect(0, 0, cols_, rows_);
+        if(r.empty()) return 0;
+        const int32_t* top = table_.data() + (size_t)r.y * stride_;
+        const int32_t* bottom = table_.data() + (size_t)(r.y + r.height) * stride_;
+        return bottom[r.x + r.width] - bottom[r.x] - top[r.x + r.width] + top[r.x];
+    }
+
+    int countAll() const { return empty() ? 0 : table_[(size_t)rows_ * stride_ + cols_]; }
+
+    // Set pixels of every cell, row-major (counts[r * grid.cols + c])
+    void countCells(const Grid& grid, std::vector<int>& counts) const
+    {
+        counts.assign(grid.cells(), 0);
+        if(!grid.valid()) return;
+        for(int r = 0; r < grid.rows; r++)
+            for(int c = 0; c < grid.cols; c++)
+                counts[r * grid.cols + c] = count(grid.cell(size(), r, c));
+    }
+
+private:
+    // sums[b][i] = set bits 0..i of b
+    struct Prefix8
+    {
+        uint8_t sums[256][8];
+        Prefix8()
+        {
+            for(int b = 0; b < 256; b++)
+            {
+                int s = 0;
+                for(int i = 0; i < 8; i++) sums[b][i] = (uint8_t)(s += (b >> i) & 1);
+            }
+        }
+    };
+
+    static const Prefix8& prefix8()
+    {
+        static const Prefix8 table;
+        return table;
+    }
+
+    void create(int rows, int cols)
+    {
+        rows_ = rows;
+        cols_ = cols;
+        stride_ = cols + 1;
+        table_.resize((size_t)(rows + 1) * stride_);
+        std::fill(table_.begin(), table_.begin() + stride_, 0);            // Row 0
+        for(int y = 1; y <= rows; y++) table_[(size_t)y * stride_] = 0;     // Column 0
+    }
+
+    int rows_ = 0, cols_ = 0, stride_ = 0;
+    std::vector<int32_t> table_;
+};
+
+} // namespace igv
+
+#endif // IGV_INTEGRAL_COUNT_HPP
@@ -0,0 +1,316 @@
+/*****************************************************************************************
+ *  File Name   : MonoConvert.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat only)
+ *
+ *  Description :
+ *      16-bit mono sensor frame (Y10 / Y12 / Y16, see PixelFormat.hpp) to the
+ *      8-bit gray image the thresholding pipeline works on, in one pass.
+ *
+ *      Modes:
+ *          SHIFT   : out = min(in >> shift, 255)          (default shift = bits - 8)
+ *          STRETCH : out = 255 * (in - lo) / (hi - lo)    (clamped; lo/hi fixed or
+ *                                                          per-frame min / max)
+ *          GAMMA   : out = 255 * ((in - lo) / (hi - lo)) ^ (1 / gamma), via a
+ *                    2^bits entry lookup table
+ *
+ *      Optional ROI: only the rectangle is read and converted (the output has
+ *      the ROI size), so the rows thrown away by the path programs are never
+ *      touched.
+ *
+ *      SHIFT and STRETCH are vectorized (AVX2 / SSE2 / NEON, see Simd.hpp),
+ *      GAMMA is an unrolled table lookup (no byte gather on these CPUs).
+ *      STRETCH uses 16-bit fixed point; the scalar reference uses the same
+ *      arithmetic, so every instruction set gives bit-identical output.
+ *      Against exact rounding of 255 * (in - lo) / (hi - lo) it is within 1.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_MONO_CONVERT_HPP
+#define IGV_MONO_CONVERT_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Simd.hpp"
+
+namespace igv
+{
+
+namespace mono
+{
+    // ==================== SHIFT ====================
+    inline void shiftRowScalar(const uint16_t* s, uint8_t* d, int n, int shift)
+    {
+        for(int x = 0; x < n; x++)
+        {
+            int v = s[x] >> shift;
+            d[x] = (uint8_t)(v > 255 ? 255 : v);
+        }
+    }
+
+    inline void shiftRow(const uint16_t* s, uint8_t* d, int n, int shift)
+    {
+        int x = 0;
+#if defined(IGV_SIMD_AVX2)
+        const __m128i cnt = _mm_cvtsi32_si128(shift);
+        const __m256i v255 = _mm256_set1_epi16(255);
+        for(; x <= n - 32; x += 32)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(s + x));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(s + x + 16));
+            a = _mm256_min_epu16(_mm256_srl_epi16(a, cnt), v255);
+            b = _mm256_min_epu16(_mm256_srl_epi16(b, cnt), v255);
+            // packus works per 128-bit lane: restore the order afterwards
+            __m256i p = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)(d + x), p);
+        }
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i cnt = _mm_cvtsi32_si128(shift);
+        const __m128i v255 = _mm_set1_epi16(255);
+        for(; x <= n - 16; x += 16)
+        {
+            __m128i a = _mm_srl_epi16(_mm_loadu_si128((const __m128i*)(s + x)), cnt);
+            __m128i b = _mm_srl_epi16(_mm_loadu_si128((const __m128i*)(s + x + 8)), cnt);
+            // min(v, 255) without SSE4.1: v - max(v - 255, 0)
+            a = _mm_sub_epi16(a, _mm_subs_epu16(a, v255));
+            b = _mm_sub_epi16(b, _mm_subs_epu16(b, v255));
+            _mm_storeu_si128((__m128i*)(d + x), _mm_packus_epi16(a, b));
+        }
+#elif defined(IGV_SIMD_NEON)
+        const int16x8_t sh = vdupq_n_s16((int16_t)-shift);
+        for(; x <= n - 16; x += 16)
+        {
+            uint16x8_t a = vshlq_u16(vld1q_u16(s + x), sh);
+            uint16x8_t b = vshlq_u16(vld1q_u16(s + x + 8), sh);
+            // vqmovn saturates to 255 on its own
+            vst1q_u8(d + x, vcombine_u8(vqmovn_u16(a), vqmovn_u16(b)));
+        }
+#endif
+        shiftRowScalar(s + x, d + x, n - x, shift);
+    }
+
+    // ==================== STRETCH ====================
+    // Fixed point: v = min(sat(in - lo), range) << k, out = (v * mul) >> 16
+    // k makes (range << k) >= 256 so "mul" fits in 16 bits;
+    // mul = ceil(255 * 65536 / (range << k)) maps in == hi exactly to 255.
+    struct StretchParams
+    {
+        uint16_t lo;
+        uint16_t range;
+        int k;
+        uint16_t mul;
+
+        StretchParams(int lo_, int hi_)
+        {
+            lo_ = std::max(0, std::min(lo_, 65534));
+            hi_ = std::max(lo_ + 1, std::min(hi_, 65535));
+            lo = (uint16_t)lo_;
+            range = (uint16_t)(hi_ - lo_);
+            k = 0;
+            while(((uint32_t)range << k) < 256) k++;
+            uint32_t r = (uint32_t)range << k;
+            mul = (uint16_t)((255u * 65536u + r - 1) / r);
+        }
+    };
+
+    inline void stretchRowScalar(const uint16_t* s, uint8_t* d, int n, const StretchParams& p)
+    {
+        for(int x = 0; x < n; x++)
+        {
+            uint32_t v = (s[x] > p.lo) ? (uint32_t)(s[x] - p.lo) : 0u;
+            v = std::min<uint32_t>(v, p.range) << p.k;
+            d[x] = (uint8_t)((v * p.mul) >> 16);
+        }
+    }
+
+    inline void stretchRow(const uint16_t* s, uint8_t* d, int n, const StretchParams& p)
+    {
+        int x = 0;
+#if defined(IGV_SIMD_AVX2)
+        const __m256i vlo = _mm256_set1_epi16((short)p.lo);
+        const __m256i vrange = _mm256_set1_epi16((short)p.range);
+        const __m256i vmul = _mm256_set1_epi16((short)p.mul);
+        const __m128i kcnt = _mm_cvtsi32_si128(p.k);
+        for(; x <= n - 32; x += 32)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(s + x));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(s + x + 16));
+            a = _mm256_min_epu16(_mm256_subs_epu16(a, vlo), vrange);
+            b = _mm256_min_epu16(_mm256_subs_epu16(b, vlo), vrange);
+            a = _mm256_mulhi_epu16(_mm256_sll_epi16(a, kcnt), vmul);
+            b = _mm256_mulhi_epu16(_mm256_sll_epi16(b, kcnt), vmul);
+            __m256i q = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)(d + x), q);
+        }
+#elif defined(IGV_SIMD_SSE2)
+        const __m128i vlo = _mm_set1_epi16((short)p.lo);
+        const __m128i vrange = _mm_set1_epi16((short)p.range);
+        const __m128i vmul = _mm_set1_epi16((short)p.mul);
+        const __m128i kcnt = _mm_cvtsi32_si128(p.k);
+        for(; x <= n - 16; x += 16)
+        {
+            __m128i a = _mm_subs_epu16(_mm_loadu_si128((const __m128i*)(s + x)), vlo);
+            __m128i b = _mm_subs_epu16(_mm_loadu_si128((const __m128i*)(s + x + 8)), vlo);
+            a = _mm_sub_epi16(a, _mm_subs_epu16(a, vrange));
+            b = _mm_sub_epi16(b, _mm_subs_epu16(b, vrange));
+            a = _mm_mulhi_epu16(_mm_sll_epi16(a, kcnt), vmul);
+            b = _mm_mulhi_epu16(_mm_sll_epi16(b, kcnt), vmul);
+            _mm_storeu_si128((__m128i*)(d + x), _mm_packus_epi16(a, b));
+        }
+#elif defined(IGV_SIMD_NEON)
+        const uint16x8_t vlo = vdupq_n_u16(p.lo);
+        const uint16x8_t vrange = vdupq_n_u16(p.range);
+        const uint16x4_t vmul = vdup_n_u16(p.mul);
+        const int16x8_t kcnt = vdupq_n_s16((int16_t)p.k);
+        for(; x <= n - 16; x += 16)
+        {
+            uint16x8_t v[2] = { vld1q_u16(s + x), vld1q_u16(s + x + 8) };
+            uint8x8_t out[2];
+            for(int i = 0; i < 2; i++)
+            {
+                uint16x8_t a = vshlq_u16(vminq_u16(vqsubq_u16(v[i], vlo), vrange), kcnt);
+                uint32x4_t lo = vmull_u16(vget_low_u16(a), vmul);
+                uint32x4_t hi = vmull_u16(vget_high_u16(a), vmul);
+                out[i] = vqmovn_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+            }
+            vst1q_u8(d + x, vcombine_u8(out[0], out[1]));
+        }
+#endif
+        stretchRowScalar(s + x, d + x, n - x, p);
+    }
+
+    // ==================== LOOKUP TABLE ====================
+    inline void lutRow(const uint16_t* s, uint8_t* d, int n, const uint8_t* lut, uint16_t maxIndex)
+    {
+        int x = 0;
+        for(; x <= n - 4; x += 4)
+        {
+            d[x + 0] = lut[std::min(s[x + 0], maxIndex)];
+            d[x + 1] = lut[std::min(s[x + 1], maxIndex)];
+            d[x + 2] = lut[std::min(s[x + 2], maxIndex)];
+            d[x + 3] = lut[std::min(s[x + 3], maxIndex)];
+        }
+        for(; x < n; x++) d[x] = lut[std::min(s[x], maxIndex)];
+    }
+}
+
+// ==================== CONVERTER ====================
+class MonoTo8
+{
+public:
+    enum class Mode { SHIFT, STRETCH, GAMMA };
+
+    // bits: significant bits of the input (10 for Y10, 12 for Y12, 16 for Y16)
+    explicit MonoTo8(int bits = 10)
+        : bits_(std::max(8, std::min(bits, 16)))
+    {
+        setShift();
+    }
+
+    // out = min(in >> shift, 255); shift < 0: bits - 8 (full range to 8 bit)
+    void setShift(int shift = -1)
+    {
+        mode_ = Mode::SHIFT;
+        shift_ = (shift < 0) ? bits_ - 8 : std::min(shift, 15);
+    }
+
+    // Linear stretch of [lo, hi] to [0, 255].
+    // hi <= lo: lo / hi are the min / max of every frame (auto exposure-like)
+    void setStretch(int lo = 0, int hi = 0)
+    {
+        mode_ = Mode::STRETCH;
+        lo_ = lo;
+        hi_ = hi;
+    }
+
+    // Gamma curve over [lo, hi] (hi < 0: full input range), via lookup table.
+    // gamma > 1 brightens the dark part (shadows under the robot).
+    void setGamma(double gamma, int lo = 0, int hi = -1)
+    {
+        mode_ = Mode::GAMMA;
+        const int size = 1 << bits_;
+        if(hi < 0) hi = size - 1;
+        hi = std::max(hi, lo + 1);
+
+        lut_.resize(size);
+        for(int v = 0; v < size; v++)
+        {
+            double t = (double)(std::min(std::max(v, lo), hi) - lo) / (hi - lo);
+            lut_[v] = (uint8_t)std::lround(255.0 * std::pow(t, 1.0 / gamma));
+        }
+    }
+
+    Mode mode() const { return mode_; }
+    int bits() const { return bits_; }
+
+    // src: CV_16UC1. dst: CV_8UC1 of roi size (whole frame when roi is empty)
+    void convert(const cv::Mat& src, cv::Mat& dst, cv::Rect roi = cv::Rect()) const
+    {
+        run(src, dst, roi, true);
+    }
+
+    // Same result with the plain C++ rows (reference for the benchmarks)
+    void convertScalar(const cv::Mat& src, cv::Mat& dst, cv::Rect roi = cv::Rect()) const
+    {
+        run(src, dst, roi, false);
+    }
+
+private:
+    void run(const cv::Mat& src, cv::Mat& dst, cv::Rect roi, bool simd) const
+    {
+        CV_Assert(src.type() == CV_16UC1);
+        cv::Rect full(0, 0, src.cols, src.rows);
+        roi = roi.empty() ? full : (roi & full);
+        const cv::Mat in = src(roi);
+        dst.create(roi.height, roi.width, CV_8UC1);
+
+        mono::StretchParams sp(lo_, hi_);
+        if(mode_ == Mode::STRETCH && hi_ <= lo_)
+        {
+            double mn = 0, mx = 0;
+            cv::minMaxLoc(in, &mn, &mx);
+            sp = mono::StretchParams((int)mn, (int)mx);
+        }
+        const uint16_t maxIndex = (uint16_t)((1 << bits_) - 1);
+
+        for(int y = 0; y < in.rows; y++)
+        {
+            const uint16_t* s = in.ptr<uint16_t>(y);
+            uint8_t* d = dst.ptr<uint8_t>(y);
+            switch(mode_)
+            {
+            case Mode::SHIFT:
+                if(simd) mono::shiftRow(s, d, in.cols, shift_);
+                else     mono::shiftRowScalar(s, d, in.cols, shift_);
+                break;
+            case Mode::STRETCH:
+                if(simd) mono::stretchRow(s, d, in.cols, sp);
+                else     mono::stretchRowScalar(s, d, in.cols, sp);
+                break;
+            case Mode::GAMMA:
+                mono::lutRow(s, d, in.cols, lut_.data(), maxIndex);
+                break;
+            }
+        }
+    }
+
+    int bits_;
+    Mode mode_ = Mode::SHIFT;
+    int shift_ = 2;
+    int lo_ = 0;
+    int hi_ = 0;
+    std::vector<uint8_t> lut_;
+};
+
+} // namespace igv
+
+#endif // IGV_MONO_CONVERT_HPP
@@ -0,0 +1,444 @@
+/*****************************************************************************************
+ *  File Name   : Morphology.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *  Library     : OpenCV (cv::Mat only)
+ *
+ *  Description :
+ *      Rectangular erode / dilate / open / close for binary masks, the same
+ *      pixels as cv::erode / cv::dilate / cv::morphologyEx with a MORPH_RECT
+ *      kernel (anchor at the centre, pixels outside the image ignored).
+ *
+ *      Byte masks (CV_8UC1), separable:
+ *          vertical   : van Herk / Gil-Werman. Rows are cut into blocks of
+ *                       kh; a running min / max forward (g) and backward
+ *                       (h) inside each block gives any kh-row window as
+ *                       max(h[top], g[bottom]): 3 operations per pixel for
+ *                       any kh, on whole rows (vectorized by the compiler).
+ *          horizontal : the same along the row for kw > 8, direct shifted
+ *                       min / max below (k - 1 vector operations beat the
+ *                       serial block scans there).
+ *
+ *      The image is processed in strips of max(STRIP, 4 kh) rows (plus the
+ *      kernel halo, so that it is at most half of the work) that stay in
+ *      cache: open / close run their second step on the strip
+ *      of the first one, so no full-size intermediate image is written.
+ *      morphology() computes several results in one call and shares the
+ *      steps: open needs the erosion, close the dilation, so asking for all
+ *      four costs 4 filters instead of 6. Strips are split into row bands
+ *      (igv/RowBands.hpp).
+ *
+ *      Bit masks (igv::BitMask): the same operations on 64 pixels per word;
+ *      window OR by doubling (x | x >> 1, then >> 2, ...: log2(k) shifted
+ *      ORs per direction), erosion as the complement of the dilation of the
+ *      complement.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_MORPHOLOGY_HPP
+#define IGV_MORPHOLOGY_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "BitMask.hpp"
+#include "RowBands.hpp"
+
+namespace igv
+{
+
+// Results wanted from one morphology() call (nullptr = not computed)
+template<typename M>
+struct MorphOutputs
+{
+    M* erode = nullptr;
+    M* dilate = nullptr;
+    M* open = nullptr;          // dilate(erode(src))
+    M* close = nullptr;         // erode(dilate(src))
+};
+
+namespace morph
+{
+    const int STRIP = 32;                           // Output rows per strip (at least)
+
+    template<bool MAX> inline uint8_t op(uint8_t a, uint8_t b) { return MAX ? std::max(a, b) : std::min(a, b); }
+    template<bool MAX> inline uint8_t identity() { return MAX ? 0 : 255; }
+
+    // Scratch of one band
+    struct Work
+    {
+        std::vector<uint8_t> padded, g, h;          // One row
+        std::vector<uint8_t> rowsH, rowsG, rowsB;   // Rows of a strip
+        std::vector<uint8_t> first[2];              // Erosion / dilation strip for open / close
+    };
+
+    // ==================== HORIZONTAL ====================
+    // d[x] = op of s[x - a .. x - a + k - 1], outside = identity
+    template<bool MAX>
+    inline void horizontal(const uint8_t* s, uint8_t* d, int width, int k, Work& w)
+    {
+        if(k == 1)
+        {
+            std::memcpy(d, s, width);
+            return;
+        }
+        const int a = k / 2, n = width + k - 1;
+        w.padded.resize(n);
+        uint8_t* p = w.padded.data();
+        std::memset(p, identity<MAX>(), a);
+        std::memcpy(p + a, s, width);
+        std::memset(p + a + width, identity<MAX>(), k - 1 - a);
+
+        if(k <= 8)
+        {
+            std::memcpy(d, p, width);
+            for(int i = 1; i < k; i++)
+            {
+                const uint8_t* __restrict q = p + i;
+                uint8_t* __restrict o = d;
+                for(int x = 0; x < width; x++) o[x] = op<MAX>(o[x], q[x]);
+            }
+            return;
+        }
+
+        // van Herk / Gil-Werman along the row
+        w.g.resize(n);
+        w.h.resize(n);
+        uint8_t* g = w.g.data();
+        uint8_t* h = w.h.data();
+        for(int b0 = 0; b0 < n; b0 += k)
+        {
+            const int b1 = std::min(n, b0 + k);
+            uint8_t acc = p[b0];
+            g[b0] = acc;
+            for(int i = b0 + 1; i < b1; i++) g[i] = acc = op<MAX>(acc, p[i]);
+            acc = p[b1 - 1];
+            h[b1 - 1] = acc;
+            for(int i = b1 - 2; i >= b0; i--) h[i] = acc = op<MAX>(acc, p[i]);
+        }
+        const uint8_t* __restrict hh = h;
+        const uint8_t* __restrict gg = g + k - 1;
+        for(int x = 0; x < width; x++) d[x] = op<MAX>(hh[x], gg[x]);
+    }
+
+    // ==================== ONE FILTER ON A STRIP ====================
+    // Output rows [y0, y1) into out (row i at out + i * width). Input row r
+    // is row(r), valid for lo <= r < hi; outside is identity.
+    template<bool MAX, typename RowFn>
+    inline void filterStrip(RowFn row, int lo, int hi, int width, int kw, int kh,
+                            int y0, int y1, uint8_t* out, Work& w)
+    {
+        const int a = kh / 2, m = (y1 - y0) + kh - 1;      // Input rows of the strip
+        const size_t W = width;
+        w.rowsH.resize(m * W);
+        uint8_t* H = w.rowsH.data();
+        for(int i = 0; i < m; i++)
+        {
+            const int r = y0 - a + i;
+            if(r >= lo && r < hi) horizontal<MAX>(row(r), H + i * W, width, kw, w);
+            else std::memset(H + i * W, identity<MAX>(), W);
+        }
+
+        if(kh == 1)
+        {
+            std::memcpy(out, H, (y1 - y0) * W);
+            return;
+        }
+
+        // van Herk / Gil-Werman down the columns, a whole row at a time
+        w.rowsG.resize(m * W);
+        w.rowsB.resize(m * W);
+        uint8_t* G = w.rowsG.data();
+        uint8_t* B = w.rowsB.data();        // Backward (h) rows
+        for(int i = 0; i < m; i++)
+        {
+            uint8_t* __restrict gi = G + i * W;
+            const uint8_t* __restrict hi_ = H + i * W;
+            if(i % kh == 0) std::memcpy(gi, hi_, W);
+            else
+            {
+                const uint8_t* __restrict prev = G + (i - 1) * W;
+                for(size_t x = 0; x < W; x++) gi[x] = op<MAX>(prev[x], hi_[x]);
+            }
+        }
+        for(int i = m - 1; i >= 0; i--)
+        {
+            uint8_t* __restrict bi = B + i * W;
+            const uint8_t* __restrict hi_ = H + i * W;
+            if(i % kh == kh - 1 || i == m - 1) std::memcpy(bi, hi_, W);
+            else
+            {
+                const uint8_t* __restrict next = B + (i + 1) * W;
+                for(size_t x = 0; x < W; x++) bi[x] = op<MAX>(next[x], hi_[x]);
+            }
+        }
+        for(int i = 0; i < y1 - y0; i++)
+        {
+            const uint8_t* __restrict top = B + i * W;
+            const uint8_t* __restrict bottom = G + (i + kh - 1) * W;
+            uint8_t* __restrict o = out + i * W;
+            for(size_t x = 0; x < W; x++) o[x] = op<MAX>(top[x], bottom[x]);
+        }
+    }
+
+    // Output rows [y0, y1) of every requested result
+    inline void strip(const cv::Mat& src, cv::Size k, const MorphOutputs<cv::Mat>& out, int y0, int y1, Work& w)
+    {
+        const int rows = src.rows, width = src.cols, a = k.height / 2;
+        auto srcRow = [&](int r) { return src.ptr<uint8_t>(r); };
+
+        // Rows of the first step the second one reads: [f0, f1)
+        const int f0 = std::max(0, y0 - a), f1 = std::min(rows, y1 - 1 - a + k.height);
+        for(int pass = 0; pass < 2; pass++)
+        {
+            const bool dilateFirst = pass == 1;
+            cv::Mat* single = dilateFirst ? out.dilate : out.erode;
+            cv::Mat* second = dilateFirst ? out.close : out.open;
+            if(!single && !second) continue;
+
+            if(!second)
+            {
+                // Alone: straight into the output rows
+                if(dilateFirst) filterStrip<true>(srcRow, 0, rows, width, k.width, k.height, y0, y1, single->ptr<uint8_t>(y0), w);
+                else filterStrip<false>(srcRow, 0, rows, width, k.width, k.height, y0, y1, single->ptr<uint8_t>(y0), w);
+                continue;
+            }
+
+            // First step on the strip + halo (cache), then the second from it
+            std::vector<uint8_t>& f = w.first[pass];
+            f.resize((size_t)(f1 - f0) * width);
+            if(dilateFirst) filterStrip<true>(srcRow, 0, rows, width, k.width, k.height, f0, f1, f.data(), w);
+            else filterStrip<false>(srcRow, 0, rows, width, k.width, k.height, f0, f1, f.data(), w);
+            if(single)
+                for(int y = y0; y < y1; y++)
+                    std::memcpy(single->ptr<uint8_t>(y), f.data() + (size_t)(y - f0) * width, width);
+
+            auto firstRow = [&](int r) { return f.data() + (size_t)(r - f0) * width; };
+            if(dilateFirst) filterStrip<false>(firstRow, f0, f1, width, k.width, k.height, y0, y1, second->ptr<uint8_t>(y0), w);
+            else filterStrip<true>(firstRow, f0, f1, width, k.width, k.height, y0, y1, second->ptr<uint8_t>(y0), w);
+        }
+    }
+
+    // ==================== BIT MASKS ====================
+    // d(x) = s(x + m): towards bit 0 (LSB-first words), zeros shifted in
+    inline void shiftDown(const uint64_t* s, uint64_t* d, int words, int m)
+    {
+        const int ws = m >> 6, bs = m & 63;
+        for(int i = 0; i < words; i++)
+        {
+            uint64_t lo = (i + ws < words) ? s[i + ws] : 0;
+            uint64_t hi = (i + ws + 1 < words) ? s[i + ws + 1] : 0;
+            d[i] = bs ? (lo >> bs) | (hi << (64 - bs)) : lo;
+        }
+    }
+
+    // d(x) = s(x - m): away from bit 0
+    inline void shiftUp(const uint64_t* s, uint64_t* d, int words, int m)
+    {
+        const int ws = m >> 6, bs = m & 63;
+        for(int i = words - 1; i >= 0; i--)
+        {
+            uint64_t hi = (i - ws >= 0) ? s[i - ws] : 0;
+            uint64_t lo = (i - ws - 1 >= 0) ? s[i - ws - 1] : 0;
+            d[i] = bs ? (hi << bs) | (lo >> (64 - bs)) : hi;
+        }
+    }
+
+    // Bits past cols cleared (they must stay 0, see BitMask.hpp)
+    inline void clearTail(uint64_t* row, int words, int cols)
+    {
+        if(cols & 63) row[words - 1] &= ~0ULL >> (64 - (cols & 63));
+    }
+
+    // Window OR (outside = 0), kw x kh, in place
+    inline void dilateBits(BitMask& m, cv::Size k)
+    {
+        const int rows = m.rows(), cols = m.cols(), wpr = m.wordsPerRow();
+        const int ax = k.width / 2, ay = k.height / 2;
+        // Row moved ax bits up first (words past the row hold what moves out)
+        const int words = wpr + ax / 64 + 1;
+        std::vector<uint64_t> r(words), t(words);
+
+        // Horizontal: S_2s(x) = S_s(x) | S_s(x + s) on the moved row, so that
+        // S_k(x) covers x - ax .. x - ax + kw - 1 of the original
+        for(int y = 0; y < rows && k.width > 1; y++)
+        {
+            std::fill(t.begin(), t.end(), 0);
+            std::memcpy(t.data(), m.row(y), wpr * sizeof(uint64_t));
+            shiftUp(t.data(), r.data(), words, ax);
+            int span = 1;
+            while(span * 2 <= k.width)
+            {
+                shiftDown(r.data(), t.data(), words, span);
+                for(int i = 0; i < words; i++) r[i] |= t[i];
+                span *= 2;
+            }
+            if(span < k.width)
+            {
+                shiftDown(r.data(), t.data(), words, k.width - span);   // Overlap is harmless for OR
+                for(int i = 0; i < words; i++) r[i] |= t[i];
+            }
+            std::memcpy(m.row(y), r.data(), wpr * sizeof(uint64_t));
+            clearTail(m.row(y), wpr, cols);
+        }
+
+        // Vertical: rows padded with ay empty rows on top, same doubling
+        if(k.height == 1 || rows == 0) return;
+        const int n = rows + k.height - 1;
+        std::vector<uint64_t> p((size_t)n * wpr, 0);
+        for(int y = 0; y < rows; y++) std::memcpy(&p[(size_t)(y + ay) * wpr], m.row(y), wpr * sizeof(uint64_t));
+        auto orRows = [&](int s) {
+            for(int i = 0; i + s < n; i++)                  // Ascending: row i + s not updated yet
+            {
+                uint64_t* __restrict a = &p[(size_t)i * wpr];
+                const uint64_t* __restrict b = &p[(size_t)(i + s) * wpr];
+                for(int j = 0; j < wpr; j++) a[j] |= b[j];
+            }
+        };
+        int span = 1;
+        while(span * 2 <= k.height) { orRows(span); span *= 2; }
+        if(span < k.height) orRows(k.height - span);
+        for(int y = 0; y < rows; y++) std::memcpy(m.row(y), &p[(size_t)y * wpr], wpr * sizeof(uint64_t));
+    }
+
+    inline void complement(BitMask& m)
+    {
+        for(int y = 0; y < m.rows(); y++)
+        {
+            uint64_t* r = m.row(y);
+            for(int i = 0; i < m.wordsPerRow(); i++) r[i] = ~r[i];
+            clearTail(r, m.wordsPerRow(), m.cols());
+        }
+    }
+
+    // erode = ~dilate(~m): outside the image counts as set, as for cv::erode
+    inline void erodeBits(BitMask& m, cv::Size k)
+    {
+        complement(m);
+        dilateBits(m, k);
+        complement(m);
+    }
+} // namespace morph
+
+// ==================== BYTE MASKS ====================
+// Every requested result of src (CV_8UC1) with a ksize MORPH_RECT kernel
+inline void morphology(const cv::Mat& src, cv::Size ksize, const MorphOutputs<cv::Mat>& out, int threads = 1)
+{
+    CV_Assert(src.type() == CV_8UC1 && ksize.width >= 1 && ksize.height >= 1);
+
+    // Outputs must not share memory with the input (strips read src rows
+    // that other strips have already written)
+    cv::Mat in = src;
+    for(cv::Mat* m : { out.erode, out.dilate, out.open, out.close })
+        if(m && m->data == src.data) in = src.clone();
+    for(cv::Mat* m : { out.erode, out.dilate, out.open, out.close })
+        if(m) m->create(src.size(), CV_8UC1);
+    if(src.empty()) return;
+
+    const int rows = std::max(morph::STRIP, 4 * ksize.height);
+    forRowBands((src.rows + rows - 1) / rows, threads, [&](int s0, int s1) {
+        morph::Work w;
+        for(int s = s0; s < s1; s++)
+            morph::strip(in, ksize, out, s * rows, std::min(src.rows, (s + 1) * rows), w);
+    });
+}
+
+inline void erode(const cv::Mat& src, cv::Mat& dst, cv::Size ksize, int threads = 1)
+{
+    MorphOutputs<cv::Mat> out;
+    out.erode = &dst;
+    morphology(src, ksize, out, threads);
+}
+
+inline void dilate(const cv::Mat& src, cv::Mat& dst, cv::Size ksize, int threads = 1)
+{
+    MorphOutputs<cv::Mat> out;
+    out.dilate = &dst;
+    morphology(src, ksize, out, threads);
+}
+
+inline void morphOpen(const cv::Mat& src, cv::Mat& dst, cv::Size ksize, int threads = 1)
+{
+    MorphOutputs<cv::Mat> out;
+    out.open = &dst;
+    morphology(src, ksize, out, threads);
+}
+
+inline void morphClose(const cv::Mat& src, cv::Mat& dst, cv::Size ksize, int threads = 1)
+{
+    MorphOutputs<cv::Mat> out;
+    out.close = &dst;
+    morphology(src, ksize, out, threads);
+}
+
+// ==================== BIT MASKS ====================
+inline void morphology(const BitMask& src, cv::Size ksize, const MorphOutputs<BitMask>& out)
+{
+    CV_Assert(ksize.width >= 1 && ksize.height >= 1);
+    BitMask copy;
+    const BitMask* in = &src;
+    for(BitMask* m : { out.erode, out.dilate, out.open, out.close })
+        if(m == &src) in = &(copy = src);               // An output is the input
+
+    if(out.erode || out.open)
+    {
+        BitMask e = *in;
+        morph::erodeBits(e, ksize);
+        if(out.open)
+        {
+            *out.open = e;
+            morph::dilateBits(*out.open, ksize);
+        }
+        if(out.erode) *out.erode = std::move(e);
+    }
+    if(out.dilate || out.close)
+    {
+        BitMask d = *in;
+        morph::dilateBits(d, ksize);
+        if(out.close)
+        {
+            *out.close = d;
+            morph::erodeBits(*out.close, ksize);
+        }
+        if(out.dilate) *out.dilate = std::move(d);
+    }
+}
+
+inline void erode(const BitMask& src, BitMask& dst, cv::Size ksize)
+{
+    MorphOutputs<BitMask> out;
+    out.erode = &dst;
+    morphology(src, ksize, out);
+}
+
+inline void dilate(const BitMask& src, BitMask& dst, cv::Size ksize)
+{
+    MorphOutputs<BitMask> out;
+    out.dilate = &dst;
+    morphology(src, ksize, out);
+}
+
+inline void morphOpen(const BitMask& src, BitMask& dst, cv::Size ksize)
+{
+    MorphOutputs<BitMask> out;
+    out.open = &dst;
+    morphology(src, ksize, out);
+}
+
+inline void morphClose(const BitMask& src, BitMask& dst, cv::Size ksize)
+{
+    MorphOutputs<BitMask> out;
+    out.close = &dst;
+    morphology(src, ksize, out);
+}
+
+} // namespace igv
+
+#endif // IGV_MORPHOLOGY_HPP
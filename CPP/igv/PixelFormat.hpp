@@ -0,0 +1,226 @@
+/*****************************************************************************************
+ *  File Name   : PixelFormat.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Buffer layouts a FrameSource can deliver, and the two conversions the
+ *      pipelines need from them:
+ *          - lumaView() : grayscale for processing (zero copy for YUV / GRAY)
+ *          - toBgr()    : color, only for frames that are displayed / recorded
+ *
+ *      Memory layout of the YUV 4:2:0 formats (one CV_8UC1 Mat, h*3/2 rows):
+ *          NV12 : [ Y plane h rows ][ interleaved UV, h/2 rows ]
+ *          I420 : [ Y plane h rows ][ U  h/4 rows ][ V  h/4 rows ]
+ *      The Y plane is exactly the grayscale image, so the gray frame is just
+ *      a header over the first h rows.
+ *
+ *      Raw mono sensor formats (V4L2 Y10 / Y12 / Y16): CV_16UC1, one pixel per
+ *      16-bit word, value in the low 10 / 12 / 16 bits.
+ *      YUYV (4:2:2 packed, USB cameras, vivid): CV_8UC2, Y in channel 0.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x, GStreamer
+*****************************************************************************************/
+
+#ifndef IGV_PIXEL_FORMAT_HPP
+#define IGV_PIXEL_FORMAT_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include "MonoConvert.hpp"
+
+namespace igv
+{
+
+enum class PixelFormat
+{
+    BGR,        // CV_8UC3, h x w (classic OpenCV frame)
+    GRAY,       // CV_8UC1, h x w
+    NV12,       // CV_8UC1, h*3/2 x w
+    I420,       // CV_8UC1, h*3/2 x w
+    Y10,        // CV_16UC1, h x w, 10 significant bits
+    Y12,        // CV_16UC1, h x w, 12 significant bits
+    Y16,        // CV_16UC1, h x w
+    YUYV        // CV_8UC2, h x w
+};
+
+// Significant bits per luma sample
+inline int bitDepth(PixelFormat fmt)
+{
+    switch(fmt)
+    {
+    case PixelFormat::Y10: return 10;
+    case PixelFormat::Y12: return 12;
+    case PixelFormat::Y16: return 16;
+    default:               return 8;
+    }
+}
+
+// Image size -> size / type of the buffer that holds it
+inline cv::Size bufferSize(PixelFormat fmt, cv::Size image)
+{
+    if(fmt == PixelFormat::NV12 || fmt == PixelFormat::I420)
+        return cv::Size(image.width, image.height * 3 / 2);
+    return image;
+}
+
+inline int bufferType(PixelFormat fmt)
+{
+    switch(fmt)
+    {
+    case PixelFormat::BGR:  return CV_8UC3;
+    case PixelFormat::YUYV: return CV_8UC2;
+    case PixelFormat::Y10:
+    case PixelFormat::Y12:
+    case PixelFormat::Y16:  return CV_16UC1;
+    default:                return CV_8UC1;
+    }
+}
+
+// ========== GRAYSCALE FOR PROCESSING ==========
+// YUV / GRAY : returns a header over the Y plane (no copy, no conversion)
+// BGR        : converts into "scratch" and returns it
+// YUYV       : extracts Y into "scratch"
+// Y10/12/16  : scales to 8 bit into "scratch"
+//
+// The returned Mat may share memory with "frame": do not modify it in place
+// (write blur / threshold results into another Mat).
+inline cv::Mat lumaView(const cv::Mat& frame, PixelFormat fmt, cv::Mat& scratch)
+{
+    if(frame.channels() == 3)
+    {
+        cv::cvtColor(frame, scratch, cv::COLOR_BGR2GRAY);
+        return scratch;
+    }
+    if(fmt == PixelFormat::NV12 || fmt == PixelFormat::I420)
+    {
+        return frame.rowRange(0, frame.rows * 2 / 3);
+    }
+    if(fmt == PixelFormat::YUYV)
+    {
+        cv::cvtColor(frame, scratch, cv::COLOR_YUV2GRAY_YUY2);
+        return scratch;
+    }
+    if(frame.depth() == CV_16U)
+    {
+        // Top 8 significant bits, vectorized (MonoConvert.hpp)
+        MonoTo8(bitDepth(fmt)).convert(frame, scratch);
+        return scratch;
+    }
+    return frame;
+}
+
+// ========== COLOR FOR DISPLAY ==========
+// Only call this for frames that are shown or recorded.
+// "bgr" always owns its pixels, so it is safe to draw on even when "frame"
+// is a read-only view of a capture buffer (GstAppSink.hpp).
+inline void toBgr(const cv::Mat& frame, PixelFormat fmt, cv::Mat& bgr)
+{
+    if(frame.channels() == 3)
+    {
+        frame.copyTo(bgr);
+    }
+    else if(fmt == PixelFormat::NV12)
+    {
+        cv::cvtColor(frame, bgr, cv::COLOR_YUV2BGR_NV12);
+    }
+    else if(fmt == PixelFormat::I420)
+    {
+        cv::cvtColor(frame, bgr, cv::COLOR_YUV2BGR_I420);
+    }
+    else if(fmt == PixelFormat::YUYV)
+    {
+        cv::cvtColor(frame, bgr, cv::COLOR_YUV2BGR_YUY2);
+    }
+    else
+    {
+        cv::Mat scratch;
+        cv::cvtColor(lumaView(frame, fmt, scratch), bgr, cv::COLOR_GRAY2BGR);
+    }
+}
+
+// ========== BGR -> NV12 ==========
+// Used by the synthetic source and the benchmarks to produce NV12 data.
+// OpenCV only has BGR -> I420, so convert and interleave the chroma planes.
+inline void bgrToNv12(const cv::Mat& bgr, cv::Mat& nv12)
+{
+    cv::Mat i420;
+    cv::cvtColor(bgr, i420, cv::COLOR_BGR2YUV_I420);
+
+    const int w = bgr.cols;
+    const int h = bgr.rows;
+    nv12.create(h * 3 / 2, w, CV_8UC1);
+    i420.rowRange(0, h).copyTo(nv12.rowRange(0, h));
+
+    const uchar* u = i420.ptr<uchar>(h);
+    const uchar* v = u + (w / 2) * (h / 2);
+    for(int y = 0; y < h / 2; y++)
+    {
+        uchar* uv = nv12.ptr<uchar>(h + y);
+        for(int x = 0; x < w / 2; x++)
+        {
+            uv[2 * x + 0] = u[y * (w / 2) + x];
+            uv[2 * x + 1] = v[y * (w / 2) + x];
+        }
+    }
+}
+
+// ========== BGR -> YUYV ==========
+// OpenCV has no BGR -> YUYV either: take Y from the gray image and U / V
+// from I420 (same chroma for two rows, enough for test data)
+inline void bgrToYuyv(const cv::Mat& bgr, cv::Mat& yuyv)
+{
+    cv::Mat i420;
+    cv::cvtColor(bgr, i420, cv::COLOR_BGR2YUV_I420);
+
+    const int w = bgr.cols;
+    const int h = bgr.rows;
+    yuyv.create(h, w, CV_8UC2);
+    const uchar* u = i420.ptr<uchar>(h);
+    const uchar* v = u + (w / 2) * (h / 2);
+    for(int y = 0; y < h; y++)
+    {
+        const uchar* luma = i420.ptr<uchar>(y);
+        const uchar* ur = u + (y / 2) * (w / 2);
+        const uchar* vr = v + (y / 2) * (w / 2);
+        uchar* out = yuyv.ptr<uchar>(y);
+        for(int x = 0; x < w / 2; x++)
+        {
+            out[4 * x + 0] = luma[2 * x];
+            out[4 * x + 1] = ur[x];
+            out[4 * x + 2] = luma[2 * x + 1];
+            out[4 * x + 3] = vr[x];
+        }
+    }
+}
+
+// Converts a BGR image into "fmt" (returns the input for BGR)
+// Y10 / Y12 / Y16: 8-bit gray moved to the top bits of the sensor range
+inline cv::Mat convertFromBgr(const cv::Mat& bgr, PixelFormat fmt, cv::Mat out = cv::Mat())
+{
+    switch(fmt)
+    {
+    case PixelFormat::NV12: bgrToNv12(bgr, out); return out;
+    case PixelFormat::I420: cv::cvtColor(bgr, out, cv::COLOR_BGR2YUV_I420); return out;
+    case PixelFormat::GRAY: cv::cvtColor(bgr, out, cv::COLOR_BGR2GRAY); return out;
+    case PixelFormat::YUYV: bgrToYuyv(bgr, out); return out;
+    case PixelFormat::Y10:
+    case PixelFormat::Y12:
+    case PixelFormat::Y16:
+    {
+        cv::Mat gray;
+        cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);
+        gray.convertTo(out, CV_16U, 1 << (bitDepth(fmt) - 8));
+        return out;
+    }
+    default: return bgr;
+    }
+}
+
+} // namespace igv
+
+#endif // IGV_PIXEL_FORMAT_HPP
@@ -0,0 +1,58 @@
+/*****************************************************************************************
+ *  File Name   : RowBands.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *
+ *  Description :
+ *      Splits the rows of an image into horizontal bands and runs one band
+ *      per thread (the calling thread takes the last one). For kernels that
+ *      only read around their output rows (box blur, median, morphology),
+ *      so bands need no locking: each one writes its own rows.
+ *
+ *          forRowBands(rows, bands, [&](int y0, int y1) { ... rows [y0, y1) ... });
+ *
+ *      bands <= 1 (or a single row) runs inline, without any thread.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+*****************************************************************************************/
+
+#ifndef IGV_ROW_BANDS_HPP
+#define IGV_ROW_BANDS_HPP
+
+// ============================== HEADER FILES ==============================
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace igv
+{
+
+// CPU cores (Jetson Orin Nano: 6), at least 1
+inline int hardwareThreads()
+{
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+template<typename Fn>
+inline void forRowBands(int rows, int bands, Fn fn)
+{
+    bands = std::max(1, std::min(bands, rows));
+    if(bands == 1)
+    {
+        fn(0, rows);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(bands - 1);
+    for(int b = 0; b < bands - 1; b++)
+        workers.emplace_back(fn, rows * b / bands, rows * (b + 1) / bands);
+    fn(rows * (bands - 1) / bands, rows);
+    for(std::thread& t : workers) t.join();
+}
+
+} // namespace igv
+
+#endif // IGV_ROW_BANDS_HPP
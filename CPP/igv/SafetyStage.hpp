@@ -0,0 +1,558 @@
+/*****************************************************************************************
+ *  File Name   : SafetyStage.hpp
+ *  Project     : IGV Vision System - Safety
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Emergency stop decision on its own thread, ahead of everything else:
+ *
+ *          CaptureRing -> SAFETY THREAD -> verdict (lock-free, LatestChannel)
+ *                               |
+ *                               +--> pinned slot -> HAND-OFF THREAD -> tap (recorder)
+ *                                                        |
+ *                                                        +--> copy -> main loop
+ *                                                             (path decision, imshow, waitKey)
+ *
+ *      The safety thread is the only reader of the capture ring. For every
+ *      frame it blurs the luma into a FrameHistory slot, runs the motion
+ *      test (background model, or frame difference over MOTION_GAPS with
+ *      the early-exit MotionScorer) and publishes the verdict. Only then is
+ *      the frame passed on, without copying its pixels: its ring slot is
+ *      pinned (CaptureRing::pin, the grabber leaves it alone), the motion
+ *      mask is one of two buffers and the block counts a fixed-size
+ *      MotionBlocks. The hand-off thread (normal scheduling) runs the tap,
+ *      copies the frame for the main loop into the mailbox buffers and
+ *      unpins the slot, which goes back to the ring with its buffer. One
+ *      frame is out at a time and both steps are try_locks: a busy
+ *      hand-off thread or a blocked main loop loses frames, it never delays
+ *      a verdict, and no copy or I/O of the slower consumers runs on the
+ *      safety thread.
+ *
+ *      Time limits:
+ *          deadline : capture -> verdict (ring timestamp of the frame; ring
+ *                     read instead for recorded timestamps, see
+ *                     SafetyParams::deadlineFromCapture). A verdict that
+ *                     comes later is published as STOP (DEADLINE): the
+ *                     frame is too old to call the path clear.
+ *          watchdog : a second thread checks that verdicts keep coming.
+ *                     Nothing for longer than the budget (capture stall,
+ *                     safety thread starved) -> STOP (WATCHDOG). verdict()
+ *                     applies the same age test, so the reader gets STOP
+ *                     even if the watchdog thread itself is late.
+ *
+ *      Until the motion test is ready (first frame, background warm-up)
+ *      the verdict is STOP (WARMUP).
+ *
+ *      Optional real-time scheduling (Linux): SCHED_FIFO priority for the
+ *      safety and watchdog threads, and the safety thread pinned to a core.
+ *      Needs root or CAP_SYS_NICE; without it a warning is printed and the
+ *      threads run with normal scheduling.
+ *
+ *      Test hooks: setStallHook() runs on the safety thread before each
+ *      decision (inject slow frames), setTap() on the hand-off thread for
+ *      every frame passed on (record frames, collect latencies).
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_SAFETY_STAGE_HPP
+#define IGV_SAFETY_STAGE_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+#include "PixelFormat.hpp"
+#include "CaptureRing.hpp"
+#include "FixedKernels.hpp"
+#include "FrameHistory.hpp"
+#include "BackgroundModel.hpp"
+#include "MotionScore.hpp"
+
+namespace igv
+{
+
+inline int64_t steadyNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ==================== LOCK-FREE CHANNEL ====================
+// Newest value from one writer thread to one reader thread (triple buffer).
+// Neither side ever waits: the writer fills its own slot and swaps it into
+// the middle, the reader swaps the middle out when it holds a newer value.
+template<typename T>
+class LatestChannel
+{
+    static_assert(std::is_trivially_copyable<T>::value, "LatestChannel holds plain values");
+
+public:
+    // Writer thread only
+    void publish(const T& value)
+    {
+        slots_[back_] = value;
+        back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Reader thread only. Returns false when nothing new was published since
+    // the last read (value is then the previous one again).
+    bool read(T& value)
+    {
+        bool fresh = (middle_.load(std::memory_order_relaxed) & FRESH) != 0;
+        if(fresh) front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        value = slots_[front_];
+        return fresh;
+    }
+
+private:
+    static constexpr uint8_t INDEX = 3, FRESH = 4;
+    T slots_[3] = {};
+    std::atomic<uint8_t> middle_{1};
+    uint8_t back_ = 0;      // Writer's slot
+    uint8_t front_ = 2;     // Reader's slot
+};
+
+// ==================== VERDICT ====================
+enum class VerdictReason { CLEAR, MOTION, WARMUP, DEADLINE, WATCHDOG };
+
+inline const char* verdictReasonName(VerdictReason r)
+{
+    switch(r)
+    {
+        case VerdictReason::CLEAR:    return "clear";
+        case VerdictReason::MOTION:   return "motion";
+        case VerdictReason::WARMUP:   return "warm-up";
+        case VerdictReason::DEADLINE: return "deadline";
+        case VerdictReason::WATCHDOG: return "watchdog";
+    }
+    return "?";
+}
+
+struct SafetyVerdict
+{
+    bool stop = true;                               // Nothing decided yet: STOP
+    VerdictReason reason = VerdictReason::WATCHDOG;
+    uint64_t frame = 0;                             // Frames decided so far (1 = first)
+    int motionPixels = 0;
+    int64_t captureNs = 0;                          // Frame captured (ring timestamp)
+    int64_t readNs = 0;                             // Frame taken from the ring (steady clock)
+    int64_t decidedNs = 0;                          // Verdict published (steady clock)
+};
+
+struct SafetyParams
+{
+    BackgroundParams motion;                        // Model; FRAME_DIFF: frame difference over gaps
+    std::vector<int> gaps = { 1, 2, 4 };            // FRAME_DIFF: frames back to compare with
+    int diffThreshold = 25;                         // FRAME_DIFF: |gray - earlier| > this
+    int stopPixels = 5000;                          // STOP above this many motion pixels
+    double deadlineMs = 12.0;                       // Capture -> verdict, later = STOP
+    bool deadlineFromCapture = true;                // false: from the ring read (FrameSource::recordedTimestamps)
+    double watchdogMs = 50.0;                       // No verdict for this long = STOP
+    int realtimePriority = 0;                       // SCHED_FIFO 1..99, 0: normal scheduling
+    int cpu = -1;                                   // Core for the safety thread, -1: any
+};
+
+class SafetyStage
+{
+public:
+    struct Stats
+    {
+        uint64_t frames = 0;            // Frames decided
+        uint64_t stops = 0;             // STOP verdicts (any reason)
+        uint64_t deadlineMisses = 0;    // Verdicts later than the deadline
+        uint64_t watchdogTrips = 0;     // Silences longer than the watchdog budget
+        uint64_t handedOff = 0;         // Frames given to the main loop
+        uint64_t skipped = 0;           // Frames the main loop was too busy for
+        uint64_t notPassedOn = 0;       // Frames the hand-off thread was busy for (no tap)
+        int64_t maxTripDelayNs = 0;     // Worst watchdog reaction past the budget
+    };
+
+    using StallHook = std::function<void(uint64_t frame)>;
+    using Tap = std::function<void(const cv::Mat& frame, int64_t stampNs, const SafetyVerdict& verdict)>;
+
+    // The ring must outlive the stage; the stage is its only reader
+    SafetyStage(CaptureRing& ring, PixelFormat format, const SafetyParams& params = SafetyParams())
+        : ring_(ring), format_(format), params_(params),
+          history_(std::max(1, params.gaps.empty() ? 1 : *std::max_element(params.gaps.begin(), params.gaps.end()))),
+          background_(params.motion)
+    {
+    }
+
+    ~SafetyStage()
+    {
+        stop();
+    }
+
+    SafetyStage(const SafetyStage&) = delete;
+    SafetyStage& operator=(const SafetyStage&) = delete;
+
+    // Set before start()
+    void setStallHook(StallHook hook) { stallHook_ = std::move(hook); }
+    void setTap(Tap tap) { tap_ = std::move(tap); }
+
+    // ==================== THREAD CONTROL ====================
+    void start()
+    {
+        if(running_) return;
+        running_ = true;
+        ended_ = false;
+        handedAll_ = false;
+        handoffBusy_ = false;
+        handoffClosed_ = false;
+        lastVerdictNs_ = steadyNowNs();     // Watchdog budget starts now
+        worker_ = std::thread(&SafetyStage::safetyLoop, this);
+        handoff_ = std::thread(&SafetyStage::handoffLoop, this);
+        watchdog_ = std::thread(&SafetyStage::watchdogLoop, this);
+        configureThread(worker_, params_.realtimePriority, params_.cpu, "safety");
+        configureThread(watchdog_, params_.realtimePriority, -1, "watchdog");
+    }
+
+    // Stops the threads (and the capture ring, which the safety thread reads)
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<std::mutex> watchLock(watchMutex_);
+            running_ = false;
+        }
+        cond_.notify_all();
+        watchCond_.notify_all();
+        ring_.stop();
+        if(worker_.joinable()) worker_.join();       // Closes the hand-off
+        if(handoff_.joinable()) handoff_.join();
+        if(watchdog_.joinable()) watchdog_.join();
+    }
+
+    // ==================== MAIN LOOP SIDE ====================
+    // Newest verdict, STOP (WATCHDOG) when it is older than the watchdog
+    // budget. One reader thread only (the channel is single-reader).
+    SafetyVerdict verdict()
+    {
+        channel_.read(latest_);
+        SafetyVerdict v = latest_;
+        const int64_t now = steadyNowNs();
+        if(v.decidedNs == 0 || now - v.decidedNs > watchdogNs() || tripped_.load(std::memory_order_acquire))
+        {
+            v.stop = true;
+            v.reason = VerdictReason::WATCHDOG;
+        }
+        return v;
+    }
+
+    // Blocks until the hand-off thread hands over a frame (already decided).
+    // "frame" (and "motionView", 0..255 CV_8UC1 of the luma size, display
+    // only) stay valid until the next call. Returns false once the stream
+    // has ended.
+    bool waitFrame(cv::Mat& frame, cv::Mat& motionView, int64_t* stampNs = nullptr)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return boxFull_ || handedAll_ || !running_; });
+        if(!boxFull_) return false;
+        std::swap(boxFrame_, mainFrame_);
+        std::swap(boxView_, mainView_);
+        boxFull_ = false;
+        if(stampNs) *stampNs = boxStamp_;
+        frame = mainFrame_;
+        motionView = mainView_;
+        return true;
+    }
+
+    Stats stats() const
+    {
+        Stats s;
+        s.frames = frames_.load();
+        s.stops = stops_.load();
+        s.deadlineMisses = deadlineMisses_.load();
+        s.watchdogTrips = watchdogTrips_.load();
+        s.handedOff = handedOff_.load();
+        s.skipped = skipped_.load();
+        s.notPassedOn = notPassedOn_.load();
+        s.maxTripDelayNs = maxTripDelayNs_.load();
+        return s;
+    }
+
+    const SafetyParams& params() const { return params_; }
+
+private:
+    // Decided frame on its way to the hand-off thread (no pixels copied)
+    struct Handoff
+    {
+        int slot = -1;                          // Pinned ring slot
+        cv::Mat frame;                          // Header over it
+        cv::Mat mask;                           // Background model: foreground mask
+        MotionBlocks blocks;                    // Frame difference: block counts
+        cv::Size luma;                          // Motion mask size
+        SafetyVerdict verdict;
+    };
+
+    int64_t watchdogNs() const { return (int64_t)(params_.watchdogMs * 1e6); }
+
+    // ==================== SAFETY THREAD ====================
+    void safetyLoop()
+    {
+        cv::Mat frame, lumaScratch, gray, mask;
+        cv::Mat masks[2];                       // One may be out with the hand-off thread
+        int maskIdx = 0;
+        MotionScorer scorer;
+        while(running_)
+        {
+            if(!ring_.read(frame)) break;
+            const int64_t readNs = steadyNowNs();
+            const int64_t stampNs = ring_.timestampNs();
+            const int64_t startNs = (params_.deadlineFromCapture && stampNs > 0) ? stampNs : readNs;
+            const uint64_t index = frames_.load(std::memory_order_relaxed) + 1;
+            if(stallHook_) stallHook_(index);
+
+            // Blurred luma straight into the history slot (no copy)
+            cv::Mat luma = lumaView(frame, format_, lumaScratch);
+            gaussianBlur(luma, history_.next(luma.size(), CV_8UC1), cv::Size(5, 5));
+            history_.push();
+            gray = history_[0];
+
+            SafetyVerdict v;
+            v.frame = index;
+            v.captureNs = stampNs;
+            v.readNs = readNs;
+            bool ready;
+            mask.release();
+            if(params_.motion.model != MotionModel::FRAME_DIFF)
+            {
+                // Into the buffer the hand-off thread is not reading
+                masks[maskIdx].create(gray.size(), CV_8UC1);
+                mask = masks[maskIdx];
+                v.motionPixels = background_.apply(gray, mask);
+                ready = background_.ready();
+            }
+            else
+            {
+                ready = history_.has(1);
+                for(int gap : params_.gaps)
+                {
+                    if(!history_.has(gap)) continue;
+                    MotionScore s = scorer.score(gray, history_[gap], params_.diffThreshold, params_.stopPixels);
+                    v.motionPixels = std::max(v.motionPixels, s.pixels);
+                    if(s.stop) break;
+                }
+            }
+            v.stop = !ready || v.motionPixels > params_.stopPixels;
+            v.reason = !ready ? VerdictReason::WARMUP : (v.stop ? VerdictReason::MOTION : VerdictReason::CLEAR);
+
+            v.decidedNs = steadyNowNs();
+            if(v.decidedNs - startNs > (int64_t)(params_.deadlineMs * 1e6))
+            {
+                deadlineMisses_++;
+                if(!v.stop)
+                {
+                    v.stop = true;
+                    v.reason = VerdictReason::DEADLINE;
+                }
+            }
+            channel_.publish(v);
+            lastVerdictNs_.store(v.decidedNs, std::memory_order_release);
+            frames_++;
+            if(v.stop) stops_++;
+
+            // Verdict is out: now the slower consumers, on their own thread
+            if(passOn(frame, mask, scorer, gray.size(), v)) maskIdx ^= 1;
+        }
+
+        ended_ = true;
+        {
+            std::lock_guard<std::mutex> lock(handoffMutex_);
+            handoffClosed_ = true;
+        }
+        handoffCond_.notify_all();
+    }
+
+    // Gives the decided frame to the hand-off thread: pins its ring slot,
+    // no pixel copy. Hand-off thread still busy: not passed on.
+    bool passOn(const cv::Mat& frame, const cv::Mat& mask, const MotionScorer& scorer,
+                cv::Size luma, const SafetyVerdict& v)
+    {
+        std::unique_lock<std::mutex> lock(handoffMutex_, std::try_to_lock);
+        if(!lock.owns_lock() || handoffBusy_)
+        {
+            notPassedOn_++;
+            return false;
+        }
+        Handoff& h = handoffItem_;
+        h.slot = ring_.pin();
+        h.frame = frame;
+        h.mask = mask;
+        if(params_.motion.model == MotionModel::FRAME_DIFF) scorer.snapshot(h.blocks);
+        h.luma = luma;
+        h.verdict = v;
+        handoffBusy_ = true;
+        lock.unlock();
+        handoffCond_.notify_one();
+        return true;
+    }
+
+    // ==================== HAND-OFF THREAD ====================
+    void handoffLoop()
+    {
+        while(true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(handoffMutex_);
+                handoffCond_.wait(lock, [this] { return handoffBusy_ || handoffClosed_; });
+                if(!handoffBusy_) break;                // Closed, nothing left
+            }
+
+            // The safety thread leaves handoffItem_ alone while it is busy
+            Handoff& item = handoffItem_;
+            if(tap_) tap_(item.frame, item.verdict.captureNs, item.verdict);
+            offer(item);
+
+            // Headers dropped, then the slot goes back to the ring unshared
+            item.frame.release();
+            item.mask.release();
+            ring_.unpin(item.slot);
+            item.slot = -1;
+
+            std::lock_guard<std::mutex> lock(handoffMutex_);
+            handoffBusy_ = false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            handedAll_ = true;
+        }
+        cond_.notify_all();
+    }
+
+    // Copy for the main loop, only if it is not holding the mailbox
+    void offer(const Handoff& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if(!lock.owns_lock())
+        {
+            skipped_++;
+            return;
+        }
+        if(boxFull_) skipped_++;                    // Previous frame never taken
+        item.frame.copyTo(boxFrame_);
+        if(params_.motion.model != MotionModel::FRAME_DIFF) item.mask.copyTo(boxView_);
+        else item.blocks.toMat(boxView_);
+        if(boxView_.empty())                        // No block grid yet (first frame): no motion
+            boxView_ = cv::Mat::zeros(item.luma, CV_8UC1);
+        boxStamp_ = item.verdict.captureNs;
+        boxFull_ = true;
+        handedOff_++;
+        lock.unlock();
+        cond_.notify_all();
+    }
+
+    // ==================== WATCHDOG THREAD ====================
+    void watchdogLoop()
+    {
+        const int64_t budget = watchdogNs();
+        const auto period = std::chrono::nanoseconds(std::max<int64_t>(budget / 4, 1000000));
+        std::unique_lock<std::mutex> lock(watchMutex_);
+        while(running_)
+        {
+            watchCond_.wait_for(lock, period, [this] { return !running_; });
+            if(!running_ || ended_) break;
+
+            const int64_t silence = steadyNowNs() - lastVerdictNs_.load(std::memory_order_acquire);
+            const bool late = silence > budget;
+            if(late && !tripped_.load(std::memory_order_relaxed))
+            {
+                watchdogTrips_++;
+                const int64_t delay = silence - budget;
+                if(delay > maxTripDelayNs_.load()) maxTripDelayNs_.store(delay);
+            }
+            tripped_.store(late, std::memory_order_release);
+        }
+    }
+
+    // ==================== SCHEDULING ====================
+    static void configureThread(std::thread& t, int priority, int cpu, const char* name)
+    {
+#if defined(__linux__)
+        if(priority > 0)
+        {
+            sched_param sp{};
+            sp.sched_priority = std::min(priority, sched_get_priority_max(SCHED_FIFO));
+            if(pthread_setschedparam(t.native_handle(), SCHED_FIFO, &sp) != 0)
+                std::cerr << "IGV::WARNING::No SCHED_FIFO for the " << name
+                          << " thread (needs root / CAP_SYS_NICE), normal scheduling" << std::endl;
+        }
+        if(cpu >= 0)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            if(pthread_setaffinity_np(t.native_handle(), sizeof(set), &set) != 0)
+                std::cerr << "IGV::WARNING::Cannot pin the " << name << " thread to core " << cpu << std::endl;
+        }
+#else
+        (void)t;
+        if(priority > 0 || cpu >= 0)
+            std::cerr << "IGV::WARNING::Thread priority / pinning only on Linux (" << name << ")" << std::endl;
+#endif
+    }
+
+    CaptureRing& ring_;
+    PixelFormat format_;
+    SafetyParams params_;
+    FrameHistory history_;
+    BackgroundModel background_;
+    StallHook stallHook_;
+    Tap tap_;
+
+    LatestChannel<SafetyVerdict> channel_;
+    SafetyVerdict latest_;                      // Reader side copy
+    std::atomic<int64_t> lastVerdictNs_{0};
+    std::atomic<bool> tripped_{false};
+
+    std::atomic<uint64_t> frames_{0}, stops_{0}, deadlineMisses_{0}, watchdogTrips_{0};
+    std::atomic<uint64_t> handedOff_{0}, skipped_{0}, notPassedOn_{0};
+    std::atomic<int64_t> maxTripDelayNs_{0};
+
+    // Mailbox to the main loop (mutex_ guards the box* members)
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    cv::Mat boxFrame_, boxView_, mainFrame_, mainView_;
+    int64_t boxStamp_ = 0;
+    bool boxFull_ = false;
+    bool handedAll_ = false;                    // Hand-off thread done, nothing more comes
+    std::atomic<bool> running_{false};
+    std::atomic<bool> ended_{false};            // Safety thread done (stream ended)
+
+    // Hand-off (handoffMutex_ guards the flags; handoffItem_ belongs to the
+    // hand-off thread while handoffBusy_)
+    std::mutex handoffMutex_;
+    std::condition_variable handoffCond_;
+    Handoff handoffItem_;
+    bool handoffBusy_ = false;
+    bool handoffClosed_ = false;
+
+    // Watchdog sleep (separate lock: it never touches the mailbox)
+    std::mutex watchMutex_;
+    std::condition_variable watchCond_;
+
+    std::thread worker_, handoff_, watchdog_;
+};
+
+} // namespace igv
+
+#endif // IGV_SAFETY_STAGE_HPP
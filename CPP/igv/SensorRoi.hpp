@@ -0,0 +1,76 @@
+/*****************************************************************************************
+ *  File Name   : SensorRoi.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV
+ *
+ *  Description :
+ *      Path ROI (bottom 70 % of the image) for frames that may already be
+ *      cropped by the sensor.
+ *
+ *      The ROI is defined on the FULL sensor image. With a sensor-side crop
+ *      (v4l2mmap:...,crop=bottom70) the frame is that ROI and the software
+ *      crop becomes the whole frame; without it the programs crop as before.
+ *      Either way the same part of the scene is processed, and toSensor()
+ *      gives coordinates in the full sensor image, so outputs do not depend
+ *      on where the crop happened.
+ *
+ *          frame pixel (x, y)  ->  sensor pixel (x, y) + origin
+ *          ROI pixel (x, y)    ->  sensor pixel (x, y) + inFrame.tl() + origin
+ *
+ *      Frames are assumed unscaled (1 frame pixel = 1 sensor pixel).
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x
+*****************************************************************************************/
+
+#ifndef IGV_SENSOR_ROI_HPP
+#define IGV_SENSOR_ROI_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include "FrameSource.hpp"
+
+namespace igv
+{
+
+struct SensorRoi
+{
+    cv::Rect inFrame;       // ROI in frame pixels (what the kernels index)
+    cv::Point origin;       // Sensor position of frame pixel (0, 0): the crop offset
+
+    // ROI-relative point / rectangle to full sensor coordinates
+    cv::Point toSensor(cv::Point p) const { return p + inFrame.tl() + origin; }
+    cv::Rect toSensor(cv::Rect r) const { return r + inFrame.tl() + origin; }
+
+    // The ROI itself in sensor coordinates
+    cv::Rect sensorRect() const { return inFrame + origin; }
+};
+
+// Rows below "topFraction" of the sensor height, as seen in a "frame" sized
+// image that covers "crop" of a "sensor" sized pixel array
+inline SensorRoi pathRoi(cv::Size sensor, cv::Rect crop, cv::Size frame, double topFraction = 0.3)
+{
+    int top = (int)(sensor.height * topFraction);
+    cv::Rect wanted(0, top, sensor.width, sensor.height - top);
+
+    SensorRoi roi;
+    roi.origin = crop.tl();
+    roi.inFrame = ((wanted & crop) - crop.tl()) & cv::Rect(cv::Point(0, 0), frame);
+    return roi;
+}
+
+// Frames that do not match the crop the source reports (uncropped sources,
+// sources that do not know their size) are taken as the full sensor image
+inline SensorRoi pathRoi(const FrameSource& source, cv::Size frame, double topFraction = 0.3)
+{
+    cv::Rect crop = source.sensorCrop();
+    if(crop.size() != frame) return pathRoi(frame, cv::Rect(cv::Point(0, 0), frame), frame, topFraction);
+    return pathRoi(source.sensorSize(), crop, frame, topFraction);
+}
+
+} // namespace igv
+
+#endif // IGV_SENSOR_ROI_HPP
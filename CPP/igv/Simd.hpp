@@ -0,0 +1,60 @@
+/*****************************************************************************************
+ *  File Name   : Simd.hpp
+ *  Project     : IGV Vision System - Kernels
+ *  Language    : C++
+ *
+ *  Description :
+ *      Selects the instruction set the hand-written kernels are compiled for.
+ *
+ *          IGV_SIMD_AVX2  x86 with -mavx2 (or -march=native on an AVX2 CPU)
+ *          IGV_SIMD_SSE2  any x86-64
+ *          IGV_SIMD_NEON  ARM (Jetson: always available on aarch64)
+ *          (none)         plain C++ fallback
+ *
+ *      Every kernel keeps a scalar version that gives the SAME result; it
+ *      handles the row tails and is the reference the benchmarks check the
+ *      vector code against.
+ *
+ *      build.sh compiles with -march=native, so the best set for the machine
+ *      that builds the program is used.
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+*****************************************************************************************/
+
+#ifndef IGV_SIMD_HPP
+#define IGV_SIMD_HPP
+
+#if defined(__AVX2__)
+    #define IGV_SIMD_AVX2 1
+    #define IGV_SIMD_SSE2 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #define IGV_SIMD_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define IGV_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace igv
+{
+
+// Name of the instruction set in use (printed by the benchmarks)
+inline const char* simdName()
+{
+#if defined(IGV_SIMD_AVX2)
+    return "AVX2";
+#elif defined(IGV_SIMD_SSE2)
+    return "SSE2";
+#elif defined(IGV_SIMD_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace igv
+
+#endif // IGV_SIMD_HPP
@@ -0,0 +1,510 @@
+/*****************************************************************************************
+ *  File Name   : V4l2Capture.hpp
+ *  Project     : IGV Vision System - Capture
+ *  Language    : C++
+ *  Library     : OpenCV, Linux V4L2 (linux/videodev2.h)
+ *
+ *  Description :
+ *      Native V4L2 streaming capture, without OpenCV / GStreamer in between.
+ *      Made for the Arducam Pivariety sensor (raw Y10 / Y12 / GREY straight
+ *      from the driver), works with any single-planar capture device.
+ *
+ *          VIDIOC_S_FMT     format / size (Y10, Y12, Y16, GREY, NV12, YUYV, BGR3)
+ *          VIDIOC_REQBUFS   N driver buffers (queue depth), memory = MMAP
+ *          mmap()           each buffer mapped once into the process
+ *          VIDIOC_EXPBUF    optional: DMABUF fd per buffer (GPU / encoder import)
+ *          poll() + DQBUF   wait for the next filled buffer
+ *          QBUF             when the application is done with it
+ *
+ *      read() returns the driver buffer itself as a cv::Mat header (no copy).
+ *      The buffer is queued back to the driver when the last Mat referring to
+ *      it is released (BorrowedMat.hpp), so frames may be kept, passed to the
+ *      capture ring or another thread, as long as they are eventually dropped.
+ *
+ *      Queue depth: the driver can only fill buffers the application has
+ *      given back. Held frames + frames waiting in the capture ring must stay
+ *      below the buffer count, otherwise the camera stalls (read() reports it).
+ *
+ *      Sensor-side crop (Options::crop / cropTop): VIDIOC_S_SELECTION on the
+ *      video node, or VIDIOC_SUBDEV_S_SELECTION on the sensor subdevice when
+ *      the bridge does not forward it (Arducam: IPC_SEL_* registers). Only the
+ *      window crosses CSI-2; crop() gives its place in the full sensor image.
+ *
+ *      Raw Bayer formats (RGGB10...) are not handled here: they need the ISP
+ *      (use the csi source / nvarguscamerasrc).
+ *
+ *      Test without a camera (plain Linux kernel):
+ *          sudo modprobe vivid
+ *          ./build.sh Benchmark/V4L2_Capture v4l2mmap:/dev/video0:1280x720,yuyv
+ *
+ *  Author      : Omkar Ankush Kashid
+ *  Created on  : 16-10-2026
+ *  Platform    : NVIDIA JETSON NANO SUPER 8GB
+ *  Framework   : OpenCV 4.x, V4L2
+*****************************************************************************************/
+
+#ifndef IGV_V4L2_CAPTURE_HPP
+#define IGV_V4L2_CAPTURE_HPP
+
+// ============================== HEADER FILES ==============================
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <linux/videodev2.h>
+#include <linux/v4l2-subdev.h>
+#include "BorrowedMat.hpp"
+#include "PixelFormat.hpp"
+
+namespace igv
+{
+
+namespace v4l2
+{
+    // ioctl() that survives signals
+    inline int xioctl(int fd, unsigned long request, void* arg)
+    {
+        int r;
+        do { r = ::ioctl(fd, request, arg); } while(r < 0 && errno == EINTR);
+        return r;
+    }
+
+    inline uint32_t fourccFor(PixelFormat fmt)
+    {
+        switch(fmt)
+        {
+        case PixelFormat::GRAY: return V4L2_PIX_FMT_GREY;
+        case PixelFormat::Y10:  return V4L2_PIX_FMT_Y10;
+        case PixelFormat::Y12:  return V4L2_PIX_FMT_Y12;
+        case PixelFormat::Y16:  return V4L2_PIX_FMT_Y16;
+        case PixelFormat::NV12: return V4L2_PIX_FMT_NV12;
+        case PixelFormat::YUYV: return V4L2_PIX_FMT_YUYV;
+        case PixelFormat::BGR:  return V4L2_PIX_FMT_BGR24;
+        default:                return 0;
+        }
+    }
+
+    // Returns false for fourccs the pipelines cannot use directly
+    inline bool formatFor(uint32_t fourcc, PixelFormat& fmt)
+    {
+        switch(fourcc)
+        {
+        case V4L2_PIX_FMT_GREY:  fmt = PixelFormat::GRAY; return true;
+        case V4L2_PIX_FMT_Y10:   fmt = PixelFormat::Y10;  return true;
+        case V4L2_PIX_FMT_Y12:   fmt = PixelFormat::Y12;  return true;
+        case V4L2_PIX_FMT_Y16:   fmt = PixelFormat::Y16;  return true;
+        case V4L2_PIX_FMT_NV12:  fmt = PixelFormat::NV12; return true;
+        case V4L2_PIX_FMT_YUYV:  fmt = PixelFormat::YUYV; return true;
+        case V4L2_PIX_FMT_BGR24: fmt = PixelFormat::BGR;  return true;
+        default:                 return false;
+        }
+    }
+
+    inline std::string fourccName(uint32_t f)
+    {
+        char s[5] = { (char)(f & 0xFF), (char)((f >> 8) & 0xFF),
+                      (char)((f >> 16) & 0xFF), (char)((f >> 24) & 0xFF), 0 };
+        return s;
+    }
+
+    // Device + mapped buffers. Shared by the capture object and every frame
+    // still out, so the mappings stay valid until the last frame is gone.
+    struct Device
+    {
+        struct Buffer
+        {
+            void* start = MAP_FAILED;
+            size_t length = 0;
+            int dmabuf = -1;
+        };
+
+        int fd = -1;
+        std::atomic<bool> streaming{false};
+        std::vector<Buffer> buffers;
+        std::atomic<int> held{0};       // Buffers owned by the application
+
+        ~Device()
+        {
+            stop();
+            for(Buffer& b : buffers)
+            {
+                if(b.start != MAP_FAILED) ::munmap(b.start, b.length);
+                if(b.dmabuf >= 0) ::close(b.dmabuf);
+            }
+            if(fd >= 0) ::close(fd);
+        }
+
+        // STREAMOFF: the driver lets go of every buffer, the mappings stay
+        void stop()
+        {
+            if(streaming.exchange(false))
+            {
+                v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                xioctl(fd, VIDIOC_STREAMOFF, &type);
+            }
+        }
+
+        bool queue(uint32_t index)
+        {
+            v4l2_buffer buf = {};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = index;
+            return xioctl(fd, VIDIOC_QBUF, &buf) == 0;
+        }
+    };
+}
+
+// ==================== V4L2 STREAMING CAPTURE ====================
+class V4l2Capture
+{
+public:
+    struct Options
+    {
+        std::string device = "/dev/video0";
+        cv::Size size;                          // Empty: keep the driver's size
+        double fps = 0;                         // 0: keep the driver's rate
+        PixelFormat format = PixelFormat::GRAY; // Requested pixel format
+        bool keepFormat = false;                // true: use whatever the driver has set
+        int buffers = 6;                        // Driver queue depth
+        bool exportDmabuf = false;              // VIDIOC_EXPBUF for every buffer
+
+        // Sensor-side crop, in pixels of the full frame (empty: none).
+        // cropTop > 0 instead drops that fraction of the rows at the top.
+        cv::Rect crop;
+        double cropTop = 0;
+        std::string subdevice;                  // e.g. /dev/v4l-subdev0 (sensor)
+    };
+
+    struct Stats
+    {
+        uint64_t dequeued = 0;      // Frames handed to the application
+        uint64_t lost = 0;          // Gaps in the driver sequence numbers
+        uint64_t errors = 0;        // Buffers flagged V4L2_BUF_FLAG_ERROR (requeued)
+    };
+
+    explicit V4l2Capture(const Options& opt)
+    {
+        open(opt);
+    }
+
+    // Stops streaming now. Frames still held keep the mappings alive
+    // (shared_ptr) until they are released.
+    ~V4l2Capture()
+    {
+        if(dev_) dev_->stop();
+    }
+
+    V4l2Capture(const V4l2Capture&) = delete;
+    V4l2Capture& operator=(const V4l2Capture&) = delete;
+
+    bool isOpened() const { return dev_ && dev_->streaming; }
+    cv::Size frameSize() const { return size_; }
+    double fps() const { return fps_; }
+    PixelFormat format() const { return format_; }
+    uint32_t fourcc() const { return fourcc_; }
+    size_t bytesPerLine() const { return bytesPerLine_; }
+    // Full sensor frame, and the part of it the frames contain
+    cv::Size sensorSize() const { return sensorSize_; }
+    cv::Rect crop() const { return crop_; }
+
+    int bufferCount() const { return dev_ ? (int)dev_->buffers.size() : 0; }
+    int heldBuffers() const { return dev_ ? dev_->held.load() : 0; }
+    Stats stats() const { return stats_; }
+
+    // DMABUF fd of buffer "index" (-1 unless exportDmabuf was set)
+    int dmabufFd(int index) const
+    {
+        if(!dev_ || index < 0 || index >= (int)dev_->buffers.size()) return -1;
+        return dev_->buffers[index].dmabuf;
+    }
+
+    // Driver buffer index and timestamp of the last frame (CLOCK_MONOTONIC,
+    // same clock as std::chrono::steady_clock on Linux)
+    int lastIndex() const { return lastIndex_; }
+    int64_t lastTimestampNs() const { return lastTimestampNs_; }
+
+    // Waits for the next filled buffer and returns it as a header over the
+    // driver memory. Returns false on timeout / device error.
+    bool read(cv::Mat& frame, int timeoutMs = 2000)
+    {
+        if(!isOpened()) return false;
+
+        // The previous frame in "frame" goes back to the driver first
+        frame.release();
+
+        while(true)
+        {
+            if(dev_->held.load() >= (int)dev_->buffers.size())
+            {
+                std::cerr << "IGV::ERROR::V4L2: all " << dev_->buffers.size()
+                          << " buffers are held by the application (raise the queue depth)" << std::endl;
+                return false;
+            }
+
+            pollfd pfd = { dev_->fd, POLLIN, 0 };
+            int r = ::poll(&pfd, 1, timeoutMs);
+            if(r < 0 && errno == EINTR) continue;
+            if(r <= 0)
+            {
+                std::cerr << "IGV::ERROR::V4L2: no frame for " << timeoutMs << " ms" << std::endl;
+                return false;
+            }
+
+            v4l2_buffer buf = {};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            if(v4l2::xioctl(dev_->fd, VIDIOC_DQBUF, &buf) < 0)
+            {
+                if(errno == EAGAIN) continue;
+                std::cerr << "IGV::ERROR::V4L2 DQBUF: " << std::strerror(errno) << std::endl;
+                return false;
+            }
+
+            if(buf.flags & V4L2_BUF_FLAG_ERROR)
+            {
+                stats_.errors++;
+                dev_->queue(buf.index);
+                continue;
+            }
+
+            if(stats_.dequeued > 0 && buf.sequence > lastSequence_ + 1)
+            {
+                stats_.lost += buf.sequence - lastSequence_ - 1;
+            }
+            lastSequence_ = buf.sequence;
+            lastIndex_ = (int)buf.index;
+            lastTimestampNs_ = (int64_t)buf.timestamp.tv_sec * 1000000000LL
+                             + (int64_t)buf.timestamp.tv_usec * 1000LL;
+            stats_.dequeued++;
+
+            // Header over the driver buffer; requeued when the last copy is gone
+            std::shared_ptr<v4l2::Device> dev = dev_;
+            const uint32_t index = buf.index;
+            dev->held++;
+            frame = borrowMat(bufferSize(format_, size_), bufferType(format_),
+                              dev->buffers[index].start, bytesPerLine_,
+                              [dev, index]()
+                              {
+                                  dev->held--;
+                                  if(dev->streaming) dev->queue(index);
+                              });
+            return true;
+        }
+    }
+
+private:
+    // ==================== DEVICE SETUP ====================
+    bool fail(const std::string& what)
+    {
+        std::cerr << "IGV::ERROR::V4L2 " << what << ": " << std::strerror(errno) << std::endl;
+        dev_.reset();
+        return false;
+    }
+
+    bool open(const Options& opt)
+    {
+        dev_ = std::make_shared<v4l2::Device>();
+        dev_->fd = ::open(opt.device.c_str(), O_RDWR | O_NONBLOCK);
+        if(dev_->fd < 0) return fail("open " + opt.device);
+
+        v4l2_capability cap = {};
+        if(v4l2::xioctl(dev_->fd, VIDIOC_QUERYCAP, &cap) < 0) return fail("QUERYCAP");
+        uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+        if(!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING))
+        {
+            errno = ENOTSUP;
+            return fail(opt.device + " is not a single-planar streaming capture device");
+        }
+
+        // ----- Format -----
+        v4l2_format fmt = {};
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if(v4l2::xioctl(dev_->fd, VIDIOC_G_FMT, &fmt) < 0) return fail("G_FMT");
+        if(!opt.size.empty())
+        {
+            fmt.fmt.pix.width = opt.size.width;
+            fmt.fmt.pix.height = opt.size.height;
+        }
+        if(!opt.keepFormat) fmt.fmt.pix.pixelformat = v4l2::fourccFor(opt.format);
+        fmt.fmt.pix.field = V4L2_FIELD_NONE;
+        fmt.fmt.pix.bytesperline = 0;       // Let the driver choose the stride
+        if(v4l2::xioctl(dev_->fd, VIDIOC_S_FMT, &fmt) < 0) return fail("S_FMT");
+
+        fourcc_ = fmt.fmt.pix.pixelformat;
+        if(!v4l2::formatFor(fourcc_, format_))
+        {
+            errno = ENOTSUP;
+            return fail("pixel format " + v4l2::fourccName(fourcc_));
+        }
+        if(!opt.keepFormat && fourcc_ != v4l2::fourccFor(opt.format))
+        {
+            std::cerr << "IGV::WARNING::V4L2 driver chose " << v4l2::fourccName(fourcc_)
+                      << " instead of " << v4l2::fourccName(v4l2::fourccFor(opt.format)) << std::endl;
+        }
+        size_ = cv::Size(fmt.fmt.pix.width, fmt.fmt.pix.height);
+        bytesPerLine_ = fmt.fmt.pix.bytesperline;
+        sensorSize_ = size_;
+        crop_ = cv::Rect(cv::Point(0, 0), size_);
+
+        // ----- Sensor crop -----
+        cv::Rect want = opt.crop;
+        if(want.empty() && opt.cropTop > 0)
+        {
+            int top = (int)(size_.height * opt.cropTop);
+            want = cv::Rect(0, top, size_.width, size_.height - top);
+        }
+        if(!want.empty() && want != crop_ && applyCrop(want, opt.subdevice))
+        {
+            // The frames shrink to the window: ask for that size
+            fmt.fmt.pix.width = crop_.width;
+            fmt.fmt.pix.height = crop_.height;
+            fmt.fmt.pix.bytesperline = 0;
+            if(v4l2::xioctl(dev_->fd, VIDIOC_S_FMT, &fmt) < 0) return fail("S_FMT (crop)");
+            size_ = cv::Size(fmt.fmt.pix.width, fmt.fmt.pix.height);
+            bytesPerLine_ = fmt.fmt.pix.bytesperline;
+            if(size_ != crop_.size())
+            {
+                std::cerr << "IGV::WARNING::V4L2 frames are " << size_.width << "x" << size_.height
+                          << ", crop is " << crop_.width << "x" << crop_.height << std::endl;
+                crop_ = cv::Rect(crop_.tl(), size_);
+            }
+        }
+
+        // NV12 in one plane: the UV rows must follow the Y rows directly
+        if(format_ == PixelFormat::NV12 && fmt.fmt.pix.sizeimage < bytesPerLine_ * size_.height * 3 / 2)
+        {
+            errno = ENOTSUP;
+            return fail("NV12 buffer layout");
+        }
+
+        // ----- Frame rate -----
+        v4l2_streamparm parm = {};
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if(opt.fps > 0)
+        {
+            parm.parm.capture.timeperframe.numerator = 1000;
+            parm.parm.capture.timeperframe.denominator = (uint32_t)(opt.fps * 1000);
+            v4l2::xioctl(dev_->fd, VIDIOC_S_PARM, &parm);     // Not every driver supports it
+        }
+        if(v4l2::xioctl(dev_->fd, VIDIOC_G_PARM, &parm) == 0 && parm.parm.capture.timeperframe.numerator > 0)
+        {
+            fps_ = (double)parm.parm.capture.timeperframe.denominator / parm.parm.capture.timeperframe.numerator;
+        }
+
+        // ----- Buffers -----
+        v4l2_requestbuffers req = {};
+        req.count = std::max(opt.buffers, 2);
+        req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory = V4L2_MEMORY_MMAP;
+        if(v4l2::xioctl(dev_->fd, VIDIOC_REQBUFS, &req) < 0) return fail("REQBUFS");
+        if(req.count < 2)
+        {
+            errno = ENOMEM;
+            return fail("REQBUFS (driver gave " + std::to_string(req.count) + " buffers)");
+        }
+
+        dev_->buffers.resize(req.count);
+        for(uint32_t i = 0; i < req.count; i++)
+        {
+            v4l2_buffer buf = {};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = i;
+            if(v4l2::xioctl(dev_->fd, VIDIOC_QUERYBUF, &buf) < 0) return fail("QUERYBUF");
+
+            v4l2::Device::Buffer& b = dev_->buffers[i];
+            b.length = buf.length;
+            b.start = ::mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, dev_->fd, buf.m.offset);
+            if(b.start == MAP_FAILED) return fail("mmap");
+
+            if(opt.exportDmabuf)
+            {
+                v4l2_exportbuffer exp = {};
+                exp.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                exp.index = i;
+                exp.flags = O_RDONLY | O_CLOEXEC;
+                if(v4l2::xioctl(dev_->fd, VIDIOC_EXPBUF, &exp) < 0) return fail("EXPBUF");
+                b.dmabuf = exp.fd;
+            }
+
+            if(!dev_->queue(i)) return fail("QBUF");
+        }
+
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if(v4l2::xioctl(dev_->fd, VIDIOC_STREAMON, &type) < 0) return fail("STREAMON");
+        dev_->streaming = true;
+        return true;
+    }
+
+    // Crop window on the video node, else on the sensor subdevice.
+    // crop_ becomes what the driver applied (it may align / clamp it).
+    bool applyCrop(const cv::Rect& want, const std::string& subdevice)
+    {
+        v4l2_selection sel = {};
+        sel.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        sel.target = V4L2_SEL_TGT_CROP;
+        sel.r = { want.x, want.y, (uint32_t)want.width, (uint32_t)want.height };
+        if(v4l2::xioctl(dev_->fd, VIDIOC_S_SELECTION, &sel) == 0)
+        {
+            crop_ = cv::Rect(sel.r.left, sel.r.top, sel.r.width, sel.r.height);
+            return true;
+        }
+
+        if(subdevice.empty())
+        {
+            std::cerr << "IGV::WARNING::V4L2 crop not supported by the video node ("
+                      << std::strerror(errno) << "), pass subdev=/dev/v4l-subdevN" << std::endl;
+            return false;
+        }
+
+        int fd = ::open(subdevice.c_str(), O_RDWR);
+        if(fd < 0)
+        {
+            std::cerr << "IGV::WARNING::V4L2 open " << subdevice << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        v4l2_subdev_selection ssel = {};
+        ssel.which = V4L2_SUBDEV_FORMAT_ACTIVE;
+        ssel.pad = 0;
+        ssel.target = V4L2_SEL_TGT_CROP;
+        ssel.r = sel.r;
+        int r = v4l2::xioctl(fd, VIDIOC_SUBDEV_S_SELECTION, &ssel);
+        ::close(fd);
+        if(r < 0)
+        {
+            std::cerr << "IGV::WARNING::V4L2 subdev crop: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        crop_ = cv::Rect(ssel.r.left, ssel.r.top, ssel.r.width, ssel.r.height);
+        return true;
+    }
+
+    std::shared_ptr<v4l2::Device> dev_;
+    cv::Size size_;
+    cv::Size sensorSize_;
+    cv::Rect crop_;
+    double fps_ = 0;
+    PixelFormat format_ = PixelFormat::GRAY;
+    uint32_t fourcc_ = 0;
+    size_t bytesPerLine_ = 0;
+
+    int lastIndex_ = -1;
+    int64_t lastTimestampNs_ = 0;
+    uint32_t lastSequence_ = 0;
+    Stats stats_;
+};
+
+} // namespace igv
+
+#endif // IGV_V4L2_CAPTURE_HPP
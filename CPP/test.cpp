@@ -1,5 +1,6 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
+#include "igv/FusedCanny.hpp"
 
 int main()
 {
@@ -18,16 +19,19 @@ int main()
         return -1;
     }
 
-    cv::Mat frame, gray, blurImg, edges;
+    cv::Mat frame, edges;
+
+    // gray -> 5x5 Gaussian -> Canny in one pass, tile by tile (igv/FusedCanny.hpp)
+    igv::FusedCanny canny;
 
     while (true)
     {
         cap >> frame;
         if (frame.empty()) break;
 
-        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
-        cv::GaussianBlur(gray, blurImg, cv::Size(5,5), 0);
-        cv::Canny(blurImg, edges, 50, 150);
+        // Same edges as cvtColor -> GaussianBlur(5x5, 0) -> Canny(50, 150),
+        // without the gray and blurred full frames in between
+        canny.apply(frame, edges, 50, 150, igv::hardwareThreads());
 
         cv::imshow("Original", frame);
         cv::imshow("Edges", edges);